@@ -0,0 +1,126 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#include <lizard/core/Fraction.hpp>
+#include <lizard/process/BinaryExport.hpp>
+#include <lizard/process/BinaryImport.hpp>
+#include <lizard/symbolic/ExpressionOperator.hpp>
+#include <lizard/symbolic/Index.hpp>
+#include <lizard/symbolic/IndexSpace.hpp>
+#include <lizard/symbolic/IndexSpaceData.hpp>
+#include <lizard/symbolic/IndexSpaceManager.hpp>
+#include <lizard/symbolic/IndexType.hpp>
+#include <lizard/symbolic/Tensor.hpp>
+#include <lizard/symbolic/TensorBlock.hpp>
+#include <lizard/symbolic/TensorElement.hpp>
+#include <lizard/symbolic/TensorExpressions.hpp>
+#include <lizard/symbolic/TreeNode.hpp>
+
+#include <libperm/SpecialGroups.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+constexpr const std::int64_t minTerms = 1 << 8;
+constexpr const std::int64_t maxTerms = 1 << 18;
+
+auto createManager() -> lizard::IndexSpaceManager {
+	lizard::IndexSpaceManager manager;
+	manager.registerSpace(lizard::IndexSpace(0, lizard::Spin::Both),
+						  lizard::IndexSpaceData("occ", 'o', 10, lizard::Spin::Both, { 'i', 'j', 'k', 'l' }));
+	manager.registerSpace(lizard::IndexSpace(1, lizard::Spin::Both),
+						  lizard::IndexSpaceData("virt", 'v', 100, lizard::Spin::Both, { 'a', 'b', 'c', 'd' }));
+
+	return manager;
+}
+
+/**
+ * Creates an antisymmetric element of the given tensor, indexed by virtual creators and occupied annihilators
+ */
+auto createElement(const std::string &name, std::uint8_t offset) -> lizard::TensorElement {
+	const lizard::IndexSpace occ(0, lizard::Spin::Both);
+	const lizard::IndexSpace virt(1, lizard::Spin::Both);
+
+	std::vector< lizard::Index > indices = {
+		lizard::Index(offset, virt, lizard::IndexType::Creator),
+		lizard::Index(static_cast< std::uint8_t >(offset + 1), virt, lizard::IndexType::Creator),
+		lizard::Index(offset, occ, lizard::IndexType::Annihilator),
+		lizard::Index(static_cast< std::uint8_t >(offset + 1), occ, lizard::IndexType::Annihilator),
+	};
+
+	return std::get< 0 >(lizard::TensorElement::create(lizard::Tensor(name), std::move(indices),
+													   perm::antisymmetricRanges({ { 0, 1 }, { 2, 3 } })));
+}
+
+/**
+ * Creates a sum of the given amount of terms of the form 1/2 * H * T. Every term adds 6 nodes to the tree.
+ */
+auto createExpressions(std::size_t terms) -> std::vector< lizard::NamedTensorExprTree > {
+	std::vector< lizard::NamedTensorExprTree > expressions;
+	lizard::NamedTensorExprTree &tree = expressions.emplace_back(createElement("R", 0));
+	tree.reserve(6 * terms, 2 * terms);
+
+	for (std::size_t i = 0; i < terms; ++i) {
+		tree.add(lizard::TreeNode(lizard::Fraction(1, 2)));
+		tree.add(createElement("H", static_cast< std::uint8_t >(i % 8)));
+		tree.add(lizard::TreeNode(lizard::ExpressionOperator::Times));
+		tree.add(createElement("T", static_cast< std::uint8_t >(i % 8 + 2)));
+		tree.add(lizard::TreeNode(lizard::ExpressionOperator::Times));
+
+		if (i > 0) {
+			tree.add(lizard::TreeNode(lizard::ExpressionOperator::Plus));
+		}
+	}
+
+	return expressions;
+}
+
+static void BM_binaryWrite(benchmark::State &state) {
+	const lizard::IndexSpaceManager manager                      = createManager();
+	const std::vector< lizard::NamedTensorExprTree > expressions = createExpressions(state.range(0));
+
+	std::size_t bytes = 0;
+	for (auto _ : state) {
+		std::ostringstream stream;
+		lizard::BinaryExport::write(expressions, manager, stream);
+
+		bytes = stream.str().size();
+		benchmark::DoNotOptimize(bytes);
+	}
+
+	state.SetItemsProcessed(expressions[0].size() * state.iterations());
+	state.SetBytesProcessed(bytes * state.iterations());
+}
+
+static void BM_binaryRead(benchmark::State &state) {
+	const lizard::IndexSpaceManager manager = createManager();
+
+	std::ostringstream stream;
+	lizard::BinaryExport::write(createExpressions(state.range(0)), manager, stream);
+	const std::string data = stream.str();
+
+	std::size_t nodes = 0;
+	for (auto _ : state) {
+		std::vector< lizard::NamedTensorExprTree > expressions = lizard::BinaryImport::read(data, manager);
+
+		nodes = expressions[0].size();
+		benchmark::DoNotOptimize(expressions);
+	}
+
+	state.SetItemsProcessed(nodes * state.iterations());
+	state.SetBytesProcessed(data.size() * state.iterations());
+}
+
+BENCHMARK(BM_binaryWrite)->RangeMultiplier(4)->Range(minTerms, maxTerms)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_binaryRead)->RangeMultiplier(4)->Range(minTerms, maxTerms)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,61 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#include <lizard/parser/GeCCoContraction.hpp>
+#include <lizard/parser/GeCCoExportParser.hpp>
+
+#include <array>
+#include <cstddef>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+using Backend = ::lizard::parser::GeCCoExportParser::Backend;
+
+constexpr const std::array< std::string_view, 7 > inputFiles = {
+	"CCSD_EN.EXPORT",       "CCSD_LAG.EXPORT",    "CCSD_RES1.EXPORT",   "CCSD_RES2.EXPORT",
+	"icMRCC_ENERGY.EXPORT", "icMRCC_RES1.EXPORT", "icMRCC_RES2.EXPORT",
+};
+
+auto readInput(std::string_view fileName) -> std::string {
+	std::ifstream stream(std::string(TEST_FILE_DIR "/parser_input/GeCCoExport/valid/") + std::string(fileName));
+
+	return std::string((std::istreambuf_iterator< char >(stream)), std::istreambuf_iterator< char >());
+}
+
+template< Backend backend > static void BM_parseGeCCoExport(benchmark::State &state) {
+	const std::string_view fileName = inputFiles[state.range(0)];
+	const std::string content       = readInput(fileName);
+
+	for (auto _ : state) {
+		const std::vector<::lizard::parser::GeCCoExportParser::Chunk > chunks =
+			::lizard::parser::GeCCoExportParser::splitIntoChunks(content, 32);
+
+		for (const ::lizard::parser::GeCCoExportParser::Chunk &currentChunk : chunks) {
+			::lizard::parser::GeCCoExportParser::parseChunk(
+				currentChunk,
+				[](const ::lizard::parser::GeCCoContraction &contraction) {
+					benchmark::DoNotOptimize(contraction.index);
+				},
+				"", backend);
+		}
+	}
+
+	state.SetLabel(std::string(fileName));
+	state.SetBytesProcessed(content.size() * state.iterations());
+}
+
+BENCHMARK(BM_parseGeCCoExport< Backend::ANTLR >)
+	->DenseRange(0, inputFiles.size() - 1)
+	->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_parseGeCCoExport< Backend::Fast >)
+	->DenseRange(0, inputFiles.size() - 1)
+	->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
@@ -176,6 +176,9 @@ find_package(ANTLR REQUIRED)
 # ANTLR's CMakeLists.txt does not specify the include directories for 
 target_include_directories(antlr4_static PUBLIC "${ANTLR_SOURCE_DIR}/runtime/Cpp/runtime/src")
 
+# Required for the parallel parts of the processing pipeline
+find_package(Threads REQUIRED)
+
 # Add hedley to include path
 FetchContent_GetProperties(hedley SOURCE_DIR HEDLEY_SOURCE_DIR)
 include_directories("${HEDLEY_SOURCE_DIR}")
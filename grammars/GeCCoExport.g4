@@ -11,6 +11,11 @@ body:
 	contraction* '[END]'
 ;
 
+// Entry point for parsing the contraction blocks of a file individually
+contraction_block:
+	contraction NL* EOF
+;
+
 contraction:
 	contr_num NL
 	result NL
@@ -216,4 +216,34 @@ constexpr auto operator/(Fraction lhs, const Fraction &rhs) -> Fraction {
 	return lhs;
 }
 
+constexpr auto operator+=(Fraction &lhs, const Fraction &rhs) -> Fraction & {
+	// Bring both fractions onto their least common denominator in order to keep the intermediate values small
+	const Fraction::field_type denominator = std::lcm(lhs.getDenominator(), rhs.getDenominator());
+
+	lhs = Fraction(lhs.getNumerator() * (denominator / lhs.getDenominator())
+					   + rhs.getNumerator() * (denominator / rhs.getDenominator()),
+				   denominator);
+
+	return lhs;
+}
+
+constexpr auto operator+(Fraction lhs, const Fraction &rhs) -> Fraction {
+	lhs += rhs;
+	return lhs;
+}
+
+constexpr auto operator-(const Fraction &fraction) -> Fraction {
+	return Fraction(-fraction.getNumerator(), fraction.getDenominator());
+}
+
+constexpr auto operator-=(Fraction &lhs, const Fraction &rhs) -> Fraction & {
+	lhs += -rhs;
+	return lhs;
+}
+
+constexpr auto operator-(Fraction lhs, const Fraction &rhs) -> Fraction {
+	lhs -= rhs;
+	return lhs;
+}
+
 } // namespace lizard
@@ -0,0 +1,59 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+
+namespace lizard {
+
+/**
+ * A read-only view of a file's contents that is backed by a memory mapping of the file (rather than by a copy of
+ * its contents on the heap). Pages are only loaded on demand and mappings of the same file that are held by
+ * different objects (or processes) share the same physical memory.
+ */
+class MemoryMappedFile {
+public:
+	MemoryMappedFile() = default;
+	/**
+	 * Maps the file at the given location into memory
+	 *
+	 * @throws lizard::Exception if the file can't be opened or mapped
+	 */
+	explicit MemoryMappedFile(const std::filesystem::path &path);
+	MemoryMappedFile(const MemoryMappedFile &) = delete;
+	MemoryMappedFile(MemoryMappedFile &&other) noexcept;
+	~MemoryMappedFile();
+	auto operator=(const MemoryMappedFile &) -> MemoryMappedFile & = delete;
+	auto operator=(MemoryMappedFile &&other) noexcept -> MemoryMappedFile &;
+
+	/**
+	 * @returns A pointer to the beginning of the mapped file contents
+	 */
+	[[nodiscard]] auto data() const -> const std::byte *;
+
+	/**
+	 * @returns The size of the mapped file in bytes
+	 */
+	[[nodiscard]] auto size() const -> std::size_t;
+
+	/**
+	 * @returns Whether this object currently maps a file
+	 */
+	[[nodiscard]] auto isMapped() const -> bool;
+
+private:
+	const std::byte *m_data = nullptr;
+	std::size_t m_size      = 0;
+#ifdef _WIN32
+	void *m_fileHandle    = nullptr;
+	void *m_mappingHandle = nullptr;
+#endif
+
+	void unmap() noexcept;
+};
+
+} // namespace lizard
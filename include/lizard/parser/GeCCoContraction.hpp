@@ -0,0 +1,125 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace lizard::parser {
+
+/**
+ * The index spaces of the creators and annihilators of a single vertex as listed in a GeCCo index specification
+ * (e.g. "[HH,PP]"). Every character corresponds to one index and denotes the space that index belongs to.
+ */
+struct GeCCoIndexBlock {
+	std::string creators;
+	std::string annihilators;
+
+	void clear() {
+		creators.clear();
+		annihilators.clear();
+	}
+};
+
+/**
+ * A tensor as specified in GeCCo's export format (name, transposition flag and index blocks)
+ */
+struct GeCCoTensor {
+	std::string name;
+	bool transposed = false;
+	std::vector< GeCCoIndexBlock > indices;
+
+	void clear() {
+		name.clear();
+		transposed = false;
+		indices.clear();
+	}
+};
+
+/**
+ * A (potentially external) arc connecting two vertices of a contraction
+ */
+struct GeCCoArc {
+	int from = 0;
+	int to   = 0;
+	std::vector< GeCCoIndexBlock > indices;
+
+	void clear() {
+		from = 0;
+		to   = 0;
+		indices.clear();
+	}
+};
+
+/**
+ * The explicit listing of all indices involved in a contraction (or its result). Every vector holds one entry per
+ * index.
+ */
+struct GeCCoIndexString {
+	std::vector< int > vertices;
+	std::vector< int > types;
+	std::vector< int > spaces;
+	/**
+	 * Whether the respective index is part of the result. This is only provided for contraction strings.
+	 */
+	std::vector< bool > resultFlags;
+	std::vector< int > arcs;
+	std::vector< int > ids;
+
+	void clear() {
+		vertices.clear();
+		types.clear();
+		spaces.clear();
+		resultFlags.clear();
+		arcs.clear();
+		ids.clear();
+	}
+};
+
+/**
+ * A single contraction (a "[CONTR]" block) as read from a GeCCo export file
+ *
+ * All types in here provide a clear() function that resets them to their default state while keeping the memory they
+ * have allocated, such that a single object can be refilled for every contraction of a file.
+ */
+struct GeCCoContraction {
+	std::size_t index = 0;
+	GeCCoTensor result;
+	double externalFactor     = 1;
+	int sign                  = 1;
+	double contractionFactor  = 1;
+	std::size_t vertexCount   = 0;
+	std::size_t operatorCount = 0;
+	std::vector< int > superVertex;
+	std::size_t arcCount         = 0;
+	std::size_t externalArcCount = 0;
+	std::vector< GeCCoTensor > vertices;
+	std::vector< GeCCoArc > arcs;
+	std::vector< GeCCoArc > externalArcs;
+	GeCCoIndexString contractionString;
+	GeCCoIndexString resultString;
+
+	void clear() {
+		index = 0;
+		result.clear();
+		externalFactor    = 1;
+		sign              = 1;
+		contractionFactor = 1;
+		vertexCount       = 0;
+		operatorCount     = 0;
+		superVertex.clear();
+		arcCount         = 0;
+		externalArcCount = 0;
+		vertices.clear();
+		arcs.clear();
+		externalArcs.clear();
+		contractionString.clear();
+		resultString.clear();
+	}
+};
+
+} // namespace lizard::parser
@@ -5,16 +5,98 @@
 
 #pragma once
 
+#include "lizard/parser/GeCCoContraction.hpp"
+
+#include <cstddef>
 #include <filesystem>
+#include <functional>
 #include <iosfwd>
 #include <string_view>
+#include <vector>
 
 namespace lizard::parser {
 
+/**
+ * Parser for the export files produced by GeCCo. The input is processed one contraction block at a time, such that
+ * the memory consumption doesn't depend on the size of the parsed file.
+ */
 class GeCCoExportParser {
 public:
+	/**
+	 * The implementation used for parsing the individual contraction blocks
+	 */
+	enum class Backend {
+		/**
+		 * Parser generated by ANTLR from the GeCCoExport grammar
+		 */
+		ANTLR,
+		/**
+		 * Hand-written lexer and parser for the same grammar, which avoids the overhead of the ANTLR runtime
+		 */
+		Fast,
+	};
+
+	/**
+	 * Callback that is invoked for every contraction as soon as it has been parsed. The parser reuses the passed object
+	 * for the next contraction, so callbacks have to copy whatever they want to keep beyond their invocation.
+	 */
+	using ContractionCallback = std::function< void(const GeCCoContraction &contraction) >;
+
+	/**
+	 * A sequence of consecutive contraction blocks within the contents of an export file
+	 */
+	struct Chunk {
+		std::string_view content;
+		/**
+		 * The (1-based) number of the line in the original input at which this chunk starts
+		 */
+		std::size_t firstLine = 1;
+	};
+
+	explicit GeCCoExportParser(Backend backend = Backend::ANTLR);
+
+	/**
+	 * Parses the given file without doing anything with the parsed contractions (i.e. only checks its validity)
+	 *
+	 * @throws ParseException if the file doesn't adhere to the expected format
+	 */
 	void parse(const std::filesystem::path &filePath);
 	void parse(std::istream &inputStream, std::string_view fileName = "");
+
+	/**
+	 * Parses the given file and passes every contained contraction to the given callback (in order of appearance)
+	 *
+	 * @throws ParseException if the file doesn't adhere to the expected format
+	 */
+	void parse(const std::filesystem::path &filePath, const ContractionCallback &callback);
+	void parse(std::istream &inputStream, const ContractionCallback &callback, std::string_view fileName = "");
+
+	/**
+	 * Splits the given file contents at contraction boundaries into chunks of (at most) the given amount of
+	 * contractions. As the contractions in an export file are independent of each other, the obtained chunks can be
+	 * parsed independently (and concurrently) via parseChunk. Note that the chunks refer to the given content.
+	 *
+	 * @throws ParseException if the content isn't a sequence of contraction blocks terminated by "[END]"
+	 */
+	[[nodiscard]] static auto splitIntoChunks(std::string_view content, std::size_t contractionsPerChunk,
+											  std::string_view fileName = "") -> std::vector< Chunk >;
+
+	/**
+	 * Parses the given chunk (as obtained from splitIntoChunks) and passes every contained contraction to the given
+	 * callback (in order of appearance)
+	 *
+	 * @throws ParseException if the chunk doesn't adhere to the expected format
+	 */
+	static void parseChunk(const Chunk &chunk, const ContractionCallback &callback, std::string_view fileName = "",
+						   Backend backend = Backend::ANTLR);
+
+	/**
+	 * @returns The backend used by this parser
+	 */
+	[[nodiscard]] auto getBackend() const -> Backend;
+
+private:
+	Backend m_backend;
 };
 
 } // namespace lizard::parser
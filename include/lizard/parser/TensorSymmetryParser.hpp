@@ -5,16 +5,28 @@
 
 #pragma once
 
+#include "lizard/parser/TensorSymmetrySpecification.hpp"
+
 #include <filesystem>
 #include <iosfwd>
 #include <string_view>
 
 namespace lizard::parser {
 
+/**
+ * Parser for tensor symmetry files, which define the slot symmetries of tensor blocks
+ */
 class TensorSymmetryParser {
 public:
-	void parse(const std::filesystem::path &filePath);
-	void parse(std::istream &inputStream, std::string_view fileName = "");
+	/**
+	 * Parses the given file
+	 *
+	 * @returns The index space definitions and tensor symmetries contained in the file (in order of appearance)
+	 *
+	 * @throws ParseException if the file doesn't adhere to the expected format or contains an invalid symmetry
+	 */
+	auto parse(const std::filesystem::path &filePath) -> TensorSymmetrySpecification;
+	auto parse(std::istream &inputStream, std::string_view fileName = "") -> TensorSymmetrySpecification;
 };
 
 } // namespace lizard::parser
@@ -0,0 +1,57 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace lizard::parser {
+
+/**
+ * Definition of a name that stands for any one of a set of index spaces (e.g. "MY_SPACE = P | Q")
+ */
+struct IndexSpaceDefinition {
+	std::string name;
+	std::vector< std::string > choices;
+};
+
+/**
+ * The exchange of two index slots. Slots are numbered (starting at 1) in the order in which they appear in the block
+ * specification, i.e. creators first and annihilators afterwards.
+ */
+struct SlotExchange {
+	std::size_t first  = 0;
+	std::size_t second = 0;
+};
+
+/**
+ * A single symmetry of a tensor block (e.g. "T2[P P; H H]: 1,2 & 3,4 -> 1"). The listed slot exchanges are performed
+ * simultaneously and leave the tensor invariant up to the given factor (either 1 or -1).
+ */
+struct TensorSymmetryDefinition {
+	std::string tensorName;
+	/**
+	 * The index spaces (or names defined by an IndexSpaceDefinition) of the creator slots
+	 */
+	std::vector< std::string > creatorSpaces;
+	/**
+	 * The index spaces (or names defined by an IndexSpaceDefinition) of the annihilator slots
+	 */
+	std::vector< std::string > annihilatorSpaces;
+	std::vector< SlotExchange > exchanges;
+	int factor = 1;
+};
+
+/**
+ * The content of a tensor symmetry file
+ */
+struct TensorSymmetrySpecification {
+	std::vector< IndexSpaceDefinition > indexSpaces;
+	std::vector< TensorSymmetryDefinition > symmetries;
+};
+
+} // namespace lizard::parser
@@ -0,0 +1,88 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#pragma once
+
+#include "lizard/core/MemoryMappedFile.hpp"
+#include "lizard/symbolic/TensorElement.hpp"
+#include "lizard/symbolic/TensorExpressions.hpp"
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+namespace lizard {
+
+class BinaryExpressionReader;
+class IndexSpaceManager;
+
+/**
+ * Read-only view on a file written by BinaryExport that decodes the contained expression trees only once they are first
+ * accessed. Opening an archive only decodes the file's tables and its index of results, which makes it cheap to pick a
+ * few trees out of a large file.
+ *
+ * Accessing trees is not thread-safe, as trees are materialized on the fly.
+ */
+class BinaryArchive {
+public:
+	/**
+	 * Opens the given file
+	 *
+	 * @param filePath The path to the binary file
+	 * @param manager The IndexSpaceManager to resolve the index spaces referenced by the file with. It has to outlive
+	 * the archive.
+	 *
+	 * @throws ImportException if the file can't be read, is corrupted or refers to unknown index spaces
+	 */
+	BinaryArchive(const std::filesystem::path &filePath, const IndexSpaceManager &manager);
+	BinaryArchive(const BinaryArchive &) = delete;
+	BinaryArchive(BinaryArchive &&other) noexcept;
+	~BinaryArchive();
+	auto operator=(const BinaryArchive &) -> BinaryArchive & = delete;
+	auto operator=(BinaryArchive &&other) noexcept -> BinaryArchive &;
+
+	/**
+	 * @returns The number of trees in this archive
+	 */
+	[[nodiscard]] auto size() const -> std::size_t;
+
+	/**
+	 * @returns The results of all trees in this archive (in the order in which they are stored)
+	 */
+	[[nodiscard]] auto getResults() const -> const std::vector< TensorElement > &;
+
+	/**
+	 * @returns Whether this archive contains a tree for the given result
+	 */
+	[[nodiscard]] auto contains(const TensorElement &result) const -> bool;
+
+	/**
+	 * @returns The tree for the given result. If several trees share the same result, the first one of them is
+	 * returned. The returned reference stays valid for the lifetime of this archive.
+	 *
+	 * @throws ImportException if there is no tree for the given result or its data is corrupted
+	 */
+	[[nodiscard]] auto get(const TensorElement &result) -> const NamedTensorExprTree &;
+
+	/**
+	 * @returns The tree at the given position. The returned reference stays valid for the lifetime of this archive.
+	 *
+	 * @throws ImportException if there is no tree at the given position or its data is corrupted
+	 */
+	[[nodiscard]] auto get(std::size_t position) -> const NamedTensorExprTree &;
+
+	/**
+	 * @returns Whether the tree at the given position has been materialized already
+	 */
+	[[nodiscard]] auto isLoaded(std::size_t position) const -> bool;
+
+private:
+	MemoryMappedFile m_file;
+	std::unique_ptr< BinaryExpressionReader > m_reader;
+	std::vector< std::unique_ptr< NamedTensorExprTree > > m_trees;
+};
+
+} // namespace lizard
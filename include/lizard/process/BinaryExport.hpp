@@ -0,0 +1,62 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#pragma once
+
+#include "lizard/process/ExportStrategy.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <iosfwd>
+#include <string>
+
+namespace lizard {
+
+/**
+ * An exporter that writes the given expressions into a compact binary file, which can be read back in via
+ * BinaryImport (e.g. by a later lizard run or by downstream tools). Unlike the output of TextExport, the format is
+ * versioned and independent of the host's byte order (all integers are stored as little-endian).
+ *
+ * Tensor names and tensor blocks (including their slot symmetry) are stored only once in dedicated tables, which the
+ * individual tensor elements refer to. The names of all referenced index spaces are stored as well, such that importing
+ * the file into a run with an incompatible index space setup can be detected.
+ */
+class BinaryExport : public ExportStrategy {
+public:
+	/**
+	 * The version of the binary format written by this class
+	 */
+	static constexpr const std::uint16_t FormatVersion = 3;
+
+	/**
+	 * @param outputPath Path to the file that the expressions shall be written to
+	 */
+	explicit BinaryExport(std::filesystem::path outputPath = "lizard.lzb");
+
+	[[nodiscard]] auto getName() const -> std::string final;
+
+	[[nodiscard]] auto getParameters() const -> std::string final;
+
+	void exportExpressions(nonstd::span< const NamedTensorExprTree > expressions,
+						   const IndexSpaceManager &manager) final;
+
+	/**
+	 * Writes the given expressions to the given stream, which is expected to be opened in binary mode
+	 *
+	 * @throws ExportException if the expressions can't be represented or writing to the stream fails
+	 */
+	static void write(nonstd::span< const NamedTensorExprTree > expressions, const IndexSpaceManager &manager,
+					  std::ostream &stream);
+
+	/**
+	 * @returns The path of the file that the expressions are written to
+	 */
+	[[nodiscard]] auto getOutputPath() const -> const std::filesystem::path &;
+
+private:
+	std::filesystem::path m_outputPath;
+};
+
+} // namespace lizard
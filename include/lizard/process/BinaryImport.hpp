@@ -0,0 +1,76 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#pragma once
+
+#include "lizard/process/ImportStrategy.hpp"
+#include "lizard/symbolic/TensorExpressions.hpp"
+
+#include <nonstd/span.hpp>
+
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace lizard {
+
+class IndexSpaceManager;
+
+/**
+ * This import strategy reads the expressions contained in a file written by BinaryExport. Optionally, only the trees
+ * whose result belongs to one of a set of selected tensors are imported. Thanks to the file's index, the remaining
+ * trees are skipped without being decoded.
+ *
+ * See BinaryArchive for accessing individual trees on demand.
+ */
+class BinaryImport : public ImportStrategy {
+public:
+	/**
+	 * @param filePath The path to the binary file to import
+	 * @param selectedResults The names of the result tensors whose trees shall be imported. If empty, all trees are
+	 * imported.
+	 */
+	explicit BinaryImport(std::filesystem::path filePath, std::vector< std::string > selectedResults = {});
+
+	[[nodiscard]] auto getName() const -> std::string final;
+
+	[[nodiscard]] auto getParameters() const -> std::string final;
+
+	[[nodiscard]] auto importExpressions(const IndexSpaceManager &manager) const
+		-> std::vector< NamedTensorExprTree > final;
+
+	/**
+	 * Reads the expressions contained in the given data (the content of a file written by BinaryExport)
+	 *
+	 * @param data The binary data to read
+	 * @param manager The IndexSpaceManager to resolve the index spaces referenced by the data with
+	 * @param source The name of the data's origin (e.g. a file name) to use in error messages
+	 * @param selectedResults The names of the result tensors whose trees shall be read. If empty, all trees are read.
+	 *
+	 * @throws ImportException if the data is corrupted, refers to unknown index spaces or doesn't contain a tree for
+	 * one of the selected results
+	 */
+	[[nodiscard]] static auto read(std::string_view data, const IndexSpaceManager &manager,
+								   std::string_view source                           = "<memory>",
+								   nonstd::span< const std::string > selectedResults = {})
+		-> std::vector< NamedTensorExprTree >;
+
+	/**
+	 * @returns The path of the imported file
+	 */
+	[[nodiscard]] auto getFilePath() const -> const std::filesystem::path &;
+
+	/**
+	 * @returns The names of the result tensors whose trees are imported (empty if all trees are imported)
+	 */
+	[[nodiscard]] auto getSelectedResults() const -> const std::vector< std::string > &;
+
+private:
+	std::filesystem::path m_filePath;
+	std::vector< std::string > m_selectedResults;
+};
+
+} // namespace lizard
@@ -0,0 +1,28 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#pragma once
+
+#include "lizard/process/OptimizationStrategy.hpp"
+
+namespace lizard {
+
+/**
+ * Optimization strategy that searches all expressions for binary contractions that are equal up to a renaming of
+ * indices (and possibly a sign). Every contraction that occurs more than once is hoisted into a new intermediate
+ * expression that is prepended to the list of expressions, and all of its occurrences are replaced by the
+ * corresponding intermediate tensor. This is repeated until no further shared contractions can be found, so
+ * intermediates may themselves be built from other intermediates.
+ */
+class CommonSubexpressionElimination : public OptimizationStrategy {
+public:
+	CommonSubexpressionElimination() = default;
+
+	[[nodiscard]] auto getName() const -> std::string final;
+
+	void process(std::vector< NamedTensorExprTree > &expressions, const IndexSpaceManager &manager) final;
+};
+
+} // namespace lizard
@@ -0,0 +1,155 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#pragma once
+
+#include "lizard/symbolic/Index.hpp"
+#include "lizard/symbolic/IndexSpace.hpp"
+#include "lizard/symbolic/TensorExpressions.hpp"
+
+#include <nonstd/span.hpp>
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace lizard {
+
+class IndexSpaceManager;
+
+/**
+ * Describes how the cost of an operation scales with the sizes of the involved index spaces, e.g. o^2 v^4
+ */
+class Scaling {
+public:
+	Scaling() = default;
+
+	/**
+	 * Increases the exponent of the given space by the given amount
+	 */
+	void add(const IndexSpace &space, unsigned int exponent = 1);
+
+	/**
+	 * @returns The exponent of the given space
+	 */
+	[[nodiscard]] auto getExponent(const IndexSpace &space) const -> unsigned int;
+
+	/**
+	 * @returns The sum of the exponents of all index spaces
+	 */
+	[[nodiscard]] auto getTotalExponent() const -> unsigned int;
+
+	/**
+	 * @returns A human-readable representation of this scaling, using the short names of the index spaces
+	 */
+	[[nodiscard]] auto toString(const IndexSpaceManager &manager) const -> std::string;
+
+	friend auto operator==(const Scaling &lhs, const Scaling &rhs) -> bool;
+	friend auto operator!=(const Scaling &lhs, const Scaling &rhs) -> bool;
+
+private:
+	std::map< IndexSpace::Id, unsigned int > m_exponents;
+};
+
+/**
+ * The estimated cost of evaluating an expression
+ */
+struct ExpressionCost {
+	/**
+	 * The number of floating point operations, counting one operation per multiply-add
+	 */
+	double flops = 0;
+	/**
+	 * The number of floating point operations required by the single most expensive operation
+	 */
+	double dominantFlops = 0;
+	/**
+	 * The number of elements of the largest intermediate tensor
+	 */
+	double peakIntermediateSize = 0;
+	/**
+	 * The scaling of the most expensive operation
+	 */
+	Scaling scaling;
+
+	/**
+	 * Accumulates the given cost into this one
+	 */
+	auto operator+=(const ExpressionCost &other) -> ExpressionCost &;
+};
+
+/**
+ * Orders costs by their number of floating point operations first and by the size of their largest intermediate second
+ */
+[[nodiscard]] auto operator<(const ExpressionCost &lhs, const ExpressionCost &rhs) -> bool;
+
+/**
+ * The estimated cost of evaluating a set of expressions
+ */
+struct CostReport {
+	/**
+	 * The cost of the individual expressions
+	 */
+	std::vector< ExpressionCost > expressions;
+	/**
+	 * The accumulated cost of all expressions
+	 */
+	ExpressionCost total;
+};
+
+/**
+ * A simple model for estimating the computational cost of expression trees. Every product and sum in a tree is
+ * assumed to be evaluated exactly as written, i.e. in the order implied by the tree's structure, with every
+ * non-root node producing an intermediate result. The number of operations of an individual product or sum is given
+ * by the product of the sizes of all distinct indices involved in it.
+ *
+ * The same model is used by the optimization strategies to cost the individual contractions they consider.
+ */
+class CostModel {
+public:
+	explicit CostModel(const IndexSpaceManager &manager);
+
+	/**
+	 * @param tree The tree to estimate
+	 * @param externals The indices that are not summed over, even if they appear in multiple factors
+	 * @returns The estimated cost of evaluating the given tree
+	 */
+	[[nodiscard]] auto estimate(const TensorExprTree &tree, nonstd::span< const Index > externals = {}) const
+		-> ExpressionCost;
+
+	/**
+	 * @returns The estimated cost of evaluating the given expression
+	 */
+	[[nodiscard]] auto estimate(const NamedTensorExprTree &tree) const -> ExpressionCost;
+
+	/**
+	 * @returns The estimated cost of evaluating all of the given expressions
+	 */
+	[[nodiscard]] auto estimate(nonstd::span< const NamedTensorExprTree > expressions) const -> CostReport;
+
+	/**
+	 * @param involvedIndices The distinct indices involved in a single product or sum
+	 * @returns The estimated cost of performing that single operation
+	 */
+	[[nodiscard]] auto estimateOperation(nonstd::span< const Index > involvedIndices) const -> ExpressionCost;
+
+	/**
+	 * @returns The number of elements in the given index space
+	 */
+	[[nodiscard]] auto getSize(const IndexSpace &space) const -> double;
+
+	/**
+	 * @returns The number of elements of a tensor carrying the given (distinct) indices
+	 */
+	[[nodiscard]] auto getSize(nonstd::span< const Index > indices) const -> double;
+
+private:
+	const IndexSpaceManager *m_manager;
+
+	auto estimateExpression(const ConstTensorExpr &expression, nonstd::span< const Index > externals,
+							ExpressionCost &cost) const -> std::vector< Index >;
+};
+
+} // namespace lizard
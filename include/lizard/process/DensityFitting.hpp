@@ -0,0 +1,61 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#pragma once
+
+#include "lizard/process/SubstitutionStrategy.hpp"
+#include "lizard/symbolic/Index.hpp"
+#include "lizard/symbolic/TensorElement.hpp"
+
+#include <cstddef>
+#include <string>
+
+namespace lizard {
+
+/**
+ * Substitution strategy that applies the density-fitting (resolution of the identity) approximation to the
+ * antisymmetrized two-electron integrals. Every integral H[p+,q+,r-,s-] = <pq||rs> is replaced by
+ * B[P,p+,r-] * B[P,q+,s-] - B[P,p+,s-] * B[P,q+,r-], where B are the three-index density-fitting factors and P is
+ * an index of the auxiliary index space. The factors are symmetric with respect to exchanging their last two indices
+ * and the auxiliary index is spin-free. Products containing integrals are expanded accordingly such that a
+ * subsequent StrengthReduction is able to contract the factors in an order that avoids the steep scaling associated
+ * with the four-index integrals.
+ */
+class DensityFitting : public SubstitutionStrategy {
+public:
+	/**
+	 * @param auxiliarySpace The name of the index space representing the auxiliary basis. It has to be registered as a
+	 * spin-free space with the IndexSpaceManager passed to process.
+	 * @param integralTensor The name of the tensor representing the two-electron integrals
+	 * @param factorTensor The name of the tensor representing the three-index factors
+	 */
+	explicit DensityFitting(std::string auxiliarySpace, std::string integralTensor = "H",
+							std::string factorTensor = "B");
+
+	[[nodiscard]] auto getName() const -> std::string final;
+
+	[[nodiscard]] auto getParameters() const -> std::string final;
+
+	/**
+	 * @throws ProcessingException if the auxiliary index space isn't registered with the given manager or isn't
+	 * spin-free
+	 */
+	void process(std::vector< NamedTensorExprTree > &expressions, const IndexSpaceManager &manager) final;
+
+private:
+	std::string m_auxiliarySpace;
+	std::string m_integralTensor;
+	std::string m_factorTensor;
+
+	[[nodiscard]] auto isIntegral(const TensorElement &element) const -> bool;
+
+	[[nodiscard]] auto createFactor(const Index &auxiliary, const Index &first, const Index &second) const
+		-> TensorElement;
+
+	[[nodiscard]] auto substitute(const ConstTensorExpr &expression, const IndexSpace &auxiliarySpace,
+								  Index::Id &nextID, std::size_t &substitutionCount) const -> TensorExprTree;
+};
+
+} // namespace lizard
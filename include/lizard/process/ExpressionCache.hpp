@@ -0,0 +1,74 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#pragma once
+
+#include "lizard/symbolic/TensorExpressions.hpp"
+
+#include <nonstd/span.hpp>
+
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace lizard {
+
+class IndexSpaceManager;
+class Strategy;
+
+/**
+ * An on-disk, content-addressed cache for the results of individual processing steps. Every entry is stored under a
+ * key that is derived from the expressions that served as input to a step, the name and parameters of the Strategy
+ * that was applied to them and the index spaces referenced by the input. Thus, rerunning a processing chain with
+ * unchanged input and configuration can simply restore the results of all steps from the cache.
+ *
+ * Note that a change in the implementation of a strategy (without a corresponding change of its parameters) is not
+ * detected, so the cache should be cleared after updating lizard.
+ */
+class ExpressionCache {
+public:
+	/**
+	 * @param directory The directory in which the cached entries shall be stored. It is created if it doesn't exist.
+	 */
+	explicit ExpressionCache(std::filesystem::path directory);
+
+	/**
+	 * @returns The key under which the result of applying the given strategy to the given expressions is cached
+	 */
+	[[nodiscard]] static auto computeKey(nonstd::span< const NamedTensorExprTree > input, const Strategy &strategy,
+										 const IndexSpaceManager &manager) -> std::string;
+
+	/**
+	 * @returns Whether there exists a cache entry for the given key
+	 */
+	[[nodiscard]] auto contains(const std::string &key) const -> bool;
+
+	/**
+	 * @param key The key of the entry to load
+	 * @param manager The IndexSpaceManager to resolve the index spaces referenced by the cached expressions with
+	 * @returns The expressions cached under the given key or an empty optional, if there is no such (valid) entry
+	 */
+	[[nodiscard]] auto load(const std::string &key, const IndexSpaceManager &manager) const
+		-> std::optional< std::vector< NamedTensorExprTree > >;
+
+	/**
+	 * Stores the given expressions under the given key. The entry is written in the format of BinaryExport.
+	 *
+	 * @throws ProcessingException if storing fails
+	 */
+	void store(const std::string &key, nonstd::span< const NamedTensorExprTree > expressions,
+			   const IndexSpaceManager &manager) const;
+
+	/**
+	 * @returns The directory in which cache entries are stored
+	 */
+	[[nodiscard]] auto getDirectory() const -> const std::filesystem::path &;
+
+private:
+	std::filesystem::path m_directory;
+};
+
+} // namespace lizard
@@ -0,0 +1,27 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#pragma once
+
+#include "lizard/process/OptimizationStrategy.hpp"
+
+namespace lizard {
+
+/**
+ * Optimization strategy that pulls common factors out of sums, e.g. A * B * C + A * B * D -> A * B * (C + D).
+ * Factors are considered common if they are identical after renaming the contracted indices of one of the terms.
+ * A factorization is only performed if it reduces the estimated number of floating point operations required to
+ * evaluate the respective expression.
+ */
+class Factorization : public OptimizationStrategy {
+public:
+	Factorization() = default;
+
+	[[nodiscard]] auto getName() const -> std::string final;
+
+	void process(std::vector< NamedTensorExprTree > &expressions, const IndexSpaceManager &manager) final;
+};
+
+} // namespace lizard
@@ -0,0 +1,81 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#pragma once
+
+#include "lizard/parser/GeCCoExportParser.hpp"
+#include "lizard/process/ImportStrategy.hpp"
+#include "lizard/symbolic/TensorExpressions.hpp"
+
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace lizard {
+
+class IndexSpaceManager;
+
+/**
+ * This import strategy reads the contractions contained in an export file produced by GeCCo. Contractions are
+ * converted into expression trees while the file is being parsed and all contractions contributing to the same result
+ * tensor are collected into a single tree.
+ *
+ * The file is memory-mapped and split into chunks of consecutive contractions, which are parsed in parallel. The
+ * chunking only depends on the file's content, so the imported expressions don't depend on the number of threads.
+ */
+class GeCCoImport : public ImportStrategy {
+public:
+	/**
+	 * @param filePath The path to the GeCCo export file
+	 * @param spaceNames The names of the index spaces that GeCCo's index spaces (hole, particle, valence, ...) are
+	 * mapped to (in order of GeCCo's space numbering)
+	 * @param threadCount The number of threads to parse the file with. If zero, the number of available hardware
+	 * threads is used.
+	 * @param backend The parser implementation to use (both produce the same contractions)
+	 */
+	explicit GeCCoImport(std::filesystem::path filePath,
+						 std::vector< std::string > spaceNames      = { "Closed", "External", "Active" },
+						 std::size_t threadCount                    = 0,
+						 parser::GeCCoExportParser::Backend backend = parser::GeCCoExportParser::Backend::ANTLR);
+
+	[[nodiscard]] auto getName() const -> std::string final;
+
+	[[nodiscard]] auto getParameters() const -> std::string final;
+
+	[[nodiscard]] auto importExpressions(const IndexSpaceManager &manager) const
+		-> std::vector< NamedTensorExprTree > final;
+
+	/**
+	 * @returns The number of threads used for parsing
+	 */
+	[[nodiscard]] auto getThreadCount() const -> std::size_t;
+
+	/**
+	 * @returns The parser implementation used for parsing
+	 */
+	[[nodiscard]] auto getBackend() const -> parser::GeCCoExportParser::Backend;
+
+	/**
+	 * Sets the tensor symmetry file that defines the slot symmetries of the imported tensor blocks. Blocks that the
+	 * file doesn't define a symmetry for are imported without any symmetry. An empty path disables the use of a
+	 * symmetry file (the default).
+	 */
+	void setSymmetryFile(std::filesystem::path symmetryFile);
+
+	/**
+	 * @returns The path to the used tensor symmetry file (empty if none is used)
+	 */
+	[[nodiscard]] auto getSymmetryFile() const -> const std::filesystem::path &;
+
+private:
+	std::filesystem::path m_filePath;
+	std::vector< std::string > m_spaceNames;
+	std::size_t m_threadCount;
+	parser::GeCCoExportParser::Backend m_backend;
+	std::filesystem::path m_symmetryFile;
+};
+
+} // namespace lizard
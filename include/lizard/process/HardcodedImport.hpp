@@ -29,6 +29,8 @@ public:
 
 	[[nodiscard]] auto getName() const -> std::string final;
 
+	[[nodiscard]] auto getParameters() const -> std::string final;
+
 	[[nodiscard]] auto importExpressions(const IndexSpaceManager &manager) const
 		-> std::vector< NamedTensorExprTree > final;
 
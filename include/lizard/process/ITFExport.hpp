@@ -7,19 +7,70 @@
 
 #include "lizard/process/ExportStrategy.hpp"
 
+#include <cstddef>
+#include <filesystem>
+#include <iosfwd>
+#include <string>
+
 namespace lizard {
 
+class MappedTensorExprTree;
+
 /**
- * An exporter that will convert the given expressions into the ITF format
+ * An exporter that will convert the given expressions into the ITF format. Every expression tree is translated into
+ * its own code block. The translation of different trees happens in parallel, but the produced code blocks are always
+ * written in the order of the input expressions.
  */
 class ITFExport : public ExportStrategy {
 public:
-	ITFExport() = default;
+	/**
+	 * @param outputPath Path to the file that the generated ITF code shall be written to
+	 * @param threadCount The number of threads to use for the translation. If zero, the number of hardware threads
+	 * is used.
+	 */
+	explicit ITFExport(std::filesystem::path outputPath = "lizard.itf", std::size_t threadCount = 0);
 
 	[[nodiscard]] auto getName() const -> std::string final;
 
+	[[nodiscard]] auto getParameters() const -> std::string final;
+
 	void exportExpressions(nonstd::span< const NamedTensorExprTree > expressions,
 						   const IndexSpaceManager &manager) final;
+
+	/**
+	 * Translates the given expressions into ITF and writes the resulting code blocks to the given stream
+	 *
+	 * @throws ExportException if writing to the stream fails
+	 */
+	void write(nonstd::span< const NamedTensorExprTree > expressions, const IndexSpaceManager &manager,
+			   std::ostream &stream) const;
+
+	/**
+	 * Translates the given memory-mapped expressions into ITF without materializing them first. The produced code is
+	 * the same as for the corresponding NamedTensorExprTrees.
+	 *
+	 * @throws ExportException if writing to the stream fails
+	 */
+	void write(nonstd::span< const MappedTensorExprTree > expressions, const IndexSpaceManager &manager,
+			   std::ostream &stream) const;
+
+	/**
+	 * @returns The path of the file that the generated ITF code is written to
+	 */
+	[[nodiscard]] auto getOutputPath() const -> const std::filesystem::path &;
+
+	/**
+	 * @returns The number of threads used for the translation
+	 */
+	[[nodiscard]] auto getThreadCount() const -> std::size_t;
+
+private:
+	std::filesystem::path m_outputPath;
+	std::size_t m_threadCount;
+
+	template< typename Tree >
+	void writeTrees(nonstd::span< const Tree > expressions, const IndexSpaceManager &manager,
+					std::ostream &stream) const;
 };
 
 } // namespace lizard
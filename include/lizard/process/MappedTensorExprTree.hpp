@@ -0,0 +1,308 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#pragma once
+
+#include "lizard/core/Fraction.hpp"
+#include "lizard/core/MemoryMappedFile.hpp"
+#include "lizard/core/Numeric.hpp"
+#include "lizard/symbolic/ExpressionCardinality.hpp"
+#include "lizard/symbolic/ExpressionOperator.hpp"
+#include "lizard/symbolic/ExpressionType.hpp"
+#include "lizard/symbolic/TensorElement.hpp"
+#include "lizard/symbolic/TensorExpressions.hpp"
+#include "lizard/symbolic/TreeNode.hpp"
+#include "lizard/symbolic/TreeTraversal.hpp"
+
+#include <cstddef>
+#include <filesystem>
+#include <iterator>
+#include <memory>
+#include <string_view>
+
+namespace lizard {
+
+class BinaryExpressionReader;
+class IndexSpaceManager;
+class MappedTensorExprTree;
+
+/**
+ * Read-only expression inside a MappedTensorExprTree. It mirrors the API of ConstExpression< TensorElement > but
+ * refers to nodes that live inside of a memory-mapped file instead of inside an ExpressionTree.
+ *
+ * @see ConstExpression
+ */
+class MappedTensorExpr {
+public:
+	template< TreeTraversal iteration_order > class Iterator;
+
+	using const_post_order_iterator = Iterator< TreeTraversal::DepthFirst_PostOrder >;
+	using const_pre_order_iterator  = Iterator< TreeTraversal::DepthFirst_PreOrder >;
+	using const_in_order_iterator   = Iterator< TreeTraversal::DepthFirst_InOrder >;
+
+	using iterator       = const_post_order_iterator;
+	using const_iterator = const_post_order_iterator;
+
+	MappedTensorExpr(Numeric nodeID, const MappedTensorExprTree &tree);
+
+	/**
+	 * @returns The cardinality of this expression
+	 */
+	[[nodiscard]] auto getCardinality() const -> ExpressionCardinality;
+
+	/**
+	 * @returns The type of this expression
+	 */
+	[[nodiscard]] auto getType() const -> ExpressionType;
+
+	/**
+	 * @returns The parent of the currently represented expression
+	 *
+	 * Note: Calling this function on a root expression (isRoot() returns true) is undefined behavior!
+	 */
+	[[nodiscard]] auto getParent() const -> MappedTensorExpr;
+
+	/**
+	 * @returns The represented variable. Since the mapped file only contains a packed representation of the
+	 * TensorElement, it is unpacked on every call to this function.
+	 *
+	 * Note: If this expression doesn't actually represent a variable, calling this function is undefined behavior
+	 *
+	 * @throws ExpressionException if the element's data is corrupted
+	 */
+	[[nodiscard]] auto getVariable() const -> TensorElement;
+
+	/**
+	 * @returns The represented operator type
+	 *
+	 * Note: If this expression doesn't actually represent an operator, calling this function is undefined behavior!
+	 */
+	[[nodiscard]] auto getOperator() const -> ExpressionOperator;
+
+	/**
+	 * @returns The literal value this expression represents
+	 *
+	 * Note: If this expression doesn't actually represent a literal value, calling this function is undefined behavior!
+	 */
+	[[nodiscard]] auto getLiteral() const -> Fraction;
+
+	/**
+	 * @returns The expression representing the left argument of the represented binary expression
+	 *
+	 * Note: If this expression is not actually binary, calling this function is undefined behavior!
+	 */
+	[[nodiscard]] auto getLeftArg() const -> MappedTensorExpr;
+
+	/**
+	 * @returns The expression representing the right argument of the represented binary expression
+	 *
+	 * Note: If this expression is not actually binary, calling this function is undefined behavior!
+	 */
+	[[nodiscard]] auto getRightArg() const -> MappedTensorExpr;
+
+	/**
+	 * @returns Whether this expression represents the root of the overall expression (tree)
+	 */
+	[[nodiscard]] auto isRoot() const -> bool;
+
+	/**
+	 * @returns The size of the expression rooted at the currently represented element
+	 */
+	[[nodiscard]] auto size() const -> Numeric::numeric_type;
+
+	/**
+	 * @returns The MappedTensorExprTree that contains this expression
+	 */
+	[[nodiscard]] auto getContainingTree() const -> const MappedTensorExprTree &;
+
+	/**
+	 * @returns Whether the given expression object describes the exact same expression in the same tree
+	 */
+	[[nodiscard]] auto isSame(const MappedTensorExpr &other) const -> bool;
+
+	template< TreeTraversal iteration_order = TreeTraversal::DepthFirst_PostOrder >
+	auto begin() const -> Iterator< iteration_order >;
+
+	template< TreeTraversal iteration_order = TreeTraversal::DepthFirst_PostOrder >
+	auto end() const -> Iterator< iteration_order >;
+
+	template< TreeTraversal iteration_order = TreeTraversal::DepthFirst_PostOrder >
+	auto cbegin() const -> Iterator< iteration_order > {
+		return begin< iteration_order >();
+	}
+
+	template< TreeTraversal iteration_order = TreeTraversal::DepthFirst_PostOrder >
+	auto cend() const -> Iterator< iteration_order > {
+		return end< iteration_order >();
+	}
+
+	friend auto operator==(const MappedTensorExpr &lhs, const MappedTensorExpr &rhs) -> bool;
+	friend auto operator!=(const MappedTensorExpr &lhs, const MappedTensorExpr &rhs) -> bool;
+
+private:
+	Numeric m_nodeID;
+	const MappedTensorExprTree *m_tree;
+
+	[[nodiscard]] auto node() const -> TreeNode;
+
+	friend class MappedTensorExprTree;
+};
+
+
+/**
+ * Iterator for traversing the sub-tree rooted at a given MappedTensorExpr
+ */
+template< TreeTraversal iteration_order > class MappedTensorExpr::Iterator {
+public:
+	using iterator_category = std::input_iterator_tag;
+	using value_type        = MappedTensorExpr;
+	using difference_type   = std::ptrdiff_t;
+	using reference         = MappedTensorExpr;
+
+	struct pointer {
+		MappedTensorExpr expr;
+
+		auto operator->() const -> const MappedTensorExpr * { return &expr; }
+	};
+
+	auto operator*() const -> reference { return { m_currentID, *m_tree }; }
+	auto operator->() const -> pointer { return { **this }; }
+
+	auto operator++() -> Iterator & {
+		increment();
+		return *this;
+	}
+	auto operator++(int) -> Iterator {
+		Iterator copy = *this;
+		increment();
+		return copy;
+	}
+
+	friend auto operator==(const Iterator &lhs, const Iterator &rhs) -> bool {
+		return lhs.m_tree == rhs.m_tree && lhs.m_currentID == rhs.m_currentID && lhs.m_previousID == rhs.m_previousID;
+	}
+	friend auto operator!=(const Iterator &lhs, const Iterator &rhs) -> bool { return !(lhs == rhs); }
+
+private:
+	const MappedTensorExprTree *m_tree;
+	Numeric m_rootID;
+	Numeric m_currentID;
+	Numeric m_previousID;
+
+	Iterator(const MappedTensorExprTree &tree, Numeric rootID, Numeric currentID, Numeric previousID)
+		: m_tree(&tree), m_rootID(rootID), m_currentID(currentID), m_previousID(previousID) {}
+
+	static auto begin(const MappedTensorExprTree &tree, Numeric rootID) -> Iterator;
+	static auto end(const MappedTensorExprTree &tree, Numeric rootID) -> Iterator {
+		return { tree, rootID, Numeric{}, Numeric{} };
+	}
+
+	void increment();
+
+	friend class MappedTensorExpr;
+	friend class MappedTensorExprTree;
+};
+
+
+/**
+ * A read-only expression tree over TensorElements that is not stored on the heap but instead directly operates on a
+ * memory-mapped file written by BinaryExport. The nodes are navigated in-place (without any deserialization) and
+ * TensorElements are only unpacked when they are requested. This allows multiple consumers (e.g. different exporters)
+ * to share a single copy of a potentially very large set of equations.
+ *
+ * The structure of the tree is verified once when the tree is opened, such that navigating it never leaves the
+ * mapped data, even if the file is corrupted.
+ */
+class MappedTensorExprTree {
+public:
+	using const_iterator = MappedTensorExpr::const_iterator;
+	using iterator       = const_iterator;
+
+	/**
+	 * Maps the given file into memory
+	 *
+	 * @param path The path to a file written by BinaryExport
+	 * @param manager The IndexSpaceManager to resolve the index spaces referenced by the file with. It has to outlive
+	 * the tree.
+	 * @param position The position of the tree inside the file
+	 *
+	 * @throws ExpressionException if the given file doesn't contain a valid tree at the given position
+	 */
+	MappedTensorExprTree(const std::filesystem::path &path, const IndexSpaceManager &manager,
+						 std::size_t position = 0);
+	MappedTensorExprTree(const MappedTensorExprTree &) = delete;
+	MappedTensorExprTree(MappedTensorExprTree &&other) noexcept;
+	~MappedTensorExprTree();
+	auto operator=(const MappedTensorExprTree &) -> MappedTensorExprTree & = delete;
+	auto operator=(MappedTensorExprTree &&other) noexcept -> MappedTensorExprTree &;
+
+	/**
+	 * @returns The result that this tree is assigned to
+	 */
+	[[nodiscard]] auto getResult() const -> const TensorElement &;
+
+	/**
+	 * @returns Whether this tree is empty
+	 */
+	[[nodiscard]] auto isEmpty() const -> bool;
+
+	/**
+	 * @returns The root expression of this tree
+	 *
+	 * Note: Calling this function on an empty tree is undefined behavior!
+	 */
+	[[nodiscard]] auto getRoot() const -> MappedTensorExpr;
+
+	/**
+	 * @returns The amount of TreeNodes in this tree
+	 */
+	[[nodiscard]] auto size() const -> Numeric::numeric_type;
+
+	/**
+	 * @returns The amount of variables stored in this tree
+	 */
+	[[nodiscard]] auto variableCount() const -> Numeric::numeric_type;
+
+	/**
+	 * Creates a regular (mutable) ExpressionTree that represents the same expression as this mapped tree
+	 */
+	[[nodiscard]] auto materialize() const -> NamedTensorExprTree;
+
+	template< TreeTraversal iteration_order = TreeTraversal::DepthFirst_PostOrder >
+	auto begin() const -> MappedTensorExpr::Iterator< iteration_order > {
+		return isEmpty() ? end< iteration_order >() : getRoot().begin< iteration_order >();
+	}
+
+	template< TreeTraversal iteration_order = TreeTraversal::DepthFirst_PostOrder >
+	auto end() const -> MappedTensorExpr::Iterator< iteration_order > {
+		return isEmpty() ? MappedTensorExpr::Iterator< iteration_order >::end(*this, Numeric{})
+						 : getRoot().end< iteration_order >();
+	}
+
+private:
+	MemoryMappedFile m_file;
+	std::unique_ptr< BinaryExpressionReader > m_reader;
+	std::size_t m_position;
+	std::string_view m_nodes;
+	std::string_view m_elements;
+	Numeric::numeric_type m_size          = 0;
+	Numeric::numeric_type m_variableCount = 0;
+
+	[[nodiscard]] auto node(Numeric nodeID) const -> TreeNode;
+	[[nodiscard]] auto unpackVariable(Numeric elementOffset) const -> TensorElement;
+
+	friend class MappedTensorExpr;
+	template< TreeTraversal > friend class MappedTensorExpr::Iterator;
+};
+
+template< TreeTraversal iteration_order > auto MappedTensorExpr::begin() const -> Iterator< iteration_order > {
+	return Iterator< iteration_order >::begin(*m_tree, m_nodeID);
+}
+
+template< TreeTraversal iteration_order > auto MappedTensorExpr::end() const -> Iterator< iteration_order > {
+	return Iterator< iteration_order >::end(*m_tree, m_nodeID);
+}
+
+} // namespace lizard
@@ -5,12 +5,14 @@
 
 #pragma once
 
+#include "lizard/process/ExpressionCache.hpp"
 #include "lizard/process/ProcessingStep.hpp"
 #include "lizard/symbolic/IndexSpaceManager.hpp"
 
 #include <spdlog/logger.h>
 
 #include <memory>
+#include <optional>
 #include <vector>
 
 namespace lizard {
@@ -36,6 +38,12 @@ public:
 	 */
 	void setLogger(std::shared_ptr< spdlog::logger > logger);
 
+	/**
+	 * Sets the cache that shall be used to store the results of (and to skip) import and rewrite steps. Export steps
+	 * are always executed. Passing an empty optional disables caching.
+	 */
+	void setCache(std::optional< ExpressionCache > cache);
+
 	/**
 	 * Queues the provided processing step to be executed after all steps that have been queued before
 	 */
@@ -55,6 +63,7 @@ private:
 	IndexSpaceManager m_spaceManager;
 	std::shared_ptr< spdlog::logger > m_log;
 	std::vector< ProcessingStep > m_steps;
+	std::optional< ExpressionCache > m_cache;
 };
 
 } // namespace lizard
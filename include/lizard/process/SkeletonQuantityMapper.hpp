@@ -12,6 +12,10 @@ namespace lizard {
 /**
  * Processing step that maps spin-integrated quantities to so-called "skeleton" (or "orbital") quantities.
  * The process is described in e.g. J. Chem. Theory Comput. 2013, 9, 2567−2572 (DOI: 10.1021/ct301024v)
+ *
+ * Elements with external indices are only mapped if they are density-fitting factors B[P,p+,q-], i.e. if they have a
+ * single creator and annihilator and all of their external indices are spin-free. Their skeleton quantity keeps the
+ * element's symmetry. All other elements with external or spin-free indices are left untouched.
  */
 class SkeletonQuantityMapper : public SpinProcessingStrategy {
 public:
@@ -38,6 +38,13 @@ public:
 	 */
 	[[nodiscard]] virtual auto getType() const -> StrategyType = 0;
 
+	/**
+	 * @returns A textual representation of all parameters of this strategy that influence its outcome. Two instances
+	 * of the same strategy that return the same parameters are expected to produce identical results for identical
+	 * inputs. By default, strategies are assumed to not have any such parameters.
+	 */
+	[[nodiscard]] virtual auto getParameters() const -> std::string;
+
 	/**
 	 * Sets the logger that shall be used by this Strategy to report its progress
 	 */
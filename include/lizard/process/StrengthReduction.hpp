@@ -0,0 +1,43 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#pragma once
+
+#include "lizard/process/OptimizationStrategy.hpp"
+
+#include <cstddef>
+
+namespace lizard {
+
+/**
+ * Optimization strategy that chooses the order in which the factors of every product are contracted with one another
+ * such that the number of floating point operations (FLOPs) required to evaluate the product becomes minimal. Among
+ * orders with equal FLOP count, the one requiring the smallest intermediate tensors is preferred. The cost of a
+ * binary contraction is estimated as the product of the sizes (as given by the IndexSpaceData) of all involved
+ * indices.
+ *
+ * Products with up to a given number of factors are optimized exhaustively, whereas a greedy approach is used for
+ * larger products.
+ */
+class StrengthReduction : public OptimizationStrategy {
+public:
+	/**
+	 * @param exhaustiveSearchLimit The maximum number of factors in a product for which the optimal contraction order
+	 * is determined by means of an exhaustive search. As the memory required by the exhaustive search doubles with
+	 * every additional factor, values larger than 16 are clamped to 16.
+	 */
+	explicit StrengthReduction(std::size_t exhaustiveSearchLimit = 8);
+
+	[[nodiscard]] auto getName() const -> std::string final;
+
+	[[nodiscard]] auto getParameters() const -> std::string final;
+
+	void process(std::vector< NamedTensorExprTree > &expressions, const IndexSpaceManager &manager) final;
+
+private:
+	std::size_t m_exhaustiveSearchLimit;
+};
+
+} // namespace lizard
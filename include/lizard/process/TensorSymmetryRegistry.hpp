@@ -0,0 +1,116 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#pragma once
+
+#include "lizard/symbolic/Index.hpp"
+#include "lizard/symbolic/Tensor.hpp"
+#include "lizard/symbolic/TensorBlock.hpp"
+#include "lizard/symbolic/TensorElement.hpp"
+
+#include <libperm/Permutation.hpp>
+
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+namespace lizard {
+
+namespace parser {
+struct TensorSymmetrySpecification;
+}
+
+class IndexSpaceManager;
+
+/**
+ * Registry of the slot symmetries of tensor blocks. The symmetry group of every registered block is built only once,
+ * together with the canonical order of the block's slots, such that elements of a block can be created without having
+ * to assemble its symmetry over and over again.
+ *
+ * A block is identified by the name of its tensor, the number of creators and the index spaces of its slots (creators
+ * first, annihilators afterwards).
+ */
+class TensorSymmetryRegistry {
+public:
+	/**
+	 * The prebuilt symmetry of a single tensor block
+	 */
+	struct BlockSymmetry {
+		/**
+		 * The block with its slots in canonical order and the registered slot symmetry
+		 */
+		TensorBlock block;
+		/**
+		 * The permutation that brings the slots (in the order used for looking up the block) into canonical order
+		 */
+		perm::Permutation canonicalOrder;
+	};
+
+	TensorSymmetryRegistry() = default;
+
+	/**
+	 * Creates a registry from the given specification (as obtained from a tensor symmetry file). Block specifications
+	 * that refer to index space definitions (e.g. "ANY = occ | virt") are expanded into all blocks that they stand for
+	 * and all symmetries specified for the same block are combined into a single group.
+	 *
+	 * @throws ImportException if the specification refers to an unknown index space
+	 */
+	TensorSymmetryRegistry(const parser::TensorSymmetrySpecification &specification, const IndexSpaceManager &manager);
+
+	/**
+	 * Creates a registry from the given tensor symmetry file
+	 *
+	 * @throws ImportException if the file can't be parsed or refers to an unknown index space
+	 */
+	[[nodiscard]] static auto fromFile(const std::filesystem::path &filePath, const IndexSpaceManager &manager)
+		-> TensorSymmetryRegistry;
+
+	/**
+	 * @param tensorName The name of the tensor the block belongs to
+	 * @param creatorCount The number of creator slots of the block
+	 * @param slots The index spaces of the block's slots (creators first)
+	 * @returns The symmetry registered for the given block or nullptr, if there is none
+	 */
+	[[nodiscard]] auto find(std::string_view tensorName, std::size_t creatorCount,
+							const TensorBlock::IndexSlots &slots) const -> const BlockSymmetry *;
+
+	/**
+	 * Creates the element of the given tensor that is indexed by the given indices (creators first, annihilators
+	 * afterwards). If a symmetry is registered for the corresponding block, it is used for bringing the indices into
+	 * canonical order. Otherwise, the element won't have any symmetry.
+	 *
+	 * @returns A tuple containing the created element and the sign of the permutation that was applied to the indices
+	 * in order to bring them into canonical order
+	 */
+	[[nodiscard]] auto createElement(Tensor tensor, std::vector< Index > indices) const
+		-> std::tuple< TensorElement, int >;
+
+	/**
+	 * @returns The number of blocks that symmetries are registered for
+	 */
+	[[nodiscard]] auto size() const -> std::size_t;
+
+	/**
+	 * @returns Whether no symmetries are registered at all
+	 */
+	[[nodiscard]] auto empty() const -> bool;
+
+private:
+	struct Entry {
+		std::size_t creatorCount;
+		TensorBlock::IndexSlots slots;
+		BlockSymmetry symmetry;
+	};
+
+	std::map< std::string, std::vector< Entry >, std::less<> > m_entries;
+	std::size_t m_size = 0;
+};
+
+} // namespace lizard
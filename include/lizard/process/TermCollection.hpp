@@ -0,0 +1,27 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#pragma once
+
+#include "lizard/process/OptimizationStrategy.hpp"
+
+namespace lizard {
+
+/**
+ * Optimization strategy that collects terms within every expression that only differ in their numeric prefactor
+ * (e.g. 2 * A * B + 1/2 * B * A -> 5/2 * A * B). Terms are compared in a canonical form, so terms that only differ
+ * in the naming of their contracted indices are collected as well. Terms whose prefactors add up to zero are removed
+ * entirely.
+ */
+class TermCollection : public OptimizationStrategy {
+public:
+	TermCollection() = default;
+
+	[[nodiscard]] auto getName() const -> std::string final;
+
+	void process(std::vector< NamedTensorExprTree > &expressions, const IndexSpaceManager &manager) final;
+};
+
+} // namespace lizard
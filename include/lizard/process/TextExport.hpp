@@ -9,6 +9,8 @@
 
 namespace lizard {
 
+class MappedTensorExprTree;
+
 /**
  * An exporter that will write out the given expressions in an unspecified text format that is
  * meant to be read by humans but is not guaranteed to remain fixed or backwards compatible.
@@ -21,6 +23,11 @@ public:
 
 	void exportExpressions(nonstd::span< const NamedTensorExprTree > expressions,
 						   const IndexSpaceManager &manager) final;
+
+	/**
+	 * Writes out the given memory-mapped expressions in the same format, without materializing them first
+	 */
+	void exportExpressions(nonstd::span< const MappedTensorExprTree > expressions, const IndexSpaceManager &manager);
 };
 
 } // namespace lizard
@@ -57,6 +57,11 @@ public:
 	 */
 	[[nodiscard]] auto createFromLabel(char label) const -> IndexSpace;
 
+	/**
+	 * @returns All index spaces that have been registered with this manager (in order of registration)
+	 */
+	[[nodiscard]] auto getRegisteredSpaces() const -> std::vector< IndexSpace >;
+
 private:
 	struct Pair {
 		IndexSpace space;
@@ -13,6 +13,7 @@
 #include <cstdint>
 #include <functional>
 #include <iosfwd>
+#include <memory>
 #include <tuple>
 #include <vector>
 
@@ -82,9 +83,17 @@ public:
 	[[nodiscard]] auto getIndexSlots() const -> const IndexSlots &;
 
 private:
+	/**
+	 * The parts of a block that never change after its creation. They are shared between all copies of a block (and
+	 * thus between all elements of the block), which makes copying blocks cheap.
+	 */
+	struct Data {
+		SlotSymmetry symmetry;
+		IndexSlots slots;
+	};
+
 	Tensor m_tensor;
-	SlotSymmetry m_symmetry;
-	IndexSlots m_slots;
+	std::shared_ptr< const Data > m_data;
 };
 
 [[nodiscard]] auto operator==(const TensorBlock &lhs, const TensorBlock &rhs) -> bool;
@@ -49,6 +49,16 @@ public:
 	[[nodiscard]] auto static create(Tensor tensor, std::vector< Index > indices, TensorBlock::SlotSymmetry symmetry)
 		-> std::tuple< TensorElement, int >;
 
+	/**
+	 * Creates an element from indices that are known to be in canonical order already (e.g. because they stem from an
+	 * element that has been created before). Other than create, this skips the canonicalization of the indices, which
+	 * makes it a lot cheaper. Whether the indices are actually canonical is only checked in debug builds.
+	 *
+	 * @param block The TensorBlock that the created element should belong to
+	 * @param indices The canonically ordered indices of the element
+	 */
+	[[nodiscard]] auto static fromCanonical(TensorBlock block, std::vector< Index > indices) -> TensorElement;
+
 	/**
 	 * Constructs a "tensor" element that in reality is only a scalar
 	 */
@@ -78,5 +88,5 @@ auto operator<<(std::ostream &stream, const TensorElement &element) -> std::ostr
 } // namespace lizard
 
 template<> struct std::hash< lizard::TensorElement > {
-	[[nodiscard]] auto operator()(const lizard::TensorElement &element) -> std::size_t;
+	[[nodiscard]] auto operator()(const lizard::TensorElement &element) const -> std::size_t;
 };
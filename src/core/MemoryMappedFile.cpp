@@ -0,0 +1,141 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#include "lizard/core/MemoryMappedFile.hpp"
+#include "lizard/core/Exception.hpp"
+
+#include <system_error>
+#include <utility>
+
+#ifdef _WIN32
+#	ifndef NOMINMAX
+#		define NOMINMAX
+#	endif
+#	include <windows.h>
+#else
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#endif
+
+namespace lizard {
+
+MemoryMappedFile::MemoryMappedFile(const std::filesystem::path &path) {
+	std::error_code errorCode;
+	m_size = static_cast< std::size_t >(std::filesystem::file_size(path, errorCode));
+	if (errorCode) {
+		throw Exception("Can't determine size of '" + path.string() + "': " + errorCode.message());
+	}
+
+	if (m_size == 0) {
+		// Empty files can't be mapped, but there also is no need to do so
+		return;
+	}
+
+#ifdef _WIN32
+	m_fileHandle = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+							   FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (m_fileHandle == INVALID_HANDLE_VALUE) {
+		m_fileHandle = nullptr;
+		throw Exception("Can't open '" + path.string() + "' for reading");
+	}
+
+	m_mappingHandle = CreateFileMappingW(m_fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (m_mappingHandle == nullptr) {
+		unmap();
+		throw Exception("Can't create a memory mapping for '" + path.string() + "'");
+	}
+
+	m_data = static_cast< const std::byte * >(MapViewOfFile(m_mappingHandle, FILE_MAP_READ, 0, 0, 0));
+	if (m_data == nullptr) {
+		unmap();
+		throw Exception("Can't map '" + path.string() + "' into memory");
+	}
+#else
+	int fileDescriptor = open(path.c_str(), O_RDONLY); // NOLINT(*-vararg)
+	if (fileDescriptor < 0) {
+		throw Exception("Can't open '" + path.string() + "' for reading");
+	}
+
+	void *mapping = mmap(nullptr, m_size, PROT_READ, MAP_SHARED, fileDescriptor, 0);
+	// The mapping stays valid after the file descriptor has been closed
+	close(fileDescriptor);
+
+	if (mapping == MAP_FAILED) { // NOLINT(*-cstyle-cast)
+		m_size = 0;
+		throw Exception("Can't map '" + path.string() + "' into memory");
+	}
+
+	m_data = static_cast< const std::byte * >(mapping);
+#endif
+}
+
+MemoryMappedFile::MemoryMappedFile(MemoryMappedFile &&other) noexcept
+	: m_data(std::exchange(other.m_data, nullptr)), m_size(std::exchange(other.m_size, 0))
+#ifdef _WIN32
+	  ,
+	  m_fileHandle(std::exchange(other.m_fileHandle, nullptr)),
+	  m_mappingHandle(std::exchange(other.m_mappingHandle, nullptr))
+#endif
+{
+}
+
+MemoryMappedFile::~MemoryMappedFile() {
+	unmap();
+}
+
+auto MemoryMappedFile::operator=(MemoryMappedFile &&other) noexcept -> MemoryMappedFile & {
+	if (this != &other) {
+		unmap();
+
+		m_data = std::exchange(other.m_data, nullptr);
+		m_size = std::exchange(other.m_size, 0);
+#ifdef _WIN32
+		m_fileHandle    = std::exchange(other.m_fileHandle, nullptr);
+		m_mappingHandle = std::exchange(other.m_mappingHandle, nullptr);
+#endif
+	}
+
+	return *this;
+}
+
+auto MemoryMappedFile::data() const -> const std::byte * {
+	return m_data;
+}
+
+auto MemoryMappedFile::size() const -> std::size_t {
+	return m_size;
+}
+
+auto MemoryMappedFile::isMapped() const -> bool {
+	return m_data != nullptr;
+}
+
+void MemoryMappedFile::unmap() noexcept {
+#ifdef _WIN32
+	if (m_data != nullptr) {
+		UnmapViewOfFile(m_data);
+	}
+	if (m_mappingHandle != nullptr) {
+		CloseHandle(m_mappingHandle);
+	}
+	if (m_fileHandle != nullptr) {
+		CloseHandle(m_fileHandle);
+	}
+	m_fileHandle    = nullptr;
+	m_mappingHandle = nullptr;
+#else
+	if (m_data != nullptr) {
+		// NOLINTNEXTLINE(*-const-cast)
+		munmap(const_cast< std::byte * >(m_data), m_size);
+	}
+#endif
+
+	m_data = nullptr;
+	m_size = 0;
+}
+
+} // namespace lizard
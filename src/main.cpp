@@ -4,13 +4,25 @@
 // tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
 
 #include "lizard/format/FormatSupport.hpp"
+#include "lizard/parser/GeCCoExportParser.hpp"
+#include "lizard/process/BinaryExport.hpp"
+#include "lizard/process/BinaryImport.hpp"
+#include "lizard/process/CommonSubexpressionElimination.hpp"
+#include "lizard/process/DensityFitting.hpp"
+#include "lizard/process/ExpressionCache.hpp"
+#include "lizard/process/Factorization.hpp"
+#include "lizard/process/GeCCoImport.hpp"
 #include "lizard/process/HardcodedImport.hpp"
 #include "lizard/process/ITFExport.hpp"
+#include "lizard/process/ImportStrategy.hpp"
 #include "lizard/process/ProcessingException.hpp"
 #include "lizard/process/ProcessingStep.hpp"
 #include "lizard/process/Processor.hpp"
 #include "lizard/process/SkeletonQuantityMapper.hpp"
 #include "lizard/process/SpinIntegration.hpp"
+#include "lizard/process/Strategy.hpp"
+#include "lizard/process/StrengthReduction.hpp"
+#include "lizard/process/TermCollection.hpp"
 #include "lizard/process/TextExport.hpp"
 #include "lizard/symbolic/IndexSpace.hpp"
 #include "lizard/symbolic/IndexSpaceData.hpp"
@@ -21,14 +33,20 @@
 
 #include <fmt/chrono.h>
 #include <fmt/core.h>
+#include <fmt/format.h>
 
 #include <spdlog/sinks/stdout_color_sinks.h>
 #include <spdlog/spdlog.h>
 #include <spdlog/stopwatch.h>
 
-#include <cstdint>
+#include <cstddef>
 #include <exception>
+#include <filesystem>
+#include <map>
 #include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 
 using namespace lizard;
@@ -44,10 +62,189 @@ struct LogShutdown {
 	~LogShutdown() { spdlog::shutdown(); }
 };
 
+/**
+ * The sizes of the index spaces known to lizard. A size of zero for the active space means that there is no active
+ * space.
+ */
+struct IndexSpaceSizes {
+	unsigned int closed    = 10;
+	unsigned int external  = 100;
+	unsigned int auxiliary = 300;
+	unsigned int active    = 0;
+};
+
+/**
+ * The names of the processing steps that can be part of the pipeline. "print" logs the current expressions.
+ */
+const std::vector< std::string > rewriteStepNames = { "print",           "density-fitting",     "strength-reduction",
+													  "spin-integration", "skeleton-quantities", "term-collection",
+													  "factorization",    "cse" };
+
+const std::vector< std::string > defaultRewriteSteps = {
+	"print",
+	"density-fitting",
+	"strength-reduction",
+	"spin-integration",
+	"print",
+	// If restricted orbitals: Spin summation
+	"skeleton-quantities",
+	// Collect terms that only differ in their prefactor (e.g. originating from different spin cases)
+	"term-collection",
+	// Pull common factors out of sums, if that reduces the number of required operations
+	"factorization",
+	"print",
+	// Compute contractions that are shared between different terms only once
+	"cse",
+};
+
+auto createIndexSpaceManager(const IndexSpaceSizes &sizes) -> IndexSpaceManager {
+	IndexSpaceManager manager;
+
+	manager.registerSpace(IndexSpace{ 0, Spin::Both },
+						  IndexSpaceData{ "Closed", 'c', sizes.closed, Spin::Both, { 'i', 'j', 'k', 'l', 'm', 'n' } });
+	manager.registerSpace(
+		IndexSpace{ 1, Spin::Both },
+		IndexSpaceData{ "External", 'e', sizes.external, Spin::Both, { 'a', 'b', 'c', 'd', 'e', 'f' } });
+	manager.registerSpace(
+		IndexSpace{ 2, Spin::None },
+		IndexSpaceData{ "Auxiliary", 'x', sizes.auxiliary, Spin::None, { 'P', 'Q', 'R', 'S', 'T', 'U' } });
+
+	if (sizes.active > 0) {
+		manager.registerSpace(
+			IndexSpace{ 3, Spin::Both },
+			IndexSpaceData{ "Active", 'a', sizes.active, Spin::Both, { 't', 'u', 'v', 'w', 'x', 'y' } });
+	}
+
+	return manager;
+}
+
+auto createRewriteStep(const std::string &name) -> std::unique_ptr< Strategy > {
+	if (name == "print") {
+		return std::make_unique< TextExport >();
+	}
+	if (name == "density-fitting") {
+		return std::make_unique< DensityFitting >("Auxiliary");
+	}
+	if (name == "strength-reduction") {
+		return std::make_unique< StrengthReduction >();
+	}
+	if (name == "spin-integration") {
+		return std::make_unique< SpinIntegration >();
+	}
+	if (name == "skeleton-quantities") {
+		return std::make_unique< SkeletonQuantityMapper >();
+	}
+	if (name == "term-collection") {
+		return std::make_unique< TermCollection >();
+	}
+	if (name == "factorization") {
+		return std::make_unique< Factorization >();
+	}
+	if (name == "cse") {
+		return std::make_unique< CommonSubexpressionElimination >();
+	}
+
+	throw std::invalid_argument(fmt::format("Unknown processing step '{}'", name));
+}
+
 auto main(int argc, char **argv) -> int {
 	CLI::App app("A quantum chemistry application used for the symbolic derivation and manipulation of equations based "
 				 "on second quantization.");
 	app.set_version_flag("--version", std::string(LIZARD_VERSION_STR));
+	app.set_config("--config", "",
+				   "Read the pipeline configuration from the given TOML or INI file. Options given on the command line "
+				   "take precedence.");
+
+	std::string cacheDir;
+	app.add_option("--cache", cacheDir,
+				   "Directory in which the results of the individual processing steps shall be cached. Steps whose "
+				   "result is already cached will be skipped.");
+
+	std::size_t threadCount = 0;
+	app.add_option("--threads", threadCount,
+				   "The number of threads to use for parallelized steps. Zero means one thread per hardware thread.")
+		->capture_default_str();
+
+	IndexSpaceSizes sizes;
+	app.add_option("--closed-size", sizes.closed, "The size of the closed (occupied) index space")
+		->capture_default_str()
+		->group("Index spaces");
+	app.add_option("--external-size", sizes.external, "The size of the external (virtual) index space")
+		->capture_default_str()
+		->group("Index spaces");
+	app.add_option("--auxiliary-size", sizes.auxiliary, "The size of the auxiliary (density fitting) index space")
+		->capture_default_str()
+		->group("Index spaces");
+	app.add_option("--active-size", sizes.active, "The size of the active index space (0 for no active space)")
+		->capture_default_str()
+		->group("Index spaces");
+
+	std::vector< std::string > rewriteSteps = defaultRewriteSteps;
+	app.add_option("--steps", rewriteSteps,
+				   "The processing steps to apply to the imported expressions (in the given order). 'print' logs the "
+				   "current expressions.")
+		->check(CLI::IsMember(rewriteStepNames))
+		->delimiter(',')
+		->capture_default_str()
+		->group("Pipeline");
+
+	std::vector< std::string > exporters = { "itf" };
+	app.add_option("--export", exporters, "The formats to export the processed expressions to")
+		->check(CLI::IsMember({ "text", "itf", "binary" }))
+		->delimiter(',')
+		->capture_default_str()
+		->group("Pipeline");
+
+	std::filesystem::path itfFile = "lizard.itf";
+	app.add_option("--itf-file", itfFile, "The file to write the ITF export to")
+		->capture_default_str()
+		->group("Pipeline");
+
+	std::filesystem::path binaryFile = "lizard.lzb";
+	app.add_option("--binary-file", binaryFile, "The file to write the binary export to")
+		->capture_default_str()
+		->group("Pipeline");
+
+	// Importers (if none is selected, the hardcoded CCD energy is used)
+	app.require_subcommand(0, 1);
+
+	HardcodedImport::ImportTarget hardcodedTarget = HardcodedImport::CCD_ENERGY;
+	CLI::App *hardcodedCommand                    = app.add_subcommand("hardcoded", "Import a hardcoded expression");
+	hardcodedCommand->add_option("target", hardcodedTarget, "The expression to import")
+		->transform(CLI::CheckedTransformer(
+			std::map< std::string, HardcodedImport::ImportTarget >{ { "ccd-energy", HardcodedImport::CCD_ENERGY } },
+			CLI::ignore_case));
+
+	std::filesystem::path geccoFile;
+	std::vector< std::string > geccoSpaces = { "Closed", "External", "Active" };
+	parser::GeCCoExportParser::Backend geccoBackend = parser::GeCCoExportParser::Backend::ANTLR;
+	std::filesystem::path symmetryFile;
+	CLI::App *geccoCommand = app.add_subcommand("gecco", "Import the contractions of a GeCCo export file");
+	geccoCommand->add_option("file", geccoFile, "The GeCCo export file")->required()->check(CLI::ExistingFile);
+	geccoCommand
+		->add_option("--spaces", geccoSpaces,
+					 "The index spaces that GeCCo's index spaces (in order of GeCCo's space numbering) map to")
+		->delimiter(',')
+		->capture_default_str();
+	geccoCommand->add_option("--backend", geccoBackend, "The parser implementation to use")
+		->transform(CLI::CheckedTransformer(
+			std::map< std::string, parser::GeCCoExportParser::Backend >{
+				{ "antlr", parser::GeCCoExportParser::Backend::ANTLR },
+				{ "fast", parser::GeCCoExportParser::Backend::Fast } },
+			CLI::ignore_case));
+	geccoCommand->add_option("--symmetries", symmetryFile, "A file defining the slot symmetries of the tensors")
+		->check(CLI::ExistingFile);
+
+	std::filesystem::path binaryInputFile;
+	std::vector< std::string > selectedResults;
+	CLI::App *binaryCommand = app.add_subcommand("binary", "Import the expressions of a file written by lizard");
+	binaryCommand->add_option("file", binaryInputFile, "The binary expression file")
+		->required()
+		->check(CLI::ExistingFile);
+	binaryCommand
+		->add_option("--results", selectedResults,
+					 "Only import the expressions for the given result tensors (default: import all expressions)")
+		->delimiter(',');
 
 	CLI11_PARSE(app, argc, argv);
 
@@ -60,43 +257,44 @@ auto main(int argc, char **argv) -> int {
 		spdlog::stopwatch stopwatch;
 		logger->info("This is lizard v{}", LIZARD_VERSION_STR);
 
+		Processor processor(createIndexSpaceManager(sizes), logger);
 
-		IndexSpaceManager spaceManager;
-		constexpr std::size_t occSize  = 10;
-		constexpr std::size_t virtSize = 100;
-		spaceManager.registerSpace(
-			IndexSpace{ 0, Spin::Both },
-			IndexSpaceData{ "Closed", 'c', occSize, Spin::Both, { 'i', 'j', 'k', 'l', 'm', 'n' } });
-		spaceManager.registerSpace(
-			IndexSpace{ 1, Spin::Both },
-			IndexSpaceData{ "External", 'e', virtSize, Spin::Both, { 'a', 'b', 'c', 'd', 'e', 'f' } });
-
-		Processor processor(std::move(spaceManager), logger);
+		if (!cacheDir.empty()) {
+			processor.setCache(ExpressionCache(cacheDir));
+		}
 
 
 		// Import diagrams
 		// & Translate diagrams into algebraic expressions
-		processor.enqueue(ProcessingStep{ std::make_unique< HardcodedImport >(HardcodedImport::CCD_ENERGY) });
-
-		processor.enqueue(ProcessingStep{ std::make_unique< TextExport >() });
-
-		// Perform substitutions (e.g. density-fitting)
-
-		// Perform term optimization(s)
-		// -> At least: strength-reduction
-
-		// Spin-integration
-		processor.enqueue(ProcessingStep{ std::make_unique< SpinIntegration >() });
+		std::unique_ptr< ImportStrategy > importer;
+		if (geccoCommand->parsed()) {
+			auto geccoImport = std::make_unique< GeCCoImport >(geccoFile, geccoSpaces, threadCount, geccoBackend);
+			geccoImport->setSymmetryFile(symmetryFile);
 
-		processor.enqueue(ProcessingStep{ std::make_unique< TextExport >() });
+			importer = std::move(geccoImport);
+		} else if (binaryCommand->parsed()) {
+			importer = std::make_unique< BinaryImport >(binaryInputFile, selectedResults);
+		} else {
+			importer = std::make_unique< HardcodedImport >(hardcodedTarget);
+		}
 
-		// If restricted orbitals: Spin summation
-		processor.enqueue(ProcessingStep{ std::make_unique< SkeletonQuantityMapper >() });
+		processor.enqueue(ProcessingStep{ std::move(importer) });
 
-		processor.enqueue(ProcessingStep{ std::make_unique< TextExport >() });
+		// Perform substitutions, term optimization(s) and the like
+		for (const std::string &currentStep : rewriteSteps) {
+			processor.enqueue(ProcessingStep{ createRewriteStep(currentStep) });
+		}
 
 		// Export terms
-		processor.enqueue(ProcessingStep{ std::make_unique< ITFExport >() });
+		for (const std::string &currentExporter : exporters) {
+			if (currentExporter == "text") {
+				processor.enqueue(ProcessingStep{ std::make_unique< TextExport >() });
+			} else if (currentExporter == "itf") {
+				processor.enqueue(ProcessingStep{ std::make_unique< ITFExport >(itfFile, threadCount) });
+			} else if (currentExporter == "binary") {
+				processor.enqueue(ProcessingStep{ std::make_unique< BinaryExport >(binaryFile) });
+			}
+		}
 
 		processor.run();
 
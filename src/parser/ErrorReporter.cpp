@@ -17,6 +17,14 @@ void ErrorReporter::syntaxError(antlr4::Recognizer *recognizer, antlr4::Token *o
 	(void) offendingSymbol;
 	(void) exception;
 
+	reportError(line, column, msg);
+}
+
+void ErrorReporter::setLineOffset(std::size_t offset) {
+	m_lineOffset = offset;
+}
+
+void ErrorReporter::reportError(std::size_t line, std::size_t column, const std::string &msg) const {
 	std::string errorMessage;
 	if (!m_fileName.empty()) {
 		errorMessage = m_fileName + ":";
@@ -24,7 +32,7 @@ void ErrorReporter::syntaxError(antlr4::Recognizer *recognizer, antlr4::Token *o
 		errorMessage = "line ";
 	}
 
-	errorMessage += std::to_string(line) + ":" + std::to_string(column) + ": " + msg;
+	errorMessage += std::to_string(line + m_lineOffset) + ":" + std::to_string(column) + ": " + msg;
 
 	throw ParseException(errorMessage);
 }
@@ -33,8 +33,20 @@ public:
 	void syntaxError(antlr4::Recognizer *recognizer, antlr4::Token *offendingSymbol, std::size_t line,
 					 std::size_t column, const std::string &msg, std::exception_ptr exception) override;
 
+	/**
+	 * Sets the offset that is added to all reported line numbers. This is needed when parsing only an excerpt of the
+	 * input file.
+	 */
+	void setLineOffset(std::size_t offset);
+
+	/**
+	 * Throws a ParseException for an error at the given location (the line offset is applied to the given line)
+	 */
+	[[noreturn]] void reportError(std::size_t line, std::size_t column, const std::string &msg) const;
+
 private:
 	std::string m_fileName;
+	std::size_t m_lineOffset = 0;
 };
 
 } // namespace lizard::parser
@@ -0,0 +1,725 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#include "GeCCoExportFastParser.hpp"
+#include "ErrorReporter.hpp"
+
+#include "lizard/parser/GeCCoContraction.hpp"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace lizard::parser {
+
+/**
+ * The token types of the GeCCoExport grammar
+ */
+enum class GeCCoTokenType : std::uint8_t {
+	Int,
+	Double,
+	ID,
+	Comma,
+	Semicolon,
+	OpeningBracket,
+	ClosingBracket,
+	NL,
+	ContractionTag,
+	EndTag,
+	ResultTag,
+	FactorTag,
+	VertexCountTag,
+	SuperVertexTag,
+	ArcCountTag,
+	VerticesTag,
+	ArcsTag,
+	ExternalArcsTag,
+	ContractionStringTag,
+	ResultStringTag,
+	EndOfInput,
+};
+
+/**
+ * The fixed tokens introduced by a '/' (all of them are terminated by another '/')
+ */
+constexpr const std::array< std::pair< std::string_view, GeCCoTokenType >, 10 > SlashTags = { {
+	{ "/RESULT/", GeCCoTokenType::ResultTag },
+	{ "/FACTOR/", GeCCoTokenType::FactorTag },
+	{ "/#VERTICES/", GeCCoTokenType::VertexCountTag },
+	{ "/SVERTEX/", GeCCoTokenType::SuperVertexTag },
+	{ "/#ARCS/", GeCCoTokenType::ArcCountTag },
+	{ "/VERTICES/", GeCCoTokenType::VerticesTag },
+	{ "/ARCS/", GeCCoTokenType::ArcsTag },
+	{ "/XARCS/", GeCCoTokenType::ExternalArcsTag },
+	{ "/CONTR_STRING/", GeCCoTokenType::ContractionStringTag },
+	{ "/RESULT_STRING/", GeCCoTokenType::ResultStringTag },
+} };
+
+constexpr const std::string_view ContractionTagText = "[CONTR] #";
+constexpr const std::string_view EndTagText         = "[END]";
+
+/**
+ * @returns The name of the given token type as used in error messages (following ANTLR's naming)
+ */
+auto toString(GeCCoTokenType type) -> std::string_view {
+	switch (type) {
+		case GeCCoTokenType::Int:
+			return "INT";
+		case GeCCoTokenType::Double:
+			return "DOUBLE";
+		case GeCCoTokenType::ID:
+			return "ID";
+		case GeCCoTokenType::Comma:
+			return "','";
+		case GeCCoTokenType::Semicolon:
+			return "';'";
+		case GeCCoTokenType::OpeningBracket:
+			return "'['";
+		case GeCCoTokenType::ClosingBracket:
+			return "']'";
+		case GeCCoTokenType::NL:
+			return "NL";
+		case GeCCoTokenType::ContractionTag:
+			return "'[CONTR] #'";
+		case GeCCoTokenType::EndTag:
+			return "'[END]'";
+		case GeCCoTokenType::EndOfInput:
+			return "<EOF>";
+		default:
+			break;
+	}
+
+	for (const std::pair< std::string_view, GeCCoTokenType > &current : SlashTags) {
+		if (current.second == type) {
+			return current.first;
+		}
+	}
+
+	return "<unknown>";
+}
+
+enum CharacterClass : std::uint8_t {
+	DigitChar      = 1U << 0U,
+	IDChar         = 1U << 1U,
+	WhitespaceChar = 1U << 2U,
+};
+
+/**
+ * Lookup table of the CharacterClass flags of every character. This allows classifying characters without having to
+ * go through a series of comparisons.
+ */
+constexpr auto createCharacterClasses() -> std::array< std::uint8_t, 256 > {
+	std::array< std::uint8_t, 256 > classes = {};
+
+	for (char c = '0'; c <= '9'; ++c) {
+		classes[static_cast< unsigned char >(c)] = DigitChar | IDChar;
+	}
+	for (char c = 'a'; c <= 'z'; ++c) {
+		classes[static_cast< unsigned char >(c)] = IDChar;
+	}
+	for (char c = 'A'; c <= 'Z'; ++c) {
+		classes[static_cast< unsigned char >(c)] = IDChar;
+	}
+	classes[static_cast< unsigned char >('_')]  = IDChar;
+	classes[static_cast< unsigned char >(' ')]  = WhitespaceChar;
+	classes[static_cast< unsigned char >('\t')] = WhitespaceChar;
+	classes[static_cast< unsigned char >('\r')] = WhitespaceChar;
+
+	return classes;
+}
+
+constexpr const std::array< std::uint8_t, 256 > CharacterClasses = createCharacterClasses();
+
+/**
+ * A token only refers to its text within the input. Its line and column are determined on demand (see
+ * FastGeCCoLexer::reportError), which keeps the token small and cheap to pass around.
+ */
+struct GeCCoToken {
+	GeCCoTokenType type = GeCCoTokenType::EndOfInput;
+	std::string_view text;
+};
+
+/**
+ * Lexer producing the same tokens as the one generated from the GeCCoExport grammar
+ */
+class FastGeCCoLexer {
+public:
+	FastGeCCoLexer(std::string_view input, const ErrorReporter &reporter) : m_input(input), m_reporter(&reporter) {}
+
+	/**
+	 * Reports an error at the beginning of the given text, which has to be part of this lexer's input
+	 */
+	[[noreturn]] void reportError(std::string_view text, const std::string &message) const {
+		const std::string_view preceding = m_input.substr(0, static_cast< std::size_t >(text.data() - m_input.data()));
+		const std::size_t lineStart      = preceding.rfind('\n');
+
+		m_reporter->reportError(static_cast< std::size_t >(std::count(preceding.begin(), preceding.end(), '\n')) + 1,
+								lineStart == std::string_view::npos ? preceding.size()
+																	: preceding.size() - lineStart - 1,
+								message);
+	}
+
+	/**
+	 * @returns The type of the next token without consuming it
+	 */
+	[[nodiscard]] auto peek() const -> GeCCoTokenType {
+		FastGeCCoLexer copy = *this;
+		return copy.next().type;
+	}
+
+	/**
+	 * Fast path for the long rows of integers in export files: if the next token is a short, unsigned INT, it is
+	 * consumed and its value is written to the given variable without creating a token for it.
+	 *
+	 * @returns Whether such an integer has been consumed
+	 */
+	template< typename T > auto nextUnsigned(T &value) -> bool {
+		std::size_t pos = m_pos;
+		while (pos < m_input.size() && m_input[pos] == ' ') {
+			pos++;
+		}
+
+		const std::size_t digitStart = pos;
+		T result                     = 0;
+		while (pos < m_input.size() && is(m_input[pos], DigitChar)) {
+			result = static_cast< T >(result * 10 + (m_input[pos] - '0'));
+			pos++;
+		}
+
+		// Anything else (including numbers that are continued as a DOUBLE or ID) has to go through next()
+		if (pos == digitStart || pos - digitStart > static_cast< std::size_t >(std::numeric_limits< T >::digits10)
+			|| (pos < m_input.size() && (is(m_input[pos], IDChar) || m_input[pos] == '.'))) {
+			return false;
+		}
+
+		m_pos = pos;
+		value = result;
+
+		return true;
+	}
+
+	auto next() -> GeCCoToken {
+		while (m_pos < m_input.size() && is(m_input[m_pos], WhitespaceChar)) {
+			m_pos++;
+		}
+
+		GeCCoToken token;
+
+		if (m_pos >= m_input.size()) {
+			// An empty text at the end of the input, such that errors are reported at the correct position
+			token.text = m_input.substr(m_input.size());
+			return token;
+		}
+
+		const std::size_t start = m_pos;
+		const char current      = m_input[m_pos];
+
+		switch (current) {
+			case '\n':
+				token.type = GeCCoTokenType::NL;
+				m_pos++;
+				break;
+			case ',':
+				token.type = GeCCoTokenType::Comma;
+				m_pos++;
+				break;
+			case ';':
+				token.type = GeCCoTokenType::Semicolon;
+				m_pos++;
+				break;
+			case ']':
+				token.type = GeCCoTokenType::ClosingBracket;
+				m_pos++;
+				break;
+			case '[':
+				if (startsWith(ContractionTagText)) {
+					token.type = GeCCoTokenType::ContractionTag;
+					m_pos += ContractionTagText.size();
+				} else if (startsWith(EndTagText)) {
+					token.type = GeCCoTokenType::EndTag;
+					m_pos += EndTagText.size();
+				} else {
+					token.type = GeCCoTokenType::OpeningBracket;
+					m_pos++;
+				}
+				break;
+			case '/':
+				token.type = lexSlashTag();
+				break;
+			default:
+				token.type = lexWord();
+				break;
+		}
+
+		token.text = std::string_view(m_input.data() + start, m_pos - start);
+
+		return token;
+	}
+
+private:
+	std::string_view m_input;
+	const ErrorReporter *m_reporter;
+	std::size_t m_pos = 0;
+
+	[[nodiscard]] static auto is(char c, CharacterClass characterClass) -> bool {
+		return (CharacterClasses[static_cast< unsigned char >(c)] & characterClass) != 0;
+	}
+
+	[[nodiscard]] auto isAt(std::size_t pos, CharacterClass characterClass) const -> bool {
+		return pos < m_input.size() && is(m_input[pos], characterClass);
+	}
+
+	[[nodiscard]] auto startsWith(std::string_view text) const -> bool {
+		return m_input.compare(m_pos, text.size(), text) == 0;
+	}
+
+	auto lexSlashTag() -> GeCCoTokenType {
+		// None of the tags contains a '/' other than its delimiters, so the only candidate is the text up to the next
+		// one. Comparing it as a whole rejects most tags by their length alone.
+		const std::size_t end = m_input.find('/', m_pos + 1);
+
+		if (end != std::string_view::npos) {
+			const std::string_view candidate = m_input.substr(m_pos, end + 1 - m_pos);
+
+			for (const std::pair< std::string_view, GeCCoTokenType > &current : SlashTags) {
+				if (candidate == current.first) {
+					m_pos += current.first.size();
+					return current.second;
+				}
+			}
+		}
+
+		reportUnrecognized();
+	}
+
+	/**
+	 * Lexes an INT, DOUBLE or ID token. As in ANTLR, the longest match wins and INT takes precedence over ID if both
+	 * match the same text.
+	 */
+	auto lexWord() -> GeCCoTokenType {
+		std::size_t end = m_pos;
+
+		if (m_input[end] == '+' || m_input[end] == '-') {
+			end++;
+		}
+
+		const std::size_t digitStart = end;
+		while (isAt(end, DigitChar)) {
+			end++;
+		}
+
+		// DOUBLE: ('+'|'-')? DIGIT* '.' DIGIT+
+		if (end < m_input.size() && m_input[end] == '.' && isAt(end + 1, DigitChar)) {
+			end += 2;
+			while (isAt(end, DigitChar)) {
+				end++;
+			}
+
+			m_pos = end;
+			return GeCCoTokenType::Double;
+		}
+
+		// Only numbers can have a sign
+		if (digitStart == m_pos && isAt(end, IDChar)) {
+			while (isAt(end, IDChar)) {
+				end++;
+			}
+
+			m_pos = end;
+			return GeCCoTokenType::ID;
+		}
+
+		if (end == digitStart) {
+			reportUnrecognized();
+		}
+
+		m_pos = end;
+		return GeCCoTokenType::Int;
+	}
+
+	[[noreturn]] void reportUnrecognized() const {
+		reportError(m_input.substr(m_pos), "token recognition error at: '" + std::string(1, m_input[m_pos]) + "'");
+	}
+};
+
+/**
+ * Storage that is reused for all contractions parsed on the same thread. Elements that are removed from the
+ * contraction's vectors are parked in the spare pools instead of being destroyed, so that their buffers can be reused
+ * as well. Once everything has grown large enough, parsing a contraction doesn't allocate any memory.
+ */
+struct ContractionBuffers {
+	GeCCoContraction contraction;
+	std::vector< GeCCoTensor > spareTensors;
+	std::vector< GeCCoArc > spareArcs;
+};
+
+thread_local ContractionBuffers threadBuffers;
+
+/**
+ * Moves all elements of the given vector into the given pool of spare elements
+ */
+template< typename T > void recycle(std::vector< T > &elements, std::vector< T > &spares) {
+	for (T &current : elements) {
+		spares.push_back(std::move(current));
+	}
+
+	elements.clear();
+}
+
+/**
+ * Appends a cleared element to the given vector, reusing one of the given spare elements if there is any
+ */
+template< typename T > auto appendReused(std::vector< T > &elements, std::vector< T > &spares) -> T & {
+	if (spares.empty()) {
+		return elements.emplace_back();
+	}
+
+	T &element = elements.emplace_back(std::move(spares.back()));
+	spares.pop_back();
+	element.clear();
+
+	return element;
+}
+
+/**
+ * Recursive descent parser for the contraction_block rule of the GeCCoExport grammar
+ */
+class FastGeCCoParser {
+public:
+	FastGeCCoParser(std::string_view input, const ErrorReporter &reporter, ContractionBuffers &buffers)
+		: m_lexer(input, reporter), m_buffers(&buffers) {
+		m_current = m_lexer.next();
+	}
+
+	/**
+	 * Parses a sequence of contraction_block rules, i.e. contraction blocks separated by (optional) blank lines
+	 */
+	void parseContractionBlocks(const GeCCoExportParser::ContractionCallback &callback) {
+		while (m_current.type != GeCCoTokenType::EndOfInput) {
+			if (m_current.type != GeCCoTokenType::ContractionTag) {
+				reportMismatch("{'[CONTR] #', <EOF>}");
+			}
+
+			parseContraction(m_buffers->contraction);
+			callback(m_buffers->contraction);
+
+			while (m_current.type == GeCCoTokenType::NL) {
+				advance();
+			}
+		}
+	}
+
+private:
+	FastGeCCoLexer m_lexer;
+	ContractionBuffers *m_buffers;
+	GeCCoToken m_current;
+
+	void advance() { m_current = m_lexer.next(); }
+
+	/**
+	 * @returns Whether the current token is of the first given type and the one following it is of the second type
+	 */
+	[[nodiscard]] auto lookingAt(GeCCoTokenType current, GeCCoTokenType next) const -> bool {
+		return m_current.type == current && m_lexer.peek() == next;
+	}
+
+	auto expect(GeCCoTokenType type) -> GeCCoToken {
+		if (m_current.type != type) {
+			reportMismatch(toString(type));
+		}
+
+		GeCCoToken token = m_current;
+		advance();
+
+		return token;
+	}
+
+	[[noreturn]] void reportMismatch(std::string_view expected) const {
+		std::string text;
+		switch (m_current.type) {
+			case GeCCoTokenType::NL:
+				text = "\\n";
+				break;
+			case GeCCoTokenType::EndOfInput:
+				text = "<EOF>";
+				break;
+			default:
+				text = m_current.text;
+				break;
+		}
+
+		m_lexer.reportError(m_current.text, "mismatched input '" + text + "' expecting " + std::string(expected));
+	}
+
+	template< typename T > auto toNumber(const GeCCoToken &token) const -> T {
+		std::string_view text = token.text;
+		if (!text.empty() && text.front() == '+') {
+			text.remove_prefix(1);
+		}
+
+		if constexpr (std::is_integral_v< T >) {
+			// Export files mostly consist of short, non-negative integers. These can't overflow and converting them by
+			// hand is considerably cheaper than going through std::from_chars.
+			if (!text.empty() && text.size() <= std::numeric_limits< T >::digits10 && text.front() != '-') {
+				T value = 0;
+				for (const char current : text) {
+					value = static_cast< T >(value * 10 + (current - '0'));
+				}
+
+				return value;
+			}
+		}
+
+		T value                             = {};
+		const std::from_chars_result result = std::from_chars(text.data(), text.data() + text.size(), value);
+
+		if (result.ec != std::errc() || result.ptr != text.data() + text.size()) {
+			m_lexer.reportError(token.text, "invalid number '" + std::string(token.text) + "'");
+		}
+
+		return value;
+	}
+
+	auto parseInt() -> int { return toNumber< int >(expect(GeCCoTokenType::Int)); }
+
+	auto parseSize() -> std::size_t { return toNumber< std::size_t >(expect(GeCCoTokenType::Int)); }
+
+	auto parseDouble() -> double { return toNumber< double >(expect(GeCCoTokenType::Double)); }
+
+	/**
+	 * Parses a (non-empty) sequence of INT tokens
+	 */
+	void parseInts(std::vector< int > &values) {
+		if (m_current.type != GeCCoTokenType::Int) {
+			reportMismatch(toString(GeCCoTokenType::Int));
+		}
+
+		parseRemainingInts(values);
+	}
+
+	/**
+	 * Parses a (potentially empty) sequence of INT tokens
+	 */
+	void parseRemainingInts(std::vector< int > &values) {
+		while (m_current.type == GeCCoTokenType::Int) {
+			values.push_back(toNumber< int >(m_current));
+
+			int value = 0;
+			while (m_lexer.nextUnsigned(value)) {
+				values.push_back(value);
+			}
+
+			advance();
+		}
+	}
+
+	/**
+	 * Parses a (potentially empty) sequence of INT tokens followed by NL
+	 */
+	void parseOptionalInts(std::vector< int > &values) {
+		parseRemainingInts(values);
+
+		expect(GeCCoTokenType::NL);
+	}
+
+	void parseContraction(GeCCoContraction &contraction) {
+		recycle(contraction.vertices, m_buffers->spareTensors);
+		recycle(contraction.arcs, m_buffers->spareArcs);
+		recycle(contraction.externalArcs, m_buffers->spareArcs);
+		contraction.clear();
+
+		// contr_num
+		expect(GeCCoTokenType::ContractionTag);
+		contraction.index = parseSize();
+		expect(GeCCoTokenType::NL);
+
+		// result
+		expect(GeCCoTokenType::ResultTag);
+		expect(GeCCoTokenType::NL);
+		parseTensor(contraction.result);
+		expect(GeCCoTokenType::NL);
+
+		// factor
+		expect(GeCCoTokenType::FactorTag);
+		contraction.externalFactor    = parseDouble();
+		contraction.sign              = parseInt();
+		contraction.contractionFactor = parseDouble();
+		expect(GeCCoTokenType::NL);
+
+		// num_vertices
+		expect(GeCCoTokenType::VertexCountTag);
+		contraction.vertexCount   = parseSize();
+		contraction.operatorCount = parseSize();
+		expect(GeCCoTokenType::NL);
+
+		// super_vertex
+		expect(GeCCoTokenType::SuperVertexTag);
+		contraction.superVertex.reserve(contraction.vertexCount);
+		parseInts(contraction.superVertex);
+		expect(GeCCoTokenType::NL);
+
+		// num_arcs
+		expect(GeCCoTokenType::ArcCountTag);
+		contraction.arcCount         = parseSize();
+		contraction.externalArcCount = parseSize();
+		expect(GeCCoTokenType::NL);
+
+		// vertices
+		expect(GeCCoTokenType::VerticesTag);
+		contraction.vertices.reserve(contraction.vertexCount);
+		do {
+			expect(GeCCoTokenType::NL);
+			parseTensor(appendReused(contraction.vertices, m_buffers->spareTensors));
+		} while (lookingAt(GeCCoTokenType::NL, GeCCoTokenType::ID));
+		expect(GeCCoTokenType::NL);
+
+		// arcs
+		expect(GeCCoTokenType::ArcsTag);
+		contraction.arcs.reserve(contraction.arcCount);
+		parseArcs(contraction.arcs);
+		expect(GeCCoTokenType::NL);
+
+		// external_arcs
+		expect(GeCCoTokenType::ExternalArcsTag);
+		contraction.externalArcs.reserve(contraction.externalArcCount);
+		parseArcs(contraction.externalArcs);
+		expect(GeCCoTokenType::NL);
+
+		parseContractionString(contraction.contractionString);
+		expect(GeCCoTokenType::NL);
+
+		parseResultString(contraction.resultString);
+		if (m_current.type == GeCCoTokenType::NL) {
+			advance();
+		}
+	}
+
+	void parseTensor(GeCCoTensor &tensor) {
+		tensor.name       = expect(GeCCoTokenType::ID).text;
+		tensor.transposed = expect(GeCCoTokenType::ID).text == "T";
+		parseIndexSpec(tensor.indices);
+	}
+
+	void parseIndexSpec(std::vector< GeCCoIndexBlock > &blocks) {
+		expect(GeCCoTokenType::OpeningBracket);
+
+		while (true) {
+			GeCCoIndexBlock &block = blocks.emplace_back();
+
+			if (m_current.type == GeCCoTokenType::ID) {
+				block.creators = m_current.text;
+				advance();
+			}
+
+			expect(GeCCoTokenType::Comma);
+
+			if (m_current.type == GeCCoTokenType::ID) {
+				block.annihilators = m_current.text;
+				advance();
+			}
+
+			if (m_current.type != GeCCoTokenType::Semicolon) {
+				break;
+			}
+
+			advance();
+		}
+
+		expect(GeCCoTokenType::ClosingBracket);
+	}
+
+	void parseArcs(std::vector< GeCCoArc > &arcs) {
+		while (lookingAt(GeCCoTokenType::NL, GeCCoTokenType::Int)) {
+			advance();
+
+			GeCCoArc &arc = appendReused(arcs, m_buffers->spareArcs);
+			arc.from      = parseInt();
+			arc.to        = parseInt();
+			parseIndexSpec(arc.indices);
+		}
+	}
+
+	void parseContractionString(GeCCoIndexString &string) {
+		expect(GeCCoTokenType::ContractionStringTag);
+		expect(GeCCoTokenType::NL);
+
+		if (m_current.type == GeCCoTokenType::NL) {
+			// Empty contraction string
+			for (std::size_t i = 0; i < 5; ++i) {
+				expect(GeCCoTokenType::NL);
+			}
+
+			return;
+		}
+
+		if (m_current.type != GeCCoTokenType::Int) {
+			reportMismatch("{NL, INT}");
+		}
+
+		parseInts(string.vertices);
+		expect(GeCCoTokenType::NL);
+
+		// All rows of the string have the same length
+		const std::size_t length = string.vertices.size();
+		string.types.reserve(length);
+		string.spaces.reserve(length);
+		string.resultFlags.reserve(length);
+		string.arcs.reserve(length);
+		string.ids.reserve(length);
+
+		parseInts(string.types);
+		expect(GeCCoTokenType::NL);
+		parseInts(string.spaces);
+		expect(GeCCoTokenType::NL);
+
+		do {
+			string.resultFlags.push_back(expect(GeCCoTokenType::ID).text == "T");
+		} while (m_current.type == GeCCoTokenType::ID);
+		expect(GeCCoTokenType::NL);
+
+		parseInts(string.arcs);
+		expect(GeCCoTokenType::NL);
+		parseInts(string.ids);
+	}
+
+	void parseResultString(GeCCoIndexString &string) {
+		expect(GeCCoTokenType::ResultStringTag);
+		expect(GeCCoTokenType::NL);
+
+		parseOptionalInts(string.vertices);
+
+		const std::size_t length = string.vertices.size();
+		string.types.reserve(length);
+		string.spaces.reserve(length);
+		string.arcs.reserve(length);
+		string.ids.reserve(length);
+
+		parseOptionalInts(string.types);
+		parseOptionalInts(string.spaces);
+		parseOptionalInts(string.arcs);
+		parseOptionalInts(string.ids);
+	}
+};
+
+void parseContractionsFast(std::string_view input, const ErrorReporter &reporter,
+						   const GeCCoExportParser::ContractionCallback &callback) {
+	// The buffers are taken out of the thread's storage for the duration of this call, which keeps a callback that
+	// parses another input on the same thread from overwriting the contraction it has been handed
+	ContractionBuffers buffers = std::move(threadBuffers);
+
+	FastGeCCoParser parser(input, reporter, buffers);
+	parser.parseContractionBlocks(callback);
+
+	threadBuffers = std::move(buffers);
+}
+
+} // namespace lizard::parser
@@ -0,0 +1,29 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#pragma once
+
+#include "lizard/parser/GeCCoExportParser.hpp"
+
+#include <string_view>
+
+namespace lizard::parser {
+
+class ErrorReporter;
+
+/**
+ * Parses a sequence of contraction blocks (each corresponding to the contraction_block rule of the GeCCoExport
+ * grammar) with a hand-written lexer and recursive descent parser instead of the ANTLR runtime. As the input is parsed
+ * in a single pass, it doesn't have to be split into the individual blocks beforehand. Syntax errors are reported via
+ * the given ErrorReporter.
+ *
+ * @param input The text of the contraction blocks
+ * @param reporter The ErrorReporter to use, with its line offset set up to match the input's position in the file
+ * @param callback The callback to pass the parsed contractions to (in order of appearance)
+ */
+void parseContractionsFast(std::string_view input, const ErrorReporter &reporter,
+						   const GeCCoExportParser::ContractionCallback &callback);
+
+} // namespace lizard::parser
@@ -9,50 +9,314 @@
 #include "lizard/parser/autogen/GeCCoExportParser.h"
 
 #include "ErrorReporter.hpp"
+#include "GeCCoExportFastParser.hpp"
+#include "GeCCoExportProcessor.hpp"
 
+#include <algorithm>
 #include <exception>
 #include <filesystem>
 #include <fstream>
-#include <iostream>
 #include <string>
+#include <string_view>
+#include <vector>
 
 #include <ANTLRInputStream.h>
 #include <CommonTokenStream.h>
 #include <Exceptions.h>
 #include <tree/ParseTree.h>
+#include <tree/ParseTreeWalker.h>
 
 
 namespace lizard::parser {
 
+constexpr const std::string_view ContractionMarker = "[CONTR]";
+constexpr const std::string_view EndMarker         = "[END]";
+
+auto startsWithMarker(std::string_view line, std::string_view marker) -> bool {
+	const std::size_t start = line.find_first_not_of(" \t");
+
+	return start != std::string_view::npos && line.substr(start, marker.size()) == marker;
+}
+
+auto isBlank(std::string_view line) -> bool {
+	return line.find_first_not_of(" \t\r") == std::string_view::npos;
+}
+
+/**
+ * Iterates over the lines of a text buffer without copying them
+ */
+class LineReader {
+public:
+	LineReader(std::string_view content) : m_content(content) {}
+
+	/**
+	 * Reads the next line (without its terminating newline)
+	 *
+	 * @returns Whether there was another line to read
+	 */
+	auto next() -> bool {
+		if (m_next >= m_content.size()) {
+			return false;
+		}
+
+		m_start = m_next;
+
+		std::size_t end = m_content.find('\n', m_start);
+		if (end == std::string_view::npos) {
+			end = m_content.size();
+		}
+
+		m_line = m_content.substr(m_start, end - m_start);
+		m_next = end + 1;
+
+		return true;
+	}
+
+	/**
+	 * @returns The line that has been read last
+	 */
+	[[nodiscard]] auto line() const -> std::string_view { return m_line; }
+
+	/**
+	 * @returns The offset of the line that has been read last
+	 */
+	[[nodiscard]] auto offset() const -> std::size_t { return m_start; }
+
+	/**
+	 * @returns The offset of the line after the one that has been read last
+	 */
+	[[nodiscard]] auto nextOffset() const -> std::size_t { return std::min(m_next, m_content.size()); }
+
+private:
+	std::string_view m_content;
+	std::string_view m_line;
+	std::size_t m_start = 0;
+	std::size_t m_next  = 0;
+};
+
+/**
+ * Parses a single contraction block
+ *
+ * @param block The text of the block
+ * @param reporter The ErrorReporter to use, with its line offset set up to match the block's position in the file
+ * @param callback The callback to pass the parsed contraction to
+ * @param backend The parser implementation to use
+ */
+void parseContractionBlock(std::string_view block, ErrorReporter &reporter,
+						   const GeCCoExportParser::ContractionCallback &callback, GeCCoExportParser::Backend backend) {
+	if (backend == GeCCoExportParser::Backend::Fast) {
+		parseContractionsFast(block, reporter, callback);
+		return;
+	}
+
+	antlr4::ANTLRInputStream antlrInStream(block);
+
+	autogen::GeCCoExportLexer lexer(&antlrInStream);
+	lexer.removeErrorListeners();
+	lexer.addErrorListener(&reporter);
+
+	antlr4::CommonTokenStream tokens(&lexer);
+
+	autogen::GeCCoExportParser parser(&tokens);
+	parser.removeErrorListeners();
+	parser.addErrorListener(&reporter);
+
+	antlr4::tree::ParseTree *tree = parser.contraction_block();
+
+	GeCCoExportProcessor processor(callback);
+	antlr4::tree::ParseTreeWalker::DEFAULT.walk(&processor, tree);
+}
+
+GeCCoExportParser::GeCCoExportParser(Backend backend) : m_backend(backend) {
+}
+
 void GeCCoExportParser::parse(const std::filesystem::path &filePath) {
-	std::ifstream stream(filePath);
-	parse(stream, filePath.string());
+	parse(filePath, [](const GeCCoContraction &) {});
 }
 
 void GeCCoExportParser::parse(std::istream &inputStream, std::string_view fileName) {
+	parse(inputStream, [](const GeCCoContraction &) {}, fileName);
+}
+
+void GeCCoExportParser::parse(const std::filesystem::path &filePath, const ContractionCallback &callback) {
+	std::ifstream stream(filePath);
+	if (!stream) {
+		throw ParseException("Can't open GeCCo export file '" + filePath.string() + "'");
+	}
+
+	parse(stream, callback, filePath.string());
+}
+
+void GeCCoExportParser::parse(std::istream &inputStream, const ContractionCallback &callback,
+							  std::string_view fileName) {
 	try {
 		ErrorReporter reporter(fileName);
 
-		antlr4::ANTLRInputStream antlrInStream(inputStream);
+		// The individual contraction blocks are independent of each other and therefore we only ever read (and parse)
+		// a single block at a time instead of the entire file
+		std::string block;
+		std::size_t blockStart = 0;
+		std::size_t lineNumber = 0;
+		bool foundEnd          = false;
 
-		autogen::GeCCoExportLexer lexer(&antlrInStream);
-		lexer.removeErrorListeners();
-		lexer.addErrorListener(&reporter);
+		auto processBlock = [&]() {
+			if (block.empty()) {
+				return;
+			}
 
-		antlr4::CommonTokenStream tokens(&lexer);
+			reporter.setLineOffset(blockStart - 1);
+			parseContractionBlock(block, reporter, callback, m_backend);
+			block.clear();
+		};
 
-		tokens.fill();
+		std::string line;
+		while (std::getline(inputStream, line)) {
+			lineNumber++;
 
-		autogen::GeCCoExportParser parser(&tokens);
+			if (startsWithMarker(line, ContractionMarker)) {
+				processBlock();
+				blockStart = lineNumber;
+			} else if (startsWithMarker(line, EndMarker)) {
+				processBlock();
+				foundEnd = true;
+				break;
+			} else if (block.empty()) {
+				if (isBlank(line)) {
+					continue;
+				}
 
-		parser.removeErrorListeners();
-		parser.addErrorListener(&reporter);
-		antlr4::tree::ParseTree *tree = parser.body();
+				reporter.setLineOffset(0);
+				reporter.reportError(lineNumber, 0, "expected '[CONTR]' or '[END]' but got '" + line + "'");
+			}
 
-		std::cout << tree->toStringTree(&parser, true) << std::endl;
+			block += line;
+			block += '\n';
+		}
+
+		if (!foundEnd) {
+			processBlock();
+
+			reporter.setLineOffset(0);
+			reporter.reportError(lineNumber, 0, "missing '[END]' at end of input");
+		}
+
+		while (std::getline(inputStream, line)) {
+			lineNumber++;
+
+			if (!isBlank(line)) {
+				reporter.setLineOffset(0);
+				reporter.reportError(lineNumber, 0, "extraneous input after '[END]'");
+			}
+		}
 	} catch (const antlr4::RuntimeException &) {
 		std::throw_with_nested(ParseException("Parsing GeCCo export file failed."));
 	}
 }
 
+auto GeCCoExportParser::splitIntoChunks(std::string_view content, std::size_t contractionsPerChunk,
+										std::string_view fileName) -> std::vector< Chunk > {
+	contractionsPerChunk = std::max< std::size_t >(contractionsPerChunk, 1);
+
+	ErrorReporter reporter(fileName);
+	std::vector< Chunk > chunks;
+
+	LineReader reader(content);
+	std::size_t lineNumber          = 0;
+	std::size_t chunkStart          = 0;
+	std::size_t chunkLine           = 0;
+	std::size_t contractionsInChunk = 0;
+	bool foundEnd                   = false;
+
+	auto finishChunk = [&](std::size_t end) {
+		if (contractionsInChunk > 0) {
+			chunks.push_back(Chunk{ content.substr(chunkStart, end - chunkStart), chunkLine });
+			contractionsInChunk = 0;
+		}
+	};
+
+	while (reader.next()) {
+		lineNumber++;
+
+		if (startsWithMarker(reader.line(), ContractionMarker)) {
+			if (contractionsInChunk == contractionsPerChunk) {
+				finishChunk(reader.offset());
+			}
+			if (contractionsInChunk == 0) {
+				chunkStart = reader.offset();
+				chunkLine  = lineNumber;
+			}
+
+			contractionsInChunk++;
+		} else if (startsWithMarker(reader.line(), EndMarker)) {
+			finishChunk(reader.offset());
+			foundEnd = true;
+			break;
+		} else if (chunks.empty() && contractionsInChunk == 0 && !isBlank(reader.line())) {
+			reporter.reportError(lineNumber, 0,
+								 "expected '[CONTR]' or '[END]' but got '" + std::string(reader.line()) + "'");
+		}
+	}
+
+	if (!foundEnd) {
+		reporter.reportError(lineNumber, 0, "missing '[END]' at end of input");
+	}
+
+	while (reader.next()) {
+		lineNumber++;
+
+		if (!isBlank(reader.line())) {
+			reporter.reportError(lineNumber, 0, "extraneous input after '[END]'");
+		}
+	}
+
+	return chunks;
+}
+
+void GeCCoExportParser::parseChunk(const Chunk &chunk, const ContractionCallback &callback, std::string_view fileName,
+								   Backend backend) {
+	try {
+		ErrorReporter reporter(fileName);
+
+		if (backend == Backend::Fast) {
+			// The hand-written parser handles sequences of blocks directly
+			reporter.setLineOffset(chunk.firstLine - 1);
+			parseContractionsFast(chunk.content, reporter, callback);
+			return;
+		}
+
+		LineReader reader(chunk.content);
+		std::size_t lineNumber = chunk.firstLine - 1;
+		std::size_t blockStart = 0;
+		std::size_t blockLine  = 0;
+
+		// Blocks are parsed directly from the chunk's content, i.e. without copying them first
+		auto processBlock = [&](std::size_t end) {
+			if (blockLine == 0) {
+				return;
+			}
+
+			reporter.setLineOffset(blockLine - 1);
+			parseContractionBlock(chunk.content.substr(blockStart, end - blockStart), reporter, callback, backend);
+		};
+
+		while (reader.next()) {
+			lineNumber++;
+
+			if (startsWithMarker(reader.line(), ContractionMarker)) {
+				processBlock(reader.offset());
+				blockStart = reader.offset();
+				blockLine  = lineNumber;
+			}
+		}
+
+		processBlock(chunk.content.size());
+	} catch (const antlr4::RuntimeException &) {
+		std::throw_with_nested(ParseException("Parsing GeCCo export file failed."));
+	}
+}
+
+auto GeCCoExportParser::getBackend() const -> Backend {
+	return m_backend;
+}
+
 } // namespace lizard::parser
@@ -7,6 +7,161 @@
 
 #include "lizard/parser/autogen/GeCCoExportParser.h"
 
+#include <Token.h>
+#include <tree/ParseTree.h>
+#include <tree/TerminalNode.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
 namespace lizard::parser {
-// TODO
+
+auto tokenToInt(const antlr4::Token *token) -> int {
+	return std::stoi(token->getText());
+}
+
+auto tokenToSize(const antlr4::Token *token) -> std::size_t {
+	return static_cast< std::size_t >(std::stoul(token->getText()));
+}
+
+auto tokensToInts(const std::vector< antlr4::Token * > &tokens) -> std::vector< int > {
+	std::vector< int > values;
+	values.reserve(tokens.size());
+
+	for (const antlr4::Token *current : tokens) {
+		values.push_back(tokenToInt(current));
+	}
+
+	return values;
+}
+
+auto toIndexBlocks(const autogen::GeCCoExportParser::Index_specContext &ctx) -> std::vector< GeCCoIndexBlock > {
+	std::vector< GeCCoIndexBlock > blocks(1);
+	bool inAnnihilators = false;
+
+	// Index blocks may be empty, so we have to go through the children in order to know which block and which part
+	// of it an ID belongs to
+	for (antlr4::tree::ParseTree *current : ctx.children) {
+		const std::string text = current->getText();
+
+		if (text == "[" || text == "]") {
+			continue;
+		}
+		if (text == ",") {
+			inAnnihilators = true;
+			continue;
+		}
+		if (text == ";") {
+			blocks.emplace_back();
+			inAnnihilators = false;
+			continue;
+		}
+
+		(inAnnihilators ? blocks.back().annihilators : blocks.back().creators) = text;
+	}
+
+	return blocks;
+}
+
+auto toTensor(autogen::GeCCoExportParser::Tensor_specContext &ctx) -> GeCCoTensor {
+	return { ctx.name->getText(), ctx.transpose->getText() == "T", toIndexBlocks(*ctx.index_spec()) };
+}
+
+auto toArcs(autogen::GeCCoExportParser::Arc_specContext &ctx) -> std::vector< GeCCoArc > {
+	const std::vector< antlr4::tree::TerminalNode * > endpoints                = ctx.INT();
+	const std::vector< autogen::GeCCoExportParser::Index_specContext * > specs = ctx.index_spec();
+
+	std::vector< GeCCoArc > arcs;
+	arcs.reserve(specs.size());
+
+	for (std::size_t i = 0; i < specs.size(); ++i) {
+		arcs.push_back({ tokenToInt(endpoints[2 * i]->getSymbol()), tokenToInt(endpoints[2 * i + 1]->getSymbol()),
+						 toIndexBlocks(*specs[i]) });
+	}
+
+	return arcs;
+}
+
+GeCCoExportProcessor::GeCCoExportProcessor(const GeCCoExportParser::ContractionCallback &callback)
+	: m_callback(callback) {
 }
+
+void GeCCoExportProcessor::enterContraction(autogen::GeCCoExportParser::ContractionContext *ctx) {
+	(void) ctx;
+
+	m_contraction.clear();
+}
+
+void GeCCoExportProcessor::exitContraction(autogen::GeCCoExportParser::ContractionContext *ctx) {
+	(void) ctx;
+
+	m_callback(m_contraction);
+}
+
+void GeCCoExportProcessor::enterContr_num(autogen::GeCCoExportParser::Contr_numContext *ctx) {
+	m_contraction.index = tokenToSize(ctx->contraction_index);
+}
+
+void GeCCoExportProcessor::enterResult(autogen::GeCCoExportParser::ResultContext *ctx) {
+	m_contraction.result = toTensor(*ctx->tensor_spec());
+}
+
+void GeCCoExportProcessor::enterFactor(autogen::GeCCoExportParser::FactorContext *ctx) {
+	m_contraction.externalFactor    = std::stod(ctx->external_factor->getText());
+	m_contraction.sign              = tokenToInt(ctx->sign);
+	m_contraction.contractionFactor = std::stod(ctx->contraction_factor->getText());
+}
+
+void GeCCoExportProcessor::enterNum_vertices(autogen::GeCCoExportParser::Num_verticesContext *ctx) {
+	m_contraction.vertexCount   = tokenToSize(ctx->vertex_count);
+	m_contraction.operatorCount = tokenToSize(ctx->operatator_count);
+}
+
+void GeCCoExportProcessor::enterSuper_vertex(autogen::GeCCoExportParser::Super_vertexContext *ctx) {
+	m_contraction.superVertex = tokensToInts(ctx->operator_indices);
+}
+
+void GeCCoExportProcessor::enterNum_arcs(autogen::GeCCoExportParser::Num_arcsContext *ctx) {
+	m_contraction.arcCount         = tokenToSize(ctx->arc_count);
+	m_contraction.externalArcCount = tokenToSize(ctx->external_arc_count);
+}
+
+void GeCCoExportProcessor::enterVertices(autogen::GeCCoExportParser::VerticesContext *ctx) {
+	m_contraction.vertices.reserve(m_contraction.vertexCount);
+
+	for (autogen::GeCCoExportParser::Tensor_specContext *current : ctx->tensor_spec()) {
+		m_contraction.vertices.push_back(toTensor(*current));
+	}
+}
+
+void GeCCoExportProcessor::enterArcs(autogen::GeCCoExportParser::ArcsContext *ctx) {
+	m_contraction.arcs = toArcs(*ctx->arc_spec());
+}
+
+void GeCCoExportProcessor::enterExternal_arcs(autogen::GeCCoExportParser::External_arcsContext *ctx) {
+	m_contraction.externalArcs = toArcs(*ctx->arc_spec());
+}
+
+void GeCCoExportProcessor::exitResult_string(autogen::GeCCoExportParser::Result_stringContext *ctx) {
+	m_contraction.resultString.vertices = tokensToInts(ctx->vertex_indices);
+	m_contraction.resultString.types    = tokensToInts(ctx->index_types);
+	m_contraction.resultString.spaces   = tokensToInts(ctx->index_spaces);
+	m_contraction.resultString.arcs     = tokensToInts(ctx->arc_index);
+	m_contraction.resultString.ids      = tokensToInts(ctx->index_ids);
+}
+
+void GeCCoExportProcessor::exitContr_string(autogen::GeCCoExportParser::Contr_stringContext *ctx) {
+	m_contraction.contractionString.vertices = tokensToInts(ctx->vertex_indices);
+	m_contraction.contractionString.types    = tokensToInts(ctx->index_types);
+	m_contraction.contractionString.spaces   = tokensToInts(ctx->index_spaces);
+	m_contraction.contractionString.arcs     = tokensToInts(ctx->arc_index);
+	m_contraction.contractionString.ids      = tokensToInts(ctx->index_ids);
+
+	m_contraction.contractionString.resultFlags.clear();
+	for (const antlr4::Token *current : ctx->result_flags) {
+		m_contraction.contractionString.resultFlags.push_back(current->getText() == "T");
+	}
+}
+
+} // namespace lizard::parser
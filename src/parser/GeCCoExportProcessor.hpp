@@ -5,24 +5,40 @@
 
 #pragma once
 
+#include "lizard/parser/GeCCoContraction.hpp"
+#include "lizard/parser/GeCCoExportParser.hpp"
 #include "lizard/parser/autogen/GeCCoExportBaseListener.h"
 #include "lizard/parser/autogen/GeCCoExportParser.h"
 
 namespace lizard::parser {
 
+/**
+ * Listener that assembles a GeCCoContraction from the parse events of a contraction block and passes it on to the
+ * given callback once the block has been completed
+ */
 class GeCCoExportProcessor : public autogen::GeCCoExportBaseListener {
 public:
-	GeCCoExportProcessor()  = default;
-	~GeCCoExportProcessor() = default;
+	explicit GeCCoExportProcessor(const GeCCoExportParser::ContractionCallback &callback);
+	~GeCCoExportProcessor() override = default;
 
-	virtual void exitContraction(autogen::GeCCoExportParser::ContractionContext *ctx) override;
-	virtual void enterResult(autogen::GeCCoExportParser::ResultContext *ctx) override;
-	virtual void enterFactor(autogen::GeCCoExportParser::FactorContext *ctx) override;
-	virtual void enterSuper_vertex(autogen::GeCCoExportParser::Super_vertexContext *ctx) override;
-	virtual void enterVertices(autogen::GeCCoExportParser::VerticesContext *ctx) override;
+	void enterContraction(autogen::GeCCoExportParser::ContractionContext *ctx) override;
+	void exitContraction(autogen::GeCCoExportParser::ContractionContext *ctx) override;
+	void enterContr_num(autogen::GeCCoExportParser::Contr_numContext *ctx) override;
+	void enterResult(autogen::GeCCoExportParser::ResultContext *ctx) override;
+	void enterFactor(autogen::GeCCoExportParser::FactorContext *ctx) override;
+	void enterNum_vertices(autogen::GeCCoExportParser::Num_verticesContext *ctx) override;
+	void enterSuper_vertex(autogen::GeCCoExportParser::Super_vertexContext *ctx) override;
+	void enterNum_arcs(autogen::GeCCoExportParser::Num_arcsContext *ctx) override;
+	void enterVertices(autogen::GeCCoExportParser::VerticesContext *ctx) override;
+	void enterArcs(autogen::GeCCoExportParser::ArcsContext *ctx) override;
+	void enterExternal_arcs(autogen::GeCCoExportParser::External_arcsContext *ctx) override;
 
-	virtual void exitResult_string(autogen::GeCCoExportParser::Result_stringContext *ctx) override;
-	virtual void exitContr_string(autogen::GeCCoExportParser::Contr_stringContext *ctx) override;
+	void exitResult_string(autogen::GeCCoExportParser::Result_stringContext *ctx) override;
+	void exitContr_string(autogen::GeCCoExportParser::Contr_stringContext *ctx) override;
+
+private:
+	const GeCCoExportParser::ContractionCallback &m_callback;
+	GeCCoContraction m_contraction;
 };
 
 } // namespace lizard::parser
@@ -9,27 +9,32 @@
 #include "lizard/parser/autogen/TensorSymmetryParser.h"
 
 #include "ErrorReporter.hpp"
+#include "TensorSymmetryProcessor.hpp"
 
 #include <exception>
 #include <filesystem>
 #include <fstream>
-#include <iostream>
 #include <string>
 
 #include <ANTLRInputStream.h>
 #include <CommonTokenStream.h>
 #include <Exceptions.h>
 #include <tree/ParseTree.h>
+#include <tree/ParseTreeWalker.h>
 
 
 namespace lizard::parser {
 
-void TensorSymmetryParser::parse(const std::filesystem::path &filePath) {
+auto TensorSymmetryParser::parse(const std::filesystem::path &filePath) -> TensorSymmetrySpecification {
 	std::ifstream stream(filePath);
-	parse(stream, filePath.string());
+	if (!stream) {
+		throw ParseException("Can't open tensor symmetry file '" + filePath.string() + "'");
+	}
+
+	return parse(stream, filePath.string());
 }
 
-void TensorSymmetryParser::parse(std::istream &inputStream, std::string_view fileName) {
+auto TensorSymmetryParser::parse(std::istream &inputStream, std::string_view fileName) -> TensorSymmetrySpecification {
 	try {
 		ErrorReporter reporter(fileName);
 
@@ -49,7 +54,10 @@ void TensorSymmetryParser::parse(std::istream &inputStream, std::string_view fil
 		parser.addErrorListener(&reporter);
 		antlr4::tree::ParseTree *tree = parser.body();
 
-		std::cout << tree->toStringTree(&parser, true) << std::endl;
+		TensorSymmetryProcessor processor(reporter);
+		antlr4::tree::ParseTreeWalker::DEFAULT.walk(&processor, tree);
+
+		return processor.release();
 	} catch (const antlr4::RuntimeException &) {
 		std::throw_with_nested(ParseException("Parsing tensor symmetry file failed."));
 	}
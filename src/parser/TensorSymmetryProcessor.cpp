@@ -0,0 +1,123 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#include "TensorSymmetryProcessor.hpp"
+#include "ErrorReporter.hpp"
+
+#include "lizard/parser/autogen/TensorSymmetryParser.h"
+
+#include <Token.h>
+#include <tree/TerminalNode.h>
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace lizard::parser {
+
+void reportAt(const ErrorReporter &reporter, const antlr4::Token &token, const std::string &msg) {
+	reporter.reportError(token.getLine(), token.getCharPositionInLine(), msg);
+}
+
+auto tokensToStrings(const std::vector< antlr4::Token * > &tokens) -> std::vector< std::string > {
+	std::vector< std::string > strings;
+	strings.reserve(tokens.size());
+
+	for (const antlr4::Token *current : tokens) {
+		strings.push_back(current->getText());
+	}
+
+	return strings;
+}
+
+/**
+ * @returns The (1-based) slot position represented by the given token
+ */
+auto toSlotPosition(const antlr4::Token &token, std::size_t slotCount, const ErrorReporter &reporter) -> std::size_t {
+	const std::string text = token.getText();
+
+	std::size_t position = 0;
+	if (text.find_first_not_of("0123456789") == std::string::npos && text.size() <= 9) {
+		position = static_cast< std::size_t >(std::stoul(text));
+	}
+
+	if (position < 1 || position > slotCount) {
+		reportAt(reporter, token,
+				 "slot " + text + " is out of range (the block has " + std::to_string(slotCount) + " slots)");
+	}
+
+	return position;
+}
+
+TensorSymmetryProcessor::TensorSymmetryProcessor(const ErrorReporter &reporter) : m_reporter(reporter) {
+}
+
+void TensorSymmetryProcessor::enterTensor_symmetry(autogen::TensorSymmetryParser::Tensor_symmetryContext *ctx) {
+	TensorSymmetryDefinition symmetry;
+	symmetry.tensorName        = ctx->tensor_name->getText();
+	symmetry.creatorSpaces     = tokensToStrings(ctx->index_spec()->creator_spaces);
+	symmetry.annihilatorSpaces = tokensToStrings(ctx->index_spec()->annihilator_spaces);
+
+	const std::size_t slotCount = symmetry.creatorSpaces.size() + symmetry.annihilatorSpaces.size();
+
+	// The last INT is the factor, all others are pairs of exchanged slots
+	const std::vector< antlr4::tree::TerminalNode * > numbers = ctx->index_exchanges()->INT();
+	std::vector< bool > exchanged(slotCount + 1, false);
+
+	for (std::size_t i = 0; i + 1 < numbers.size(); i += 2) {
+		const antlr4::Token &firstToken  = *numbers[i]->getSymbol();
+		const antlr4::Token &secondToken = *numbers[i + 1]->getSymbol();
+
+		const SlotExchange exchange{ toSlotPosition(firstToken, slotCount, m_reporter),
+									 toSlotPosition(secondToken, slotCount, m_reporter) };
+
+		if (exchange.first == exchange.second) {
+			reportAt(m_reporter, firstToken, "slot " + firstToken.getText() + " can't be exchanged with itself");
+		}
+		if (exchanged[exchange.first] || exchanged[exchange.second]) {
+			// Simultaneous exchanges have to be disjoint in order to form a well-defined permutation
+			const antlr4::Token &repeated = exchanged[exchange.first] ? firstToken : secondToken;
+			reportAt(m_reporter, repeated, "slot " + repeated.getText() + " is part of multiple exchanges");
+		}
+
+		exchanged[exchange.first]  = true;
+		exchanged[exchange.second] = true;
+
+		symmetry.exchanges.push_back(exchange);
+	}
+
+	const antlr4::Token &factorToken = *numbers.back()->getSymbol();
+	const std::string factor         = factorToken.getText();
+	if (factor == "1" || factor == "+1") {
+		symmetry.factor = 1;
+	} else if (factor == "-1") {
+		symmetry.factor = -1;
+	} else {
+		reportAt(m_reporter, factorToken, "symmetry factor must be either 1 or -1 (got " + factor + ")");
+	}
+
+	m_specification.symmetries.push_back(std::move(symmetry));
+}
+
+void TensorSymmetryProcessor::enterIndex_space_definition(
+	autogen::TensorSymmetryParser::Index_space_definitionContext *ctx) {
+	IndexSpaceDefinition definition;
+	definition.name    = ctx->space_id->getText();
+	definition.choices = tokensToStrings(ctx->choices);
+
+	if (std::any_of(m_specification.indexSpaces.begin(), m_specification.indexSpaces.end(),
+					[&definition](const IndexSpaceDefinition &current) { return current.name == definition.name; })) {
+		reportAt(m_reporter, *ctx->space_id, "redefinition of '" + definition.name + "'");
+	}
+
+	m_specification.indexSpaces.push_back(std::move(definition));
+}
+
+auto TensorSymmetryProcessor::release() -> TensorSymmetrySpecification {
+	return std::move(m_specification);
+}
+
+} // namespace lizard::parser
@@ -0,0 +1,38 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#pragma once
+
+#include "lizard/parser/TensorSymmetrySpecification.hpp"
+#include "lizard/parser/autogen/TensorSymmetryBaseListener.h"
+#include "lizard/parser/autogen/TensorSymmetryParser.h"
+
+namespace lizard::parser {
+
+class ErrorReporter;
+
+/**
+ * Listener that assembles a TensorSymmetrySpecification from the parse events of a tensor symmetry file. Symmetries
+ * that are syntactically valid but don't describe a proper slot permutation are reported via the given ErrorReporter.
+ */
+class TensorSymmetryProcessor : public autogen::TensorSymmetryBaseListener {
+public:
+	explicit TensorSymmetryProcessor(const ErrorReporter &reporter);
+	~TensorSymmetryProcessor() override = default;
+
+	void enterTensor_symmetry(autogen::TensorSymmetryParser::Tensor_symmetryContext *ctx) override;
+	void enterIndex_space_definition(autogen::TensorSymmetryParser::Index_space_definitionContext *ctx) override;
+
+	/**
+	 * @returns The specification assembled so far. The processor must not be used afterwards.
+	 */
+	[[nodiscard]] auto release() -> TensorSymmetrySpecification;
+
+private:
+	const ErrorReporter &m_reporter;
+	TensorSymmetrySpecification m_specification;
+};
+
+} // namespace lizard::parser
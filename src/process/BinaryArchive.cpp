@@ -0,0 +1,69 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#include "lizard/process/BinaryArchive.hpp"
+#include "BinaryFormat.hpp"
+#include "lizard/process/ImportException.hpp"
+
+#include <fmt/format.h>
+
+#include <optional>
+#include <string>
+
+namespace lizard {
+
+BinaryArchive::BinaryArchive(const std::filesystem::path &filePath, const IndexSpaceManager &manager)
+	: m_file(mapBinaryFile(filePath)),
+	  m_reader(std::make_unique< BinaryExpressionReader >(viewContents(m_file), manager, filePath.string())) {
+	m_trees.resize(m_reader->getTreeCount());
+}
+
+// The reader refers to the mapped memory, which stays in place when the mapping is moved
+BinaryArchive::BinaryArchive(BinaryArchive &&other) noexcept = default;
+
+BinaryArchive::~BinaryArchive() = default;
+
+auto BinaryArchive::operator=(BinaryArchive &&other) noexcept -> BinaryArchive & = default;
+
+auto BinaryArchive::size() const -> std::size_t {
+	return m_trees.size();
+}
+
+auto BinaryArchive::getResults() const -> const std::vector< TensorElement > & {
+	return m_reader->getResults();
+}
+
+auto BinaryArchive::contains(const TensorElement &result) const -> bool {
+	return m_reader->find(result).has_value();
+}
+
+auto BinaryArchive::get(const TensorElement &result) -> const NamedTensorExprTree & {
+	const std::optional< std::size_t > position = m_reader->find(result);
+
+	if (!position) {
+		throw ImportException("The binary archive doesn't contain an expression for the requested result");
+	}
+
+	return get(position.value());
+}
+
+auto BinaryArchive::get(std::size_t position) -> const NamedTensorExprTree & {
+	if (position >= m_trees.size()) {
+		throw ImportException(
+			fmt::format("Can't access tree {} of a binary archive containing {} trees", position, m_trees.size()));
+	}
+
+	if (!m_trees[position]) {
+		m_trees[position] = std::make_unique< NamedTensorExprTree >(m_reader->readTree(position));
+	}
+
+	return *m_trees[position];
+}
+
+auto BinaryArchive::isLoaded(std::size_t position) const -> bool {
+	return position < m_trees.size() && m_trees[position] != nullptr;
+}
+
+} // namespace lizard
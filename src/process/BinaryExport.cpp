@@ -0,0 +1,60 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#include "lizard/process/BinaryExport.hpp"
+#include "BinaryFormat.hpp"
+#include "lizard/process/ExportException.hpp"
+
+#include <fmt/format.h>
+
+#include <fstream>
+#include <ostream>
+#include <utility>
+
+namespace lizard {
+
+BinaryExport::BinaryExport(std::filesystem::path outputPath) : m_outputPath(std::move(outputPath)) {
+}
+
+auto BinaryExport::getName() const -> std::string {
+	return "BinaryExport";
+}
+
+auto BinaryExport::getParameters() const -> std::string {
+	return m_outputPath.string();
+}
+
+auto BinaryExport::getOutputPath() const -> const std::filesystem::path & {
+	return m_outputPath;
+}
+
+void BinaryExport::exportExpressions(nonstd::span< const NamedTensorExprTree > expressions,
+									 const IndexSpaceManager &manager) {
+	std::ofstream stream(m_outputPath, std::ios::binary | std::ios::trunc);
+	if (!stream) {
+		throw ExportException(fmt::format("Can't open '{}' for writing", m_outputPath.string()));
+	}
+
+	write(expressions, manager, stream);
+
+	getLogger().info("Exported {} expressions to '{}'", expressions.size(), m_outputPath.string());
+}
+
+void BinaryExport::write(nonstd::span< const NamedTensorExprTree > expressions, const IndexSpaceManager &manager,
+						 std::ostream &stream) {
+	BinaryExpressionWriter writer(manager);
+
+	for (const NamedTensorExprTree &current : expressions) {
+		writer.add(current);
+	}
+
+	writer.write(stream);
+
+	if (!stream) {
+		throw ExportException("Failed to write binary expressions");
+	}
+}
+
+} // namespace lizard
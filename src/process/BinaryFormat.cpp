@@ -0,0 +1,674 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#include "BinaryFormat.hpp"
+#include "lizard/core/Exception.hpp"
+#include "lizard/process/BinaryExport.hpp"
+#include "lizard/process/ExportException.hpp"
+#include "lizard/process/ImportException.hpp"
+#include "lizard/symbolic/IndexSpaceManager.hpp"
+#include "lizard/symbolic/InvalidIndexSpaceException.hpp"
+
+#include <libperm/ExplicitPermutation.hpp>
+#include <libperm/Permutation.hpp>
+#include <libperm/PrimitivePermutationGroup.hpp>
+#include <libperm/Utils.hpp>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <exception>
+#include <limits>
+#include <optional>
+#include <ostream>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace lizard {
+
+constexpr const std::array< char, 4 > BinaryFormatMagic = { 'L', 'Z', 'B', 'X' };
+constexpr const std::size_t BinaryHeaderSize             = BinaryFormatMagic.size() + 2 * 2 + 4 * 4 + 8;
+
+/**
+ * The positions of the fields inside of a node record
+ */
+constexpr const std::size_t NodeTypeField     = 0;
+constexpr const std::size_t NodeOperatorField = 1;
+constexpr const std::size_t NodeParentField   = 4;
+constexpr const std::size_t NodeLeftField     = 8;
+constexpr const std::size_t NodeRightField    = 12;
+
+/**
+ * The size of the node and variable count preceding every tree
+ */
+constexpr const std::size_t TreeHeaderSize = 2 * 4;
+
+/**
+ * The size of a single index (its ID followed by its type) inside of an encoded element
+ */
+constexpr const std::size_t IndexRecordSize = sizeof(Index::Id) + sizeof(std::int8_t);
+
+/**
+ * Writes the given value to the given location, which has to provide sizeof(T) bytes
+ */
+template< typename T > void storeLittleEndian(char *target, T value) {
+	static_assert(std::is_integral_v< T >);
+
+	auto numeric = static_cast< std::make_unsigned_t< T > >(value);
+	for (std::size_t i = 0; i < sizeof(T); ++i) {
+		target[i] = static_cast< char >(static_cast< std::uint8_t >(numeric >> (8 * i))); // NOLINT
+	}
+}
+
+template< typename T > void appendLittleEndian(std::string &buffer, T value) {
+	std::array< char, sizeof(T) > bytes = {};
+	storeLittleEndian(bytes.data(), value);
+
+	buffer.append(bytes.data(), bytes.size());
+}
+
+/**
+ * Reads the value stored at the given position of the data, which has to contain at least sizeof(T) bytes from there
+ */
+template< typename T > auto loadLittleEndian(std::string_view data, std::size_t position) -> T {
+	static_assert(std::is_integral_v< T >);
+
+	std::make_unsigned_t< T > numeric = 0;
+	for (std::size_t i = 0; i < sizeof(T); ++i) {
+		numeric |= static_cast< std::make_unsigned_t< T > >(static_cast< std::uint8_t >(data[position + i])) << (8 * i);
+	}
+
+	return static_cast< T >(numeric);
+}
+
+template< typename T > auto checkedCast(std::size_t value, std::string_view what) -> T {
+	if (value > std::numeric_limits< T >::max()) {
+		throw ExportException(fmt::format("Too many {} for the binary format ({})", what, value));
+	}
+
+	return static_cast< T >(value);
+}
+
+
+
+BinaryExpressionWriter::BinaryExpressionWriter(const IndexSpaceManager &manager) : m_manager(&manager) {
+}
+
+void BinaryExpressionWriter::add(const NamedTensorExprTree &tree) {
+	addElement(m_index, tree.getResult());
+	appendLittleEndian(m_index, static_cast< std::uint64_t >(m_trees.size()));
+
+	const auto nodeCount = checkedCast< std::uint32_t >(tree.size(), "tree nodes");
+	appendLittleEndian(m_trees, nodeCount);
+
+	// The variable count is only known once all nodes have been written
+	const std::size_t variableCountPosition = m_trees.size();
+	appendLittleEndian(m_trees, std::uint32_t{ 0 });
+
+	if (tree.isEmpty()) {
+		m_treeCount++;
+		return;
+	}
+
+	const std::size_t recordsBegin = m_trees.size();
+	m_trees.reserve(recordsBegin + nodeCount * NodeRecordSize);
+	m_elements.clear();
+	m_operands.clear();
+
+	std::uint32_t variableCount = 0;
+	for (const ConstTensorExpr &current : tree) {
+		const auto nodeID = static_cast< std::uint32_t >((m_trees.size() - recordsBegin) / NodeRecordSize);
+
+		std::array< char, NodeRecordSize > record = {};
+		storeLittleEndian(&record[NodeTypeField], static_cast< std::uint8_t >(current.getType()));
+		storeLittleEndian(&record[NodeParentField], Numeric::Invalid);
+
+		switch (current.getType()) {
+			case ExpressionType::Operator: {
+				assert(m_operands.size() >= 2); // NOLINT
+				const std::uint32_t rhs = m_operands.back();
+				m_operands.pop_back();
+				const std::uint32_t lhs = m_operands.back();
+				m_operands.pop_back();
+
+				storeLittleEndian(&record[NodeOperatorField], static_cast< std::uint8_t >(current.getOperator()));
+				storeLittleEndian(&record[NodeLeftField], lhs);
+				storeLittleEndian(&record[NodeRightField], rhs);
+
+				storeLittleEndian(&m_trees[recordsBegin + lhs * NodeRecordSize + NodeParentField], nodeID);
+				storeLittleEndian(&m_trees[recordsBegin + rhs * NodeRecordSize + NodeParentField], nodeID);
+				break;
+			}
+			case ExpressionType::Literal:
+				storeLittleEndian(&record[NodeLeftField],
+								  static_cast< std::int32_t >(current.getLiteral().getNumerator()));
+				storeLittleEndian(&record[NodeRightField],
+								  static_cast< std::int32_t >(current.getLiteral().getDenominator()));
+				break;
+			case ExpressionType::Variable:
+				storeLittleEndian(&record[NodeLeftField],
+								  checkedCast< std::uint32_t >(m_elements.size(), "bytes of tensor elements"));
+				addElement(m_elements, current.getVariable());
+				variableCount++;
+				break;
+		}
+
+		m_trees.append(record.data(), record.size());
+		m_operands.push_back(nodeID);
+	}
+
+	storeLittleEndian(&m_trees[variableCountPosition], variableCount);
+	m_trees.append(m_elements);
+	m_treeCount++;
+}
+
+void BinaryExpressionWriter::write(std::ostream &stream) const {
+	std::string header;
+	header.reserve(BinaryHeaderSize);
+
+	header.append(BinaryFormatMagic.data(), BinaryFormatMagic.size());
+	appendLittleEndian(header, BinaryExport::FormatVersion);
+	appendLittleEndian(header, std::uint16_t{ 0 });
+	appendLittleEndian(header, static_cast< std::uint32_t >(m_stringIDs.size()));
+	appendLittleEndian(header, static_cast< std::uint32_t >(m_spaceIDs.size()));
+	appendLittleEndian(header, static_cast< std::uint32_t >(m_blockIDs.size()));
+	appendLittleEndian(header, m_treeCount);
+	appendLittleEndian(header, static_cast< std::uint64_t >(m_trees.size()));
+
+	const std::array< const std::string *, 6 > sections = { &header,   &m_strings, &m_spaces,
+															&m_blocks, &m_trees,   &m_index };
+	for (const std::string *current : sections) {
+		stream.write(current->data(), static_cast< std::streamsize >(current->size()));
+	}
+}
+
+auto BinaryExpressionWriter::addString(std::string_view string) -> std::uint32_t {
+	auto [iter, inserted] =
+		m_stringIDs.insert({ std::string(string), static_cast< std::uint32_t >(m_stringIDs.size()) });
+
+	if (inserted) {
+		appendLittleEndian(m_strings, checkedCast< std::uint32_t >(string.size(), "characters in a string"));
+		m_strings.append(string);
+	}
+
+	return iter->second;
+}
+
+void BinaryExpressionWriter::addSpace(const IndexSpace &space) {
+	if (std::find(m_spaceIDs.begin(), m_spaceIDs.end(), space.getID()) != m_spaceIDs.end()) {
+		return;
+	}
+
+	std::uint32_t nameID = 0;
+	try {
+		nameID = addString(m_manager->getData(space).getName());
+	} catch (const InvalidIndexSpaceException &) {
+		std::throw_with_nested(ExportException(
+			fmt::format("Can't export expressions referring to unknown index space {}", space.getID())));
+	}
+
+	appendLittleEndian(m_spaces, space.getID());
+	appendLittleEndian(m_spaces, nameID);
+	m_spaceIDs.push_back(space.getID());
+}
+
+auto BinaryExpressionWriter::addBlock(const TensorBlock &block) -> std::uint32_t {
+	auto iter = m_blockIDs.find(block);
+	if (iter != m_blockIDs.end()) {
+		return iter->second;
+	}
+
+	const auto slotCount = checkedCast< std::uint8_t >(block.dimension(), "index slots in a tensor block");
+
+	appendLittleEndian(m_blocks, addString(block.getTensor().getName()));
+	appendLittleEndian(m_blocks, slotCount);
+
+	for (const IndexSpace &currentSlot : block.getIndexSlots()) {
+		addSpace(currentSlot);
+
+		appendLittleEndian(m_blocks, currentSlot.getID());
+		appendLittleEndian(m_blocks, static_cast< std::int8_t >(currentSlot.getSpin()));
+	}
+
+	std::vector< perm::Permutation > symmetryElements;
+	block.getSlotSymmetry().getElementsTo(symmetryElements);
+	symmetryElements.erase(std::remove_if(symmetryElements.begin(), symmetryElements.end(),
+										  [](const perm::Permutation &current) { return current->isIdentity(); }),
+						   symmetryElements.end());
+
+	appendLittleEndian(m_blocks, checkedCast< std::uint16_t >(symmetryElements.size(), "symmetry elements"));
+
+	for (const perm::Permutation &currentPerm : symmetryElements) {
+		appendLittleEndian(m_blocks, static_cast< std::int8_t >(currentPerm->sign()));
+
+		for (std::size_t i = 0; i < slotCount; ++i) {
+			appendLittleEndian(m_blocks, static_cast< std::uint8_t >(
+											 currentPerm->image(static_cast< perm::Permutation::value_type >(i))));
+		}
+	}
+
+	const auto blockID = static_cast< std::uint32_t >(m_blockIDs.size());
+	m_blockIDs.insert({ block, blockID });
+
+	return blockID;
+}
+
+void BinaryExpressionWriter::addElement(std::string &buffer, const TensorElement &element) {
+	appendLittleEndian(buffer, addBlock(element.getBlock()));
+
+	for (const Index &currentIndex : element.getIndices()) {
+		appendLittleEndian(buffer, currentIndex.getID());
+		appendLittleEndian(buffer, static_cast< std::int8_t >(currentIndex.getType()));
+	}
+}
+
+
+
+BinaryExpressionReader::BinaryExpressionReader(std::string_view data, const IndexSpaceManager &manager,
+											   std::string source)
+	: m_data(data), m_source(std::move(source)) {
+	Cursor cursor{ m_data };
+
+	const std::string_view magic = readBytes(cursor, BinaryFormatMagic.size());
+	if (magic != std::string_view(BinaryFormatMagic.data(), BinaryFormatMagic.size())) {
+		fail("missing magic number");
+	}
+
+	const auto version = read< std::uint16_t >(cursor);
+	if (version != BinaryExport::FormatVersion) {
+		fail(fmt::format("unsupported format version {} (expected {})", version, BinaryExport::FormatVersion));
+	}
+	(void) read< std::uint16_t >(cursor);
+
+	const auto stringCount = read< std::uint32_t >(cursor);
+	const auto spaceCount  = read< std::uint32_t >(cursor);
+	const auto blockCount  = read< std::uint32_t >(cursor);
+	const auto treeCount   = read< std::uint32_t >(cursor);
+	const auto treesSize   = read< std::uint64_t >(cursor);
+
+	std::vector< std::string_view > strings;
+	strings.reserve(std::min< std::size_t >(stringCount, m_data.size()));
+	for (std::size_t i = 0; i < stringCount; ++i) {
+		strings.push_back(readBytes(cursor, read< std::uint32_t >(cursor)));
+	}
+
+	// The IDs of the index spaces are used as-is, so they have to refer to the same spaces in the current run
+	std::array< bool, std::numeric_limits< IndexSpace::Id >::max() + 1 > knownSpaces = {};
+	for (std::size_t i = 0; i < spaceCount; ++i) {
+		const auto spaceID = read< IndexSpace::Id >(cursor);
+		const auto nameID  = read< std::uint32_t >(cursor);
+		if (nameID >= strings.size()) {
+			fail("invalid string reference");
+		}
+
+		std::optional< IndexSpace > space;
+		try {
+			space = manager.createFromName(strings[nameID]);
+		} catch (const InvalidIndexSpaceException &) {
+			std::throw_with_nested(ImportException(
+				fmt::format("'{}' refers to unknown index space '{}'", m_source, strings[nameID])));
+		}
+
+		if (space->getID() != spaceID) {
+			throw ImportException(fmt::format("Index space '{}' has ID {} in '{}' but ID {} in the current setup",
+											  strings[nameID], spaceID, m_source, space->getID()));
+		}
+
+		knownSpaces[spaceID] = true;
+	}
+
+	m_blocks.reserve(std::min< std::size_t >(blockCount, m_data.size()));
+	for (std::size_t i = 0; i < blockCount; ++i) {
+		const auto nameID = read< std::uint32_t >(cursor);
+		if (nameID >= strings.size()) {
+			fail("invalid string reference");
+		}
+
+		const auto slotCount = read< std::uint8_t >(cursor);
+
+		TensorBlock::IndexSlots slots;
+		slots.reserve(slotCount);
+		for (std::size_t k = 0; k < slotCount; ++k) {
+			const auto spaceID = read< IndexSpace::Id >(cursor);
+			const auto spin    = read< std::int8_t >(cursor);
+			if (!knownSpaces[spaceID] || spin < static_cast< std::int8_t >(Spin::Beta)
+				|| spin > static_cast< std::int8_t >(Spin::Both)) {
+				fail("invalid index slot");
+			}
+
+			slots.emplace_back(spaceID, static_cast< Spin >(spin));
+		}
+
+		TensorBlock::SlotSymmetry symmetry;
+		const auto elementCount = read< std::uint16_t >(cursor);
+		for (std::size_t k = 0; k < elementCount; ++k) {
+			const auto sign = read< std::int8_t >(cursor);
+
+			std::vector< perm::ExplicitPermutation::value_type > images(slotCount);
+			for (std::size_t j = 0; j < slotCount; ++j) {
+				const auto image = read< std::uint8_t >(cursor);
+				if (image >= slotCount) {
+					fail("invalid slot symmetry");
+				}
+
+				images[j] = static_cast< perm::ExplicitPermutation::value_type >(image);
+			}
+
+			if (sign != 1 && sign != -1) {
+				fail("invalid slot symmetry");
+			}
+
+			symmetry.addGenerator(perm::ExplicitPermutation(std::move(images), sign));
+		}
+
+		if (!perm::computeCanonicalizationPermutation(slots, symmetry)->isIdentity()) {
+			fail("tensor block with non-canonical slots");
+		}
+
+		// The slots are canonical already. Any sign reported for them stems from symmetry elements mapping equal slots
+		// onto each other and is therefore meaningless.
+		m_blocks.push_back(std::get< 0 >(
+			TensorBlock::create(Tensor(std::string(strings[nameID])), std::move(slots), std::move(symmetry))));
+	}
+
+	// The trees themselves are only decoded on request
+	const std::size_t treeSectionBegin = cursor.position;
+	if (treesSize > m_data.size() - cursor.position) {
+		fail("unexpected end of data");
+	}
+	cursor.position += static_cast< std::size_t >(treesSize);
+	m_treeSectionEnd = cursor.position;
+
+	m_results.reserve(std::min< std::size_t >(treeCount, m_data.size()));
+	m_offsets.reserve(std::min< std::size_t >(treeCount, m_data.size()));
+	for (std::size_t i = 0; i < treeCount; ++i) {
+		TensorElement result = readElement(cursor);
+		const auto offset    = read< std::uint64_t >(cursor);
+
+		// Trees are stored back to back, so the offsets have to start at zero and grow strictly
+		if (offset >= treesSize || (i == 0 && offset != 0)
+			|| (i > 0 && treeSectionBegin + offset <= m_offsets.back())) {
+			fail("invalid tree offset");
+		}
+
+		m_resultPositions.insert({ result, m_results.size() });
+		m_results.push_back(std::move(result));
+		m_offsets.push_back(treeSectionBegin + static_cast< std::size_t >(offset));
+	}
+
+	if (cursor.position != m_data.size() || (treeCount == 0 && treesSize != 0)) {
+		fail("unexpected trailing data");
+	}
+}
+
+auto BinaryExpressionReader::getTreeCount() const -> std::size_t {
+	return m_results.size();
+}
+
+auto BinaryExpressionReader::getResults() const -> const std::vector< TensorElement > & {
+	return m_results;
+}
+
+auto BinaryExpressionReader::find(const TensorElement &result) const -> std::optional< std::size_t > {
+	auto iter = m_resultPositions.find(result);
+
+	if (iter == m_resultPositions.end()) {
+		return std::nullopt;
+	}
+
+	return iter->second;
+}
+
+auto BinaryExpressionReader::readTree(std::size_t position) const -> NamedTensorExprTree {
+	const BinaryTreeLayout layout = getTreeLayout(position);
+
+	NamedTensorExprTree tree(m_results[position]);
+	tree.reserve(layout.nodeCount, layout.variableCount);
+
+	// The layout has been verified to describe a valid tree in post-order, which is the order in which nodes are
+	// added to a tree. Thus, the IDs referenced by the decoded nodes coincide with the ones assigned by the tree.
+	for (std::size_t i = 0; i < layout.nodeCount; ++i) {
+		TreeNode node = decodeNode(layout.nodes, i);
+
+		if (node.getType() == ExpressionType::Variable) {
+			tree.add(readElement(layout.elements, node.getLeftChild()));
+		} else {
+			tree.add(std::move(node));
+		}
+	}
+
+	return tree;
+}
+
+auto BinaryExpressionReader::getTreeLayout(std::size_t position) const -> BinaryTreeLayout {
+	if (position >= m_results.size()) {
+		fail(fmt::format("there is no expression tree at position {}", position));
+	}
+
+	// Restrict reading to the tree's own data
+	const std::size_t end = position + 1 < m_offsets.size() ? m_offsets[position + 1] : m_treeSectionEnd;
+	Cursor cursor{ m_data.substr(m_offsets[position], end - m_offsets[position]) };
+
+	BinaryTreeLayout layout;
+	layout.nodeCount     = read< std::uint32_t >(cursor);
+	layout.variableCount = read< std::uint32_t >(cursor);
+
+	if (layout.nodeCount > (cursor.data.size() - cursor.position) / NodeRecordSize
+		|| layout.variableCount > layout.nodeCount) {
+		fail("invalid node count");
+	}
+
+	layout.nodes    = readBytes(cursor, layout.nodeCount * NodeRecordSize);
+	layout.elements = cursor.data.substr(cursor.position);
+
+	Cursor elementCursor{ layout.elements };
+	std::unordered_set< std::string_view > verifiedElements;
+	std::vector< std::uint32_t > operands;
+	std::size_t variableCount = 0;
+
+	for (std::size_t i = 0; i < layout.nodeCount; ++i) {
+		const std::string_view record = layout.nodes.substr(i * NodeRecordSize, NodeRecordSize);
+		const auto nodeID             = static_cast< std::uint32_t >(i);
+		const auto left               = loadLittleEndian< std::uint32_t >(record, NodeLeftField);
+		const auto right              = loadLittleEndian< std::uint32_t >(record, NodeRightField);
+
+		switch (static_cast< ExpressionType >(loadLittleEndian< std::uint8_t >(record, NodeTypeField))) {
+			case ExpressionType::Operator: {
+				const auto operatorType =
+					static_cast< ExpressionOperator >(loadLittleEndian< std::uint8_t >(record, NodeOperatorField));
+				if (operatorType != ExpressionOperator::Plus && operatorType != ExpressionOperator::Times) {
+					fail("invalid operator");
+				}
+
+				// The arguments of an operator have to be the two sub-trees preceding it
+				if (operands.size() < 2 || operands[operands.size() - 2] != left || operands.back() != right) {
+					fail("invalid operator arguments");
+				}
+
+				operands.resize(operands.size() - 2);
+
+				for (std::uint32_t currentChild : { left, right }) {
+					const std::string_view childRecord = layout.nodes.substr(currentChild * NodeRecordSize);
+					if (loadLittleEndian< std::uint32_t >(childRecord, NodeParentField) != nodeID) {
+						fail("inconsistent parent reference");
+					}
+				}
+				break;
+			}
+			case ExpressionType::Literal:
+				if (right == 0) {
+					fail("invalid literal");
+				}
+				break;
+			case ExpressionType::Variable:
+				// Elements are stored in the order in which they are referenced
+				if (left != elementCursor.position || right != 0) {
+					fail("invalid element reference");
+				}
+
+				skipElement(elementCursor, verifiedElements);
+				variableCount++;
+				break;
+			default:
+				fail("invalid node type");
+		}
+
+		operands.push_back(nodeID);
+	}
+
+	if (layout.nodeCount > 0
+		&& (operands.size() != 1
+			|| loadLittleEndian< std::uint32_t >(layout.nodes, layout.nodes.size() - NodeRecordSize + NodeParentField)
+				   != Numeric::Invalid)) {
+		fail("incomplete expression tree");
+	}
+
+	if (variableCount != layout.variableCount) {
+		fail("invalid variable count");
+	}
+
+	if (elementCursor.position != layout.elements.size()) {
+		fail("unexpected trailing data in expression tree");
+	}
+
+	return layout;
+}
+
+auto BinaryExpressionReader::readElement(std::string_view elements, std::size_t offset) const -> TensorElement {
+	if (offset > elements.size()) {
+		fail("invalid element reference");
+	}
+
+	// The element's index order has already been verified by getTreeLayout
+	Cursor cursor{ elements, offset };
+	return decodeElement(cursor);
+}
+
+template< typename T > auto BinaryExpressionReader::read(Cursor &cursor) const -> T {
+	return loadLittleEndian< T >(readBytes(cursor, sizeof(T)), 0);
+}
+
+auto BinaryExpressionReader::readBytes(Cursor &cursor, std::size_t count) const -> std::string_view {
+	if (count > cursor.data.size() - cursor.position) {
+		fail("unexpected end of data");
+	}
+
+	const std::string_view bytes = cursor.data.substr(cursor.position, count);
+	cursor.position += count;
+
+	return bytes;
+}
+
+auto BinaryExpressionReader::readElement(Cursor &cursor) const -> TensorElement {
+	const TensorBlock &block     = readBlockReference(cursor);
+	std::vector< Index > indices = readIndices(cursor, block);
+
+	verifyIndexOrder(indices, block);
+
+	return TensorElement::fromCanonical(block, std::move(indices));
+}
+
+auto BinaryExpressionReader::decodeElement(Cursor &cursor) const -> TensorElement {
+	const TensorBlock &block = readBlockReference(cursor);
+
+	return TensorElement::fromCanonical(block, readIndices(cursor, block));
+}
+
+void BinaryExpressionReader::skipElement(Cursor &cursor, std::unordered_set< std::string_view > &verified) const {
+	const std::size_t begin  = cursor.position;
+	const TensorBlock &block = readBlockReference(cursor);
+	Cursor indexCursor{ readBytes(cursor, block.dimension() * IndexRecordSize) };
+
+	// The same elements tend to appear many times, so every distinct encoding only has to be verified once
+	if (verified.insert(cursor.data.substr(begin, cursor.position - begin)).second) {
+		verifyIndexOrder(readIndices(indexCursor, block), block);
+	}
+}
+
+auto BinaryExpressionReader::readBlockReference(Cursor &cursor) const -> const TensorBlock & {
+	const auto blockID = read< std::uint32_t >(cursor);
+	if (blockID >= m_blocks.size()) {
+		fail("invalid tensor block reference");
+	}
+
+	return m_blocks[blockID];
+}
+
+auto BinaryExpressionReader::readIndices(Cursor &cursor, const TensorBlock &block) const -> std::vector< Index > {
+	std::vector< Index > indices;
+	indices.reserve(block.dimension());
+	for (std::size_t i = 0; i < block.dimension(); ++i) {
+		const auto id   = read< Index::Id >(cursor);
+		const auto type = read< std::int8_t >(cursor);
+		if (type < static_cast< std::int8_t >(IndexType::Annihilator)
+			|| type > static_cast< std::int8_t >(IndexType::Creator)) {
+			fail("invalid index type");
+		}
+
+		indices.emplace_back(id, block.getIndexSlots()[i], static_cast< IndexType >(type));
+	}
+
+	return indices;
+}
+
+void BinaryExpressionReader::verifyIndexOrder(const std::vector< Index > &indices, const TensorBlock &block) const {
+	// Elements are written in canonical order, which allows to decode them without canonicalizing them again
+	if (!perm::computeCanonicalizationPermutation(indices, block.getSlotSymmetry())->isIdentity()) {
+		fail("tensor element with non-canonical indices");
+	}
+}
+
+void BinaryExpressionReader::fail(std::string_view reason) const {
+	throw ImportException(fmt::format("'{}' is not a valid binary expression file: {}", m_source, reason));
+}
+
+
+
+auto mapBinaryFile(const std::filesystem::path &filePath) -> MemoryMappedFile {
+	try {
+		return MemoryMappedFile(filePath);
+	} catch (const Exception &) {
+		std::throw_with_nested(ImportException(fmt::format("Failed to read '{}'", filePath.string())));
+	}
+}
+
+auto decodeNode(std::string_view nodes, std::size_t nodeID) -> TreeNode {
+	const std::string_view record = nodes.substr(nodeID * NodeRecordSize, NodeRecordSize);
+	const auto left               = loadLittleEndian< std::uint32_t >(record, NodeLeftField);
+	const auto right              = loadLittleEndian< std::uint32_t >(record, NodeRightField);
+
+	auto createNode = [&]() {
+		switch (static_cast< ExpressionType >(loadLittleEndian< std::uint8_t >(record, NodeTypeField))) {
+			case ExpressionType::Operator: {
+				TreeNode node(
+					static_cast< ExpressionOperator >(loadLittleEndian< std::uint8_t >(record, NodeOperatorField)));
+				node.setLeftChild(Numeric(left));
+				node.setRightChild(Numeric(right));
+				return node;
+			}
+			case ExpressionType::Literal:
+				return TreeNode(static_cast< std::int32_t >(left), static_cast< std::int32_t >(right));
+			case ExpressionType::Variable:
+				break;
+		}
+
+		return TreeNode(ExpressionType::Variable, Numeric(left));
+	};
+
+	TreeNode node = createNode();
+	node.setParent(Numeric(loadLittleEndian< std::uint32_t >(record, NodeParentField)));
+
+	return node;
+}
+
+auto viewContents(const MemoryMappedFile &file) -> std::string_view {
+	// NOLINTNEXTLINE(*-reinterpret-cast)
+	return { reinterpret_cast< const char * >(file.data()), file.size() };
+}
+
+} // namespace lizard
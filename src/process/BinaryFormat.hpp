@@ -0,0 +1,237 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#pragma once
+
+#include "lizard/core/MemoryMappedFile.hpp"
+#include "lizard/symbolic/IndexSpace.hpp"
+#include "lizard/symbolic/TensorBlock.hpp"
+#include "lizard/symbolic/TensorElement.hpp"
+#include "lizard/symbolic/TensorExpressions.hpp"
+#include "lizard/symbolic/TreeNode.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <iosfwd>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace lizard {
+
+class IndexSpaceManager;
+
+/**
+ * The size of a single node in the tree section of the binary format
+ */
+constexpr const std::size_t NodeRecordSize = 16;
+
+/**
+ * The parts of an encoded expression tree
+ */
+struct BinaryTreeLayout {
+	std::uint32_t nodeCount     = 0;
+	std::uint32_t variableCount = 0;
+	/**
+	 * The records of all nodes in post-order (the root comes last)
+	 */
+	std::string_view nodes;
+	/**
+	 * The area holding the tree's elements
+	 */
+	std::string_view elements;
+};
+
+/**
+ * Encoder for the binary expression format (see BinaryExport). All integers are written in little-endian byte order.
+ *
+ * Layout:
+ * - Header: the magic "LZBX", u16 format version, u16 (reserved), u32 string count, u32 index space count, u32 block
+ *   count, u32 tree count, u64 size of the tree section
+ * - String table: per string its u32 length followed by its characters
+ * - Index space table: per space its u8 ID (as used in the file) and the u32 string ID of its name
+ * - Block table: per block the u32 string ID of the tensor name, the u8 slot count, per slot the u8 index space ID
+ *   and i8 spin, the u16 number of non-identity symmetry elements and per element its i8 sign followed by the u8
+ *   images of all slots
+ * - Tree section: per tree its u32 node count, the u32 variable count, the nodes in post-order and the tree's element
+ *   area. Every node is a record of NodeRecordSize bytes: the u8 ExpressionType, the u8 operator (zero for other
+ *   types), u16 (reserved), the u32 ID of the parent (0xFFFFFFFF for the root) and two u32 fields. For operators,
+ *   these are the IDs of the left and right child, for literals the i32 numerator and denominator and for variables
+ *   the offset of the element inside of the element area (and zero). The element area holds the tree's elements in
+ *   the order in which they appear in the tree.
+ * - Index (footer): per tree its result element and the u64 offset of the tree relative to the start of the tree
+ *   section. This allows to decode individual trees without having to decode the ones stored before them.
+ *
+ * Elements are stored as the u32 ID of their block followed by the u8 ID and i8 type of every index (in canonical
+ * order). The index spaces of the indices are implied by the block.
+ *
+ * Since all nodes have the same size, a tree's structure can be navigated in-place (see MappedTensorExprTree).
+ */
+class BinaryExpressionWriter {
+public:
+	explicit BinaryExpressionWriter(const IndexSpaceManager &manager);
+
+	/**
+	 * Encodes the given tree and appends it to the ones added before
+	 *
+	 * @throws ExportException if the tree can't be represented in the binary format
+	 */
+	void add(const NamedTensorExprTree &tree);
+
+	/**
+	 * Writes the header, the tables and all trees added so far to the given stream
+	 */
+	void write(std::ostream &stream) const;
+
+private:
+	const IndexSpaceManager *m_manager;
+	std::string m_strings;
+	std::string m_spaces;
+	std::string m_blocks;
+	std::string m_trees;
+	std::string m_index;
+	std::string m_elements;
+	std::vector< std::uint32_t > m_operands;
+	std::unordered_map< std::string, std::uint32_t > m_stringIDs;
+	std::vector< IndexSpace::Id > m_spaceIDs;
+	std::unordered_map< TensorBlock, std::uint32_t > m_blockIDs;
+	std::uint32_t m_treeCount = 0;
+
+	auto addString(std::string_view string) -> std::uint32_t;
+
+	void addSpace(const IndexSpace &space);
+
+	auto addBlock(const TensorBlock &block) -> std::uint32_t;
+
+	void addElement(std::string &buffer, const TensorElement &element);
+};
+
+/**
+ * Decoder for the binary expression format written by BinaryExpressionWriter. The trees are only decoded on request,
+ * such that individual trees can be read without paying for the remaining ones.
+ */
+class BinaryExpressionReader {
+public:
+	/**
+	 * Reads the header, the tables and the index of the given data. The data has to outlive the reader.
+	 *
+	 * @param data The encoded data
+	 * @param manager The IndexSpaceManager to resolve the index spaces referenced by the data with
+	 * @param source The name of the data's origin to use in error messages
+	 *
+	 * @throws ImportException if the data is corrupted or refers to unknown index spaces
+	 */
+	BinaryExpressionReader(std::string_view data, const IndexSpaceManager &manager, std::string source);
+
+	/**
+	 * @returns The number of trees contained in the data
+	 */
+	[[nodiscard]] auto getTreeCount() const -> std::size_t;
+
+	/**
+	 * @returns The results of all trees contained in the data (in the order in which they are stored)
+	 */
+	[[nodiscard]] auto getResults() const -> const std::vector< TensorElement > &;
+
+	/**
+	 * @returns The position of the tree with the given result or std::nullopt if there is no such tree. If several
+	 * trees share the same result, the first one of them is found.
+	 */
+	[[nodiscard]] auto find(const TensorElement &result) const -> std::optional< std::size_t >;
+
+	/**
+	 * Decodes the tree at the given position
+	 *
+	 * @throws ImportException if the tree's data is corrupted or there is no tree at the given position
+	 */
+	[[nodiscard]] auto readTree(std::size_t position) const -> NamedTensorExprTree;
+
+	/**
+	 * Locates the parts of the tree at the given position and verifies that they form a valid tree: all node types
+	 * and operators are known, every operator refers to the two preceding sub-trees (post-order) and is referred to
+	 * as their parent, literals have a non-zero denominator and every variable refers to the next element in the
+	 * element area, which in turn refers to an existing block and contains valid indices in canonical order.
+	 *
+	 * @throws ImportException if the tree's data is corrupted or there is no tree at the given position
+	 */
+	[[nodiscard]] auto getTreeLayout(std::size_t position) const -> BinaryTreeLayout;
+
+	/**
+	 * Decodes the element at the given offset inside of the given element area (as obtained from getTreeLayout). As
+	 * getTreeLayout has already verified the elements, they are not checked again.
+	 *
+	 * @throws ImportException if the offset lies outside of the element area
+	 */
+	[[nodiscard]] auto readElement(std::string_view elements, std::size_t offset) const -> TensorElement;
+
+private:
+	/**
+	 * A position inside of a part of the data that reading is restricted to
+	 */
+	struct Cursor {
+		std::string_view data;
+		std::size_t position = 0;
+	};
+
+	std::string_view m_data;
+	std::string m_source;
+	std::vector< TensorBlock > m_blocks;
+	std::vector< TensorElement > m_results;
+	std::vector< std::size_t > m_offsets;
+	std::size_t m_treeSectionEnd = 0;
+	std::unordered_map< TensorElement, std::size_t > m_resultPositions;
+
+	template< typename T > auto read(Cursor &cursor) const -> T;
+
+	auto readBytes(Cursor &cursor, std::size_t count) const -> std::string_view;
+
+	/**
+	 * Reads the element the given cursor points to and verifies its data
+	 */
+	auto readElement(Cursor &cursor) const -> TensorElement;
+
+	/**
+	 * Reads the element the given cursor points to without verifying that its indices are in canonical order
+	 */
+	auto decodeElement(Cursor &cursor) const -> TensorElement;
+
+	/**
+	 * Moves the given cursor past the element it points to while verifying the element's data. Elements whose encoding
+	 * is contained in the given set have already been verified, and the encoding of newly verified ones is added to it.
+	 */
+	void skipElement(Cursor &cursor, std::unordered_set< std::string_view > &verified) const;
+
+	auto readBlockReference(Cursor &cursor) const -> const TensorBlock &;
+
+	auto readIndices(Cursor &cursor, const TensorBlock &block) const -> std::vector< Index >;
+
+	void verifyIndexOrder(const std::vector< Index > &indices, const TensorBlock &block) const;
+
+	[[noreturn]] void fail(std::string_view reason) const;
+};
+
+/**
+ * Decodes the node with the given ID from the given node records (as obtained from
+ * BinaryExpressionReader::getTreeLayout). The left child of a variable node is the offset of its element.
+ */
+auto decodeNode(std::string_view nodes, std::size_t nodeID) -> TreeNode;
+
+/**
+ * Maps the given binary expression file into memory
+ *
+ * @throws ImportException if the file can't be opened
+ */
+auto mapBinaryFile(const std::filesystem::path &filePath) -> MemoryMappedFile;
+
+/**
+ * @returns A view on the contents of the given mapped file
+ */
+auto viewContents(const MemoryMappedFile &file) -> std::string_view;
+
+} // namespace lizard
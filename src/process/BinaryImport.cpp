@@ -0,0 +1,89 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#include "lizard/process/BinaryImport.hpp"
+#include "BinaryFormat.hpp"
+#include "StableHasher.hpp"
+#include "lizard/core/MemoryMappedFile.hpp"
+#include "lizard/process/ImportException.hpp"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <utility>
+
+namespace lizard {
+
+BinaryImport::BinaryImport(std::filesystem::path filePath, std::vector< std::string > selectedResults)
+	: m_filePath(std::move(filePath)), m_selectedResults(std::move(selectedResults)) {
+}
+
+auto BinaryImport::getName() const -> std::string {
+	return "BinaryImport";
+}
+
+auto BinaryImport::getParameters() const -> std::string {
+	// Include the contents of the file such that cached imports are invalidated once the file changes
+	std::string parameters = fmt::format("content={}", hashFileContents(m_filePath));
+
+	if (!m_selectedResults.empty()) {
+		parameters += fmt::format(",results={}", fmt::join(m_selectedResults, ";"));
+	}
+
+	return parameters;
+}
+
+auto BinaryImport::getFilePath() const -> const std::filesystem::path & {
+	return m_filePath;
+}
+
+auto BinaryImport::getSelectedResults() const -> const std::vector< std::string > & {
+	return m_selectedResults;
+}
+
+auto BinaryImport::importExpressions(const IndexSpaceManager &manager) const -> std::vector< NamedTensorExprTree > {
+	const MemoryMappedFile file = mapBinaryFile(m_filePath);
+
+	std::vector< NamedTensorExprTree > expressions =
+		read(viewContents(file), manager, m_filePath.string(), m_selectedResults);
+
+	getLogger().info("Imported {} expressions from '{}'", expressions.size(), m_filePath.string());
+
+	return expressions;
+}
+
+auto BinaryImport::read(std::string_view data, const IndexSpaceManager &manager, std::string_view source,
+						nonstd::span< const std::string > selectedResults) -> std::vector< NamedTensorExprTree > {
+	BinaryExpressionReader reader(data, manager, std::string(source));
+
+	std::vector< bool > selected(reader.getTreeCount(), selectedResults.empty());
+	for (const std::string &currentName : selectedResults) {
+		bool found = false;
+
+		for (std::size_t i = 0; i < reader.getTreeCount(); ++i) {
+			if (reader.getResults()[i].getBlock().getTensor().getName() == currentName) {
+				selected[i] = true;
+				found       = true;
+			}
+		}
+
+		if (!found) {
+			throw ImportException(fmt::format("'{}' doesn't contain any expression for '{}'", source, currentName));
+		}
+	}
+
+	std::vector< NamedTensorExprTree > expressions;
+	expressions.reserve(static_cast< std::size_t >(std::count(selected.begin(), selected.end(), true)));
+
+	for (std::size_t i = 0; i < reader.getTreeCount(); ++i) {
+		if (selected[i]) {
+			expressions.push_back(reader.readTree(i));
+		}
+	}
+
+	return expressions;
+}
+
+} // namespace lizard
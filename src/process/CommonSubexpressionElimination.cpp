@@ -0,0 +1,240 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#include "Term.hpp"
+
+#include "lizard/format/FormatSupport.hpp"
+#include "lizard/process/CommonSubexpressionElimination.hpp"
+#include "lizard/symbolic/ExpressionOperator.hpp"
+#include "lizard/symbolic/ExpressionType.hpp"
+#include "lizard/symbolic/TreeNode.hpp"
+#include "lizard/symbolic/TreeTraversal.hpp"
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <map>
+#include <optional>
+#include <set>
+#include <string>
+#include <unordered_map>
+
+namespace lizard {
+
+/**
+ * A binary contraction (in canonical form) along with the number of times it has been encountered
+ */
+struct SharedContraction {
+	Term canonical;
+	std::size_t occurrences = 0;
+	std::optional< TensorElement > intermediate;
+};
+
+/**
+ * Collection of all binary contractions encountered in a set of expressions, which allows to look up contractions
+ * by their canonical form
+ */
+class ContractionCatalogue {
+public:
+	/**
+	 * @returns The entry for the given canonical contraction, or nullptr if it isn't part of this catalogue
+	 */
+	[[nodiscard]] auto find(const Term &canonical) -> SharedContraction * {
+		auto bucket = m_buckets.find(hashFactors(canonical));
+		if (bucket == m_buckets.end()) {
+			return nullptr;
+		}
+
+		for (std::size_t current : bucket->second) {
+			if (haveSameFactors(m_entries[current].canonical, canonical)) {
+				return &m_entries[current];
+			}
+		}
+
+		return nullptr;
+	}
+
+	/**
+	 * Records an occurrence of the given canonical contraction
+	 */
+	void record(const Term &canonical) {
+		if (SharedContraction *entry = find(canonical); entry != nullptr) {
+			entry->occurrences++;
+			return;
+		}
+
+		m_buckets[hashFactors(canonical)].push_back(m_entries.size());
+		m_entries.push_back({ canonical, 1, {} });
+	}
+
+	[[nodiscard]] auto entries() -> std::vector< SharedContraction > & { return m_entries; }
+
+private:
+	std::vector< SharedContraction > m_entries;
+	std::unordered_map< std::size_t, std::vector< std::size_t > > m_buckets;
+};
+
+auto isBinaryContraction(const ConstTensorExpr &expression) -> bool {
+	return expression.getType() == ExpressionType::Operator && expression.getOperator() == ExpressionOperator::Times
+		   && expression.getLeftArg().getType() == ExpressionType::Variable
+		   && expression.getRightArg().getType() == ExpressionType::Variable;
+}
+
+/**
+ * @returns Whether the given expression is a candidate for being replaced by a shared intermediate. The root of an
+ * expression tree is never considered as replacing it would only introduce an additional copy operation.
+ */
+auto isCandidate(const ConstTensorExpr &expression) -> bool {
+	return !expression.isRoot() && isBinaryContraction(expression);
+}
+
+auto toCanonicalTerm(const ConstTensorExpr &contraction, std::map< IndexName, Index::Id > *renaming = nullptr)
+	-> Term {
+	Term term;
+	term.factors = { contraction.getLeftArg().getVariable(), contraction.getRightArg().getVariable() };
+
+	std::map< IndexName, Index::Id > appliedRenaming = canonicalize(term, true);
+
+	if (renaming != nullptr) {
+		*renaming = std::move(appliedRenaming);
+	}
+
+	return term;
+}
+
+void replaceSharedContractions(const ConstTensorExpr &expression, TensorExprTree &tree,
+							   ContractionCatalogue &catalogue) {
+	if (isCandidate(expression)) {
+		std::map< IndexName, Index::Id > renaming;
+		const Term canonical = toCanonicalTerm(expression, &renaming);
+
+		if (const SharedContraction *entry = catalogue.find(canonical);
+			entry != nullptr && entry->intermediate.has_value()) {
+			// Map the canonical index names of the intermediate back to the names used in this occurrence
+			std::map< IndexName, Index::Id > originalIDs;
+			for (const auto &[originalName, newID] : renaming) {
+				originalIDs[{ newID, originalName.second }] = originalName.first;
+			}
+
+			std::vector< Index > indices(entry->intermediate->getIndices().begin(),
+										 entry->intermediate->getIndices().end());
+			for (Index &currentIndex : indices) {
+				currentIndex.setID(originalIDs.at(getName(currentIndex)));
+			}
+
+			auto [element, sign] = TensorElement::create(entry->intermediate->getBlock(), std::move(indices));
+
+			const Fraction prefactor = canonical.prefactor * sign;
+			if (prefactor != 1) {
+				tree.add(TreeNode(prefactor));
+			}
+			tree.add(std::move(element));
+			if (prefactor != 1) {
+				tree.add(TreeNode(ExpressionOperator::Times));
+			}
+
+			return;
+		}
+	}
+
+	switch (expression.getType()) {
+		case ExpressionType::Literal:
+			tree.add(TreeNode(expression.getLiteral()));
+			break;
+		case ExpressionType::Variable:
+			tree.add(expression.getVariable());
+			break;
+		case ExpressionType::Operator:
+			replaceSharedContractions(expression.getLeftArg(), tree, catalogue);
+			replaceSharedContractions(expression.getRightArg(), tree, catalogue);
+			tree.add(TreeNode(expression.getOperator()));
+			break;
+	}
+}
+
+auto CommonSubexpressionElimination::getName() const -> std::string {
+	return "CommonSubexpressionElimination";
+}
+
+void CommonSubexpressionElimination::process(std::vector< NamedTensorExprTree > &expressions,
+											 const IndexSpaceManager &manager) {
+	std::set< std::string, std::less<> > usedNames;
+	for (const NamedTensorExprTree &currentTree : expressions) {
+		usedNames.insert(std::string(currentTree.getResult().getBlock().getTensor().getName()));
+	}
+
+	std::size_t intermediateCounter = 1;
+	std::vector< NamedTensorExprTree > intermediates;
+
+	bool foundSharedContractions = true;
+	while (foundSharedContractions) {
+		ContractionCatalogue catalogue;
+
+		for (const NamedTensorExprTree &currentTree : expressions) {
+			if (currentTree.size() == 0) {
+				continue;
+			}
+
+			for (const ConstTensorExpr &currentExpr : currentTree) {
+				if (isCandidate(currentExpr)) {
+					catalogue.record(toCanonicalTerm(currentExpr));
+				}
+			}
+		}
+
+		foundSharedContractions = false;
+
+		for (SharedContraction &currentEntry : catalogue.entries()) {
+			if (currentEntry.occurrences < 2) {
+				continue;
+			}
+
+			std::string name;
+			do {
+				name = fmt::format("INTER_{:04d}", intermediateCounter++);
+			} while (usedNames.find(name) != usedNames.end());
+			usedNames.insert(name);
+
+			auto [result, sign] = TensorElement::create(Tensor(name), getOpenIndices(currentEntry.canonical), {});
+			(void) sign;
+
+			NamedTensorExprTree definition(result);
+			definition.add(currentEntry.canonical.factors[0]);
+			definition.add(currentEntry.canonical.factors[1]);
+			definition.add(TreeNode(ExpressionOperator::Times));
+
+			getLogger().debug("Introducing intermediate {} (used {} times)",
+							  NamedTensorExprTreeFormatter(definition, manager), currentEntry.occurrences);
+
+			intermediates.push_back(std::move(definition));
+			currentEntry.intermediate = std::move(result);
+			foundSharedContractions   = true;
+		}
+
+		if (!foundSharedContractions) {
+			break;
+		}
+
+		for (NamedTensorExprTree &currentTree : expressions) {
+			if (currentTree.size() == 0) {
+				continue;
+			}
+
+			TensorExprTree rewritten;
+			replaceSharedContractions(currentTree.getRoot(), rewritten, catalogue);
+
+			static_cast< TensorExprTree & >(currentTree) = std::move(rewritten);
+		}
+	}
+
+	getLogger().debug("Introduced {} shared intermediates", intermediates.size());
+
+	// Intermediates have to be computed before they are used and as intermediates only ever depend on previously
+	// created intermediates, prepending them (in order of creation) ensures that
+	expressions.insert(expressions.begin(), std::make_move_iterator(intermediates.begin()),
+					   std::make_move_iterator(intermediates.end()));
+}
+
+} // namespace lizard
@@ -0,0 +1,396 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#include "ContractionOrder.hpp"
+
+#include "lizard/symbolic/ExpressionOperator.hpp"
+#include "lizard/symbolic/TreeNode.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <tuple>
+
+namespace lizard {
+
+/**
+ * Bit mask representing a set of indices (or of operands)
+ */
+using Mask = std::uint64_t;
+
+constexpr const std::size_t MaxMaskSize = std::numeric_limits< Mask >::digits;
+
+/**
+ * Description of the indices that are involved in a given product
+ */
+class ContractionProblem {
+public:
+	ContractionProblem(const std::vector< TensorElement > &operands, nonstd::span< const Index > externals,
+					   const CostModel &model)
+		: m_model(&model) {
+		std::map< IndexName, std::size_t > localIDs;
+
+		for (const TensorElement &currentOperand : operands) {
+			Mask mask = 0;
+			for (const Index &currentIndex : currentOperand.getIndices()) {
+				auto iter = localIDs.find(getName(currentIndex));
+				if (iter == localIDs.end()) {
+					iter = localIDs.insert({ getName(currentIndex), m_sizes.size() }).first;
+					m_indices.push_back(currentIndex);
+					m_sizes.push_back(model.getSize(currentIndex.getSpace()));
+					m_occurrences.push_back(0);
+				}
+
+				if (iter->second < MaxMaskSize) {
+					mask |= Mask(1) << iter->second;
+				}
+				m_occurrences[iter->second]++;
+			}
+
+			m_operandIndices.push_back(mask);
+		}
+
+		// Indices that don't get summed over within the product itself, have to be retained until the end
+		for (std::size_t i = 0; i < m_occurrences.size() && i < MaxMaskSize; ++i) {
+			if (m_occurrences[i] == 1) {
+				m_externals |= Mask(1) << i;
+			}
+		}
+		for (const Index &currentIndex : externals) {
+			if (auto iter = localIDs.find(getName(currentIndex));
+				iter != localIDs.end() && iter->second < MaxMaskSize) {
+				m_externals |= Mask(1) << iter->second;
+			}
+		}
+	}
+
+	/**
+	 * @returns Whether the problem is small enough to be represented by means of bit masks
+	 */
+	[[nodiscard]] auto isRepresentable() const -> bool {
+		return m_sizes.size() <= MaxMaskSize && m_operandIndices.size() < MaxMaskSize;
+	}
+
+	[[nodiscard]] auto operandCount() const -> std::size_t { return m_operandIndices.size(); }
+
+	/**
+	 * @returns The indices that remain after all operands in the given set have been contracted with one another
+	 */
+	[[nodiscard]] auto getOpenIndices(Mask operands) const -> Mask {
+		Mask contained = 0;
+		for (std::size_t i = 0; i < m_operandIndices.size(); ++i) {
+			if ((operands & (Mask(1) << i)) != 0) {
+				contained |= m_operandIndices[i];
+			}
+		}
+
+		Mask open = contained & m_externals;
+		for (std::size_t i = 0; i < m_sizes.size(); ++i) {
+			const Mask current = Mask(1) << i;
+			if ((contained & current) == 0 || (open & current) != 0) {
+				continue;
+			}
+
+			std::size_t count = 0;
+			for (std::size_t k = 0; k < m_operandIndices.size(); ++k) {
+				if ((operands & (Mask(1) << k)) != 0 && (m_operandIndices[k] & current) != 0) {
+					count++;
+				}
+			}
+
+			if (count < m_occurrences[i]) {
+				// Some operands outside of the given set still require this index
+				open |= current;
+			}
+		}
+
+		return open;
+	}
+
+	/**
+	 * @returns The number of elements of a tensor that carries the given indices
+	 */
+	[[nodiscard]] auto getSize(Mask indices) const -> double {
+		double size = 1;
+		for (std::size_t i = 0; i < m_sizes.size(); ++i) {
+			if ((indices & (Mask(1) << i)) != 0) {
+				size *= m_sizes[i];
+			}
+		}
+
+		return size;
+	}
+
+	/**
+	 * @returns The number of floating point operations required for contracting the two given (disjoint) sets of
+	 * operands with one another, after each of them has been contracted on its own
+	 */
+	[[nodiscard]] auto getContractionFlops(Mask lhs, Mask rhs) const -> double {
+		return getSize(getOpenIndices(lhs) | getOpenIndices(rhs));
+	}
+
+	/**
+	 * @returns The cost of contracting the two given (disjoint) sets of operands with one another, after each of
+	 * them has been contracted on its own
+	 */
+	[[nodiscard]] auto getContractionCost(Mask lhs, Mask rhs) const -> ExpressionCost {
+		const Mask involved = getOpenIndices(lhs) | getOpenIndices(rhs);
+
+		std::vector< Index > involvedIndices;
+		for (std::size_t i = 0; i < m_indices.size(); ++i) {
+			if ((involved & (Mask(1) << i)) != 0) {
+				involvedIndices.push_back(m_indices[i]);
+			}
+		}
+
+		ExpressionCost cost       = m_model->estimateOperation(involvedIndices);
+		cost.peakIntermediateSize = getSize(getOpenIndices(lhs | rhs));
+
+		return cost;
+	}
+
+private:
+	const CostModel *m_model;
+	std::vector< Index > m_indices;
+	std::vector< double > m_sizes;
+	std::vector< std::size_t > m_occurrences;
+	std::vector< Mask > m_operandIndices;
+	Mask m_externals = 0;
+};
+
+auto combine(const ExpressionCost &lhs, const ExpressionCost &rhs, const ExpressionCost &contraction)
+	-> ExpressionCost {
+	ExpressionCost combined = lhs;
+	combined += rhs;
+	combined += contraction;
+
+	return combined;
+}
+
+/**
+ * Determines the optimal contraction order by means of dynamic programming over all subsets of operands
+ */
+auto findOptimalOrder(const ContractionProblem &problem, std::vector< PlanNode > &plan) -> ExpressionCost {
+	const std::size_t nOperands = problem.operandCount();
+	const Mask fullSet          = (Mask(1) << nOperands) - 1;
+
+	std::vector< ExpressionCost > costs(fullSet + 1);
+	std::vector< Mask > splits(fullSet + 1, 0);
+
+	for (Mask subset = 1; subset <= fullSet; ++subset) {
+		if ((subset & (subset - 1)) == 0) {
+			// Single operand -> nothing to contract
+			continue;
+		}
+
+		// In order to not consider every split twice, the lowest operand is always part of the left operand
+		const Mask lowest       = subset & (~subset + 1);
+		const double resultSize = problem.getSize(problem.getOpenIndices(subset));
+		bool isFirst            = true;
+
+		for (Mask left = (subset - 1) & subset; left != 0; left = (left - 1) & subset) {
+			if ((left & lowest) == 0) {
+				continue;
+			}
+
+			const Mask right = subset & ~left;
+
+			// Only compare flops and intermediate sizes here and assemble the full cost for improvements only
+			const double flops = costs[left].flops + costs[right].flops + problem.getContractionFlops(left, right);
+			const double peak =
+				std::max({ costs[left].peakIntermediateSize, costs[right].peakIntermediateSize, resultSize });
+
+			if (isFirst
+				|| std::tie(flops, peak) < std::tie(costs[subset].flops, costs[subset].peakIntermediateSize)) {
+				costs[subset]  = combine(costs[left], costs[right], problem.getContractionCost(left, right));
+				splits[subset] = left;
+				isFirst        = false;
+			}
+		}
+	}
+
+	// Translate the found splits into a contraction plan
+	auto addToPlan = [&](Mask subset, auto &self) -> std::size_t {
+		PlanNode node;
+
+		if ((subset & (subset - 1)) == 0) {
+			node.operand = 0;
+			while ((subset & (Mask(1) << node.operand)) == 0) {
+				node.operand++;
+			}
+		} else {
+			node.left  = self(splits[subset], self);
+			node.right = self(subset & ~splits[subset], self);
+		}
+
+		plan.push_back(node);
+		return plan.size() - 1;
+	};
+
+	addToPlan(fullSet, addToPlan);
+
+	return costs[fullSet];
+}
+
+/**
+ * Determines a contraction order by always performing the cheapest of the currently possible contractions next
+ */
+auto findGreedyOrder(const ContractionProblem &problem, std::vector< PlanNode > &plan) -> ExpressionCost {
+	struct Operand {
+		Mask members;
+		std::size_t planIndex;
+		ExpressionCost cost;
+	};
+
+	std::vector< Operand > operands;
+	for (std::size_t i = 0; i < problem.operandCount(); ++i) {
+		PlanNode node;
+		node.operand = i;
+		plan.push_back(node);
+
+		operands.push_back({ Mask(1) << i, plan.size() - 1, {} });
+	}
+
+	while (operands.size() > 1) {
+		std::size_t bestLeft  = 0;
+		std::size_t bestRight = 1;
+		ExpressionCost bestCost;
+		bool isFirst = true;
+
+		for (std::size_t i = 0; i < operands.size(); ++i) {
+			for (std::size_t j = i + 1; j < operands.size(); ++j) {
+				ExpressionCost candidate = problem.getContractionCost(operands[i].members, operands[j].members);
+
+				if (isFirst || candidate < bestCost) {
+					bestLeft  = i;
+					bestRight = j;
+					bestCost  = candidate;
+					isFirst   = false;
+				}
+			}
+		}
+
+		PlanNode node;
+		node.left  = operands[bestLeft].planIndex;
+		node.right = operands[bestRight].planIndex;
+		plan.push_back(node);
+
+		operands[bestLeft] = { operands[bestLeft].members | operands[bestRight].members, plan.size() - 1,
+							   combine(operands[bestLeft].cost, operands[bestRight].cost, bestCost) };
+		operands.erase(operands.begin() + static_cast< std::ptrdiff_t >(bestRight));
+	}
+
+	return operands.front().cost;
+}
+
+/**
+ * Creates a plan that contracts the operands from left to right
+ */
+void createSequentialPlan(std::size_t nOperands, std::vector< PlanNode > &plan) {
+	for (std::size_t i = 0; i < nOperands; ++i) {
+		PlanNode node;
+		node.operand = i;
+		plan.push_back(node);
+
+		if (i > 0) {
+			PlanNode contraction;
+			contraction.left  = plan.size() - 2;
+			contraction.right = plan.size() - 1;
+			plan.push_back(contraction);
+		}
+	}
+}
+
+auto getOperands(const Term &term) -> std::vector< TensorElement > {
+	std::vector< TensorElement > operands = term.factors;
+
+	for (const TensorExprTree &currentCompound : term.compoundFactors) {
+		auto [placeholder, sign] =
+			TensorElement::create(Tensor("Compound"), getOpenIndices(splitIntoTerms(currentCompound.getRoot())[0]), {});
+		(void) sign;
+
+		operands.push_back(std::move(placeholder));
+	}
+
+	return operands;
+}
+
+auto planContraction(const Term &term, nonstd::span< const Index > externals, const CostModel &model,
+					 std::size_t exhaustiveSearchLimit, std::vector< PlanNode > &plan) -> ExpressionCost {
+	const std::vector< TensorElement > operands = getOperands(term);
+	const ContractionProblem problem(operands, externals, model);
+
+	ExpressionCost cost;
+	if (operands.size() < 2) {
+		// Terms without any operands (e.g. plain literals) or with a single one don't involve a contraction and
+		// therefore don't need a plan
+	} else if (!problem.isRepresentable()) {
+		createSequentialPlan(operands.size(), plan);
+	} else if (operands.size() <= std::min(exhaustiveSearchLimit, MaxExhaustiveSearchLimit)) {
+		cost = findOptimalOrder(problem, plan);
+	} else {
+		cost = findGreedyOrder(problem, plan);
+	}
+
+	// Add the cost for evaluating the compound factors themselves
+	for (std::size_t i = 0; i < term.compoundFactors.size(); ++i) {
+		const TensorElement &placeholder   = operands[term.factors.size() + i];
+		const std::vector< Term > addends = splitIntoTerms(term.compoundFactors[i].getRoot());
+
+		for (const Term &currentAddend : addends) {
+			cost += estimateCost(currentAddend, placeholder.getIndices(), model);
+		}
+
+		// Adding up the individual addends
+		ExpressionCost summation = model.estimateOperation(placeholder.getIndices());
+		summation.flops *= static_cast< double >(addends.size() - 1);
+		summation.peakIntermediateSize = summation.dominantFlops;
+
+		cost += summation;
+	}
+
+	return cost;
+}
+
+auto estimateCost(const Term &term, nonstd::span< const Index > externals, const CostModel &model)
+	-> ExpressionCost {
+	std::vector< PlanNode > plan;
+	return planContraction(term, externals, model, DefaultExhaustiveSearchLimit, plan);
+}
+
+void appendPlanNode(TensorExprTree &tree, const Term &term, const std::vector< PlanNode > &plan, std::size_t node) {
+	if (plan[node].operand != PlanNode::NoOperand) {
+		if (plan[node].operand < term.factors.size()) {
+			tree.add(term.factors[plan[node].operand]);
+		} else {
+			appendExpression(tree, term.compoundFactors[plan[node].operand - term.factors.size()].getRoot());
+		}
+
+		return;
+	}
+
+	appendPlanNode(tree, term, plan, plan[node].left);
+	appendPlanNode(tree, term, plan, plan[node].right);
+	tree.add(TreeNode(ExpressionOperator::Times));
+}
+
+void appendPlannedTerm(TensorExprTree &tree, const Term &term, const std::vector< PlanNode > &plan) {
+	if (plan.empty()) {
+		appendTerm(tree, term);
+		return;
+	}
+
+	if (term.prefactor != 1) {
+		tree.add(TreeNode(term.prefactor));
+	}
+
+	appendPlanNode(tree, term, plan, plan.size() - 1);
+
+	if (term.prefactor != 1) {
+		tree.add(TreeNode(ExpressionOperator::Times));
+	}
+}
+
+} // namespace lizard
@@ -0,0 +1,79 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#pragma once
+
+#include "Term.hpp"
+
+#include "lizard/process/CostModel.hpp"
+#include "lizard/symbolic/Index.hpp"
+#include "lizard/symbolic/TensorExpressions.hpp"
+
+#include <nonstd/span.hpp>
+
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace lizard {
+
+/**
+ * Node in a contraction plan that either refers to one of the operands of a term or to the contraction of two other
+ * nodes in the plan
+ */
+struct PlanNode {
+	static constexpr const std::size_t NoOperand = std::numeric_limits< std::size_t >::max();
+
+	std::size_t operand = NoOperand;
+	std::size_t left    = 0;
+	std::size_t right   = 0;
+};
+
+/**
+ * Default number of operands up to which contraction orders are optimized exhaustively
+ */
+constexpr const std::size_t DefaultExhaustiveSearchLimit = 8;
+
+/**
+ * Largest supported number of operands for an exhaustive search. The search tabulates the cost of every subset of
+ * operands, so its memory consumption doubles with every additional operand.
+ */
+constexpr const std::size_t MaxExhaustiveSearchLimit = 16;
+
+/**
+ * @returns The operands of the given term, which are its factors followed by one placeholder element per compound
+ * factor. The placeholders carry the open indices of the respective compound factor.
+ */
+[[nodiscard]] auto getOperands(const Term &term) -> std::vector< TensorElement >;
+
+/**
+ * Determines the order in which the operands of the given term should be contracted such that the estimated cost
+ * becomes minimal. The returned cost includes the cost of evaluating all compound factors of the term.
+ *
+ * @param term The term to consider
+ * @param externals The indices that must not be summed over (usually the indices of the result tensor)
+ * @param model The CostModel used to estimate the cost of the individual contractions
+ * @param exhaustiveSearchLimit The maximum number of operands for which an exhaustive search is performed. For larger
+ * terms, a greedy approach is used instead. Values beyond MaxExhaustiveSearchLimit are treated as
+ * MaxExhaustiveSearchLimit.
+ * @param plan The plan to which the chosen contraction order is written. Its last node represents the full product.
+ * Terms with less than two operands don't involve any contraction, so no plan is written for them.
+ * @returns The estimated cost of evaluating the given term
+ */
+auto planContraction(const Term &term, nonstd::span< const Index > externals, const CostModel &model,
+					 std::size_t exhaustiveSearchLimit, std::vector< PlanNode > &plan) -> ExpressionCost;
+
+/**
+ * @returns The estimated cost of evaluating the given term in the optimal contraction order
+ */
+[[nodiscard]] auto estimateCost(const Term &term, nonstd::span< const Index > externals, const CostModel &model)
+	-> ExpressionCost;
+
+/**
+ * Appends the given term to the given tree, using the contraction order specified by the given plan
+ */
+void appendPlannedTerm(TensorExprTree &tree, const Term &term, const std::vector< PlanNode > &plan);
+
+} // namespace lizard
@@ -0,0 +1,217 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#include "Term.hpp"
+
+#include "lizard/process/CostModel.hpp"
+#include "lizard/symbolic/ExpressionOperator.hpp"
+#include "lizard/symbolic/IndexSpaceData.hpp"
+#include "lizard/symbolic/IndexSpaceManager.hpp"
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <tuple>
+
+namespace lizard {
+
+void Scaling::add(const IndexSpace &space, unsigned int exponent) {
+	m_exponents[space.getID()] += exponent;
+}
+
+auto Scaling::getExponent(const IndexSpace &space) const -> unsigned int {
+	auto iter = m_exponents.find(space.getID());
+
+	return iter == m_exponents.end() ? 0 : iter->second;
+}
+
+auto Scaling::getTotalExponent() const -> unsigned int {
+	unsigned int total = 0;
+	for (const auto &[space, exponent] : m_exponents) {
+		total += exponent;
+	}
+
+	return total;
+}
+
+auto Scaling::toString(const IndexSpaceManager &manager) const -> std::string {
+	if (m_exponents.empty()) {
+		return "1";
+	}
+
+	std::string representation;
+	for (const auto &[space, exponent] : m_exponents) {
+		if (!representation.empty()) {
+			representation += " ";
+		}
+
+		representation += manager.getData(IndexSpace(space, Spin::None)).getShortName();
+		if (exponent > 1) {
+			representation += fmt::format("^{}", exponent);
+		}
+	}
+
+	return representation;
+}
+
+auto operator==(const Scaling &lhs, const Scaling &rhs) -> bool {
+	return lhs.m_exponents == rhs.m_exponents;
+}
+
+auto operator!=(const Scaling &lhs, const Scaling &rhs) -> bool {
+	return !(lhs == rhs);
+}
+
+auto ExpressionCost::operator+=(const ExpressionCost &other) -> ExpressionCost & {
+	flops += other.flops;
+	peakIntermediateSize = std::max(peakIntermediateSize, other.peakIntermediateSize);
+
+	if (other.dominantFlops > dominantFlops) {
+		dominantFlops = other.dominantFlops;
+		scaling       = other.scaling;
+	}
+
+	return *this;
+}
+
+auto operator<(const ExpressionCost &lhs, const ExpressionCost &rhs) -> bool {
+	return std::tie(lhs.flops, lhs.peakIntermediateSize) < std::tie(rhs.flops, rhs.peakIntermediateSize);
+}
+
+CostModel::CostModel(const IndexSpaceManager &manager) : m_manager(&manager) {
+}
+
+auto CostModel::estimate(const TensorExprTree &tree, nonstd::span< const Index > externals) const -> ExpressionCost {
+	ExpressionCost cost;
+
+	if (tree.size() > 0) {
+		estimateExpression(tree.getRoot(), externals, cost);
+	}
+
+	return cost;
+}
+
+auto CostModel::estimate(const NamedTensorExprTree &tree) const -> ExpressionCost {
+	return estimate(tree, tree.getResult().getIndices());
+}
+
+auto CostModel::estimate(nonstd::span< const NamedTensorExprTree > expressions) const -> CostReport {
+	CostReport report;
+	report.expressions.reserve(expressions.size());
+
+	for (const NamedTensorExprTree &currentTree : expressions) {
+		report.expressions.push_back(estimate(currentTree));
+		report.total += report.expressions.back();
+	}
+
+	return report;
+}
+
+auto CostModel::estimateOperation(nonstd::span< const Index > involvedIndices) const -> ExpressionCost {
+	ExpressionCost cost;
+	cost.flops         = getSize(involvedIndices);
+	cost.dominantFlops = cost.flops;
+
+	for (const Index &currentIndex : involvedIndices) {
+		cost.scaling.add(currentIndex.getSpace());
+	}
+
+	return cost;
+}
+
+auto CostModel::getSize(const IndexSpace &space) const -> double {
+	return static_cast< double >(m_manager->getData(space).getSize());
+}
+
+auto CostModel::getSize(nonstd::span< const Index > indices) const -> double {
+	double size = 1;
+	for (const Index &currentIndex : indices) {
+		size *= getSize(currentIndex.getSpace());
+	}
+
+	return size;
+}
+
+/**
+ * @returns The given indices with every index only listed once
+ */
+auto getDistinctIndices(const std::vector< Index > &indices) -> std::vector< Index > {
+	std::vector< Index > distinct;
+	for (const Index &currentIndex : indices) {
+		if (std::none_of(distinct.begin(), distinct.end(),
+						 [&](const Index &other) { return getName(other) == getName(currentIndex); })) {
+			distinct.push_back(currentIndex);
+		}
+	}
+
+	return distinct;
+}
+
+/**
+ * @returns The indices out of the given ones that are not summed over
+ */
+auto getUncontractedIndices(const std::vector< Index > &indices, nonstd::span< const Index > externals)
+	-> std::vector< Index > {
+	std::vector< Index > open;
+	for (const Index &currentIndex : indices) {
+		const IndexName name = getName(currentIndex);
+
+		const auto count = std::count_if(indices.begin(), indices.end(),
+										 [&](const Index &other) { return getName(other) == name; });
+		const bool isExternal = std::any_of(externals.begin(), externals.end(),
+											[&](const Index &other) { return getName(other) == name; });
+
+		if (count == 1
+			|| (isExternal && std::none_of(open.begin(), open.end(),
+										   [&](const Index &other) { return getName(other) == name; }))) {
+			open.push_back(currentIndex);
+		}
+	}
+
+	return open;
+}
+
+auto CostModel::estimateExpression(const ConstTensorExpr &expression, nonstd::span< const Index > externals,
+								   ExpressionCost &cost) const -> std::vector< Index > {
+	std::vector< Index > open;
+
+	switch (expression.getType()) {
+		case ExpressionType::Literal:
+			return open;
+		case ExpressionType::Variable: {
+			const nonstd::span< const Index > indices = expression.getVariable().getIndices();
+
+			return getUncontractedIndices(std::vector< Index >(indices.begin(), indices.end()), externals);
+		}
+		case ExpressionType::Operator:
+			break;
+	}
+
+	std::vector< Index > lhs = estimateExpression(expression.getLeftArg(), externals, cost);
+	std::vector< Index > rhs = estimateExpression(expression.getRightArg(), externals, cost);
+
+	switch (expression.getOperator()) {
+		case ExpressionOperator::Plus:
+			// Both addends carry the same indices
+			open = std::move(lhs);
+			cost += estimateOperation(open);
+			break;
+		case ExpressionOperator::Times: {
+			std::vector< Index > involved = std::move(lhs);
+			involved.insert(involved.end(), rhs.begin(), rhs.end());
+
+			open = getUncontractedIndices(involved, externals);
+			cost += estimateOperation(getDistinctIndices(involved));
+		} break;
+	}
+
+	if (!expression.isRoot()) {
+		cost.peakIntermediateSize = std::max(cost.peakIntermediateSize, getSize(open));
+	}
+
+	return open;
+}
+
+} // namespace lizard
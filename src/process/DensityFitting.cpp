@@ -0,0 +1,185 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#include "Term.hpp"
+
+#include "lizard/format/FormatSupport.hpp"
+#include "lizard/process/DensityFitting.hpp"
+#include "lizard/process/ProcessingException.hpp"
+#include "lizard/symbolic/IndexSpaceManager.hpp"
+#include "lizard/symbolic/InvalidIndexSpaceException.hpp"
+
+#include <libperm/Cycle.hpp>
+#include <libperm/ExplicitPermutation.hpp>
+#include <libperm/PrimitivePermutationGroup.hpp>
+
+#include <fmt/core.h>
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <exception>
+#include <iterator>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace lizard {
+
+DensityFitting::DensityFitting(std::string auxiliarySpace, std::string integralTensor, std::string factorTensor)
+	: m_auxiliarySpace(std::move(auxiliarySpace)), m_integralTensor(std::move(integralTensor)),
+	  m_factorTensor(std::move(factorTensor)) {
+}
+
+auto DensityFitting::getName() const -> std::string {
+	return "DensityFitting";
+}
+
+auto DensityFitting::getParameters() const -> std::string {
+	return fmt::format("auxiliarySpace={},integralTensor={},factorTensor={}", m_auxiliarySpace, m_integralTensor,
+					   m_factorTensor);
+}
+
+void DensityFitting::process(std::vector< NamedTensorExprTree > &expressions, const IndexSpaceManager &manager) {
+	IndexSpace auxiliarySpace;
+	try {
+		auxiliarySpace = manager.createFromName(m_auxiliarySpace);
+	} catch (const InvalidIndexSpaceException &) {
+		std::vector< std::string > registeredNames;
+		for (const IndexSpace &currentSpace : manager.getRegisteredSpaces()) {
+			registeredNames.push_back(manager.getData(currentSpace).getName());
+		}
+
+		std::throw_with_nested(ProcessingException(
+			fmt::format("Density fitting requires the auxiliary index space '{}', which has not been registered with "
+						"the IndexSpaceManager (registered spaces: {})",
+						m_auxiliarySpace, fmt::join(registeredNames, ", "))));
+	}
+
+	if (auxiliarySpace.getSpin() != Spin::None) {
+		throw ProcessingException(
+			fmt::format("Density fitting requires the auxiliary index space '{}' to be spin-free", m_auxiliarySpace));
+	}
+
+	std::size_t totalCount = 0;
+
+	for (NamedTensorExprTree &currentTree : expressions) {
+		if (currentTree.size() == 0) {
+			continue;
+		}
+
+		// Fresh auxiliary indices must not clash with any that are already in use
+		Index::Id nextID = 0;
+		for (const ConstTensorExpr &currentExpr : currentTree) {
+			if (currentExpr.getType() != ExpressionType::Variable) {
+				continue;
+			}
+
+			for (const Index &currentIndex : currentExpr.getVariable().getIndices()) {
+				if (currentIndex.getSpace().getID() == auxiliarySpace.getID()) {
+					nextID = std::max(nextID, static_cast< Index::Id >(currentIndex.getID() + 1));
+				}
+			}
+		}
+
+		std::size_t substitutionCount = 0;
+		TensorExprTree substituted    = substitute(currentTree.getRoot(), auxiliarySpace, nextID, substitutionCount);
+
+		if (substitutionCount == 0) {
+			continue;
+		}
+
+		getLogger().debug("Substituted {} integrals in expression for {}", substitutionCount,
+						  TensorElementFormatter(currentTree.getResult(), manager));
+
+		static_cast< TensorExprTree & >(currentTree) = std::move(substituted);
+		totalCount += substitutionCount;
+	}
+
+	getLogger().info("Applied density-fitting to {} integrals", totalCount);
+}
+
+auto DensityFitting::isIntegral(const TensorElement &element) const -> bool {
+	if (element.getBlock().getTensor().getName() != m_integralTensor) {
+		return false;
+	}
+
+	const nonstd::span< const Index > indices = element.getIndices();
+
+	// Due to the hermiticity of the integrals, the annihilators may also be listed before the creators
+	return indices.size() == 4 && indices[0].getType() != IndexType::External
+		   && indices[0].getType() == indices[1].getType() && indices[2].getType() == indices[3].getType()
+		   && indices[0].getType() != indices[2].getType();
+}
+
+auto DensityFitting::createFactor(const Index &auxiliary, const Index &first, const Index &second) const
+	-> TensorElement {
+	// For real orbitals, (pq|P) = (qp|P). As this symmetry is symmetric, creating the element never changes its sign.
+	perm::PrimitivePermutationGroup symmetry;
+	symmetry.addGenerator(perm::ExplicitPermutation(perm::Cycle({ 1, 2 })));
+
+	return std::get< 0 >(
+		TensorElement::create(Tensor(m_factorTensor), { auxiliary, first, second }, std::move(symmetry)));
+}
+
+auto DensityFitting::substitute(const ConstTensorExpr &expression, const IndexSpace &auxiliarySpace,
+								Index::Id &nextID, std::size_t &substitutionCount) const -> TensorExprTree {
+	std::vector< Term > substitutedTerms;
+
+	for (const Term &currentTerm : splitIntoTerms(expression)) {
+		// Every integral turns a term into two, so we have to keep track of all terms produced from the current one
+		std::vector< Term > expanded = { Term{ currentTerm.prefactor, {}, {} } };
+
+		for (const TensorElement &currentFactor : currentTerm.factors) {
+			if (!isIntegral(currentFactor)) {
+				for (Term &currentExpanded : expanded) {
+					currentExpanded.factors.push_back(currentFactor);
+				}
+
+				continue;
+			}
+
+			const nonstd::span< const Index > indices = currentFactor.getIndices();
+			const Index auxiliary(nextID++, auxiliarySpace, IndexType::External);
+
+			std::vector< Term > next;
+			next.reserve(2 * expanded.size());
+
+			for (const Term &currentExpanded : expanded) {
+				// <pq||rs> = <pq|rs> - <pq|sr> = (pr|qs) - (ps|qr)
+				Term coulomb = currentExpanded;
+				coulomb.factors.push_back(createFactor(auxiliary, indices[0], indices[2]));
+				coulomb.factors.push_back(createFactor(auxiliary, indices[1], indices[3]));
+
+				Term exchange = currentExpanded;
+				exchange.prefactor *= -1;
+				exchange.factors.push_back(createFactor(auxiliary, indices[0], indices[3]));
+				exchange.factors.push_back(createFactor(auxiliary, indices[1], indices[2]));
+
+				next.push_back(std::move(coulomb));
+				next.push_back(std::move(exchange));
+			}
+
+			expanded = std::move(next);
+			substitutionCount++;
+		}
+
+		for (const TensorExprTree &currentCompound : currentTerm.compoundFactors) {
+			const TensorExprTree substitutedCompound =
+				substitute(currentCompound.getRoot(), auxiliarySpace, nextID, substitutionCount);
+
+			for (Term &currentExpanded : expanded) {
+				currentExpanded.compoundFactors.push_back(substitutedCompound);
+			}
+		}
+
+		substitutedTerms.insert(substitutedTerms.end(), std::make_move_iterator(expanded.begin()),
+								std::make_move_iterator(expanded.end()));
+	}
+
+	return buildSum(substitutedTerms);
+}
+
+} // namespace lizard
@@ -0,0 +1,203 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#include "lizard/process/ExpressionCache.hpp"
+#include "BinaryFormat.hpp"
+#include "StableHasher.hpp"
+#include "lizard/core/Exception.hpp"
+#include "lizard/core/MemoryMappedFile.hpp"
+#include "lizard/process/BinaryExport.hpp"
+#include "lizard/process/BinaryImport.hpp"
+#include "lizard/process/ProcessingException.hpp"
+#include "lizard/process/Strategy.hpp"
+#include "lizard/symbolic/IndexSpaceManager.hpp"
+
+#include <libperm/Permutation.hpp>
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+namespace lizard {
+
+/**
+ * Version of the cache layout. Incrementing it invalidates all existing cache entries.
+ */
+constexpr const std::uint32_t CacheVersion = 2;
+
+constexpr const std::string_view CompletionMarker = "complete";
+
+/**
+ * The name of the file (written by BinaryExport) holding the expressions of a cache entry
+ */
+constexpr const std::string_view ExpressionFile = "expressions.lzb";
+
+void hashElement(StableHasher &hasher, const TensorElement &element, std::vector< IndexSpace > &referencedSpaces) {
+	hasher.add(element.getBlock().getTensor().getName());
+	hasher.add(element.getIndices().size());
+
+	for (const Index &current : element.getIndices()) {
+		hasher.add(current.getID());
+		hasher.add(current.getSpace().getID());
+		hasher.add(current.getSpace().getSpin());
+		hasher.add(current.getType());
+
+		if (std::find_if(referencedSpaces.begin(), referencedSpaces.end(), IndexSpace::FindByID{ current.getSpace() })
+			== referencedSpaces.end()) {
+			referencedSpaces.push_back(current.getSpace());
+		}
+	}
+
+	// The order in which the group elements are listed is an implementation detail of the permutation library and
+	// therefore we bring them into a well-defined order before hashing them
+	std::vector< perm::Permutation > symmetryElements;
+	element.getBlock().getSlotSymmetry().getElementsTo(symmetryElements);
+
+	std::vector< std::vector< int > > representations;
+	representations.reserve(symmetryElements.size());
+	for (const perm::Permutation &currentPerm : symmetryElements) {
+		std::vector< int > representation = { currentPerm->sign() };
+		for (std::size_t i = 0; i < element.getIndices().size(); ++i) {
+			representation.push_back(
+				static_cast< int >(currentPerm->image(static_cast< perm::Permutation::value_type >(i))));
+		}
+		representations.push_back(std::move(representation));
+	}
+	std::sort(representations.begin(), representations.end());
+
+	hasher.add(representations.size());
+	for (const std::vector< int > &current : representations) {
+		for (int value : current) {
+			hasher.add(value);
+		}
+	}
+}
+
+auto ExpressionCache::computeKey(nonstd::span< const NamedTensorExprTree > input, const Strategy &strategy,
+								 const IndexSpaceManager &manager) -> std::string {
+	StableHasher hasher;
+	std::vector< IndexSpace > referencedSpaces;
+
+	hasher.add(CacheVersion);
+	hasher.add(strategy.getType());
+	hasher.add(strategy.getName());
+	hasher.add(strategy.getParameters());
+
+	hasher.add(input.size());
+	for (const NamedTensorExprTree &currentTree : input) {
+		hashElement(hasher, currentTree.getResult(), referencedSpaces);
+
+		hasher.add(currentTree.size());
+		if (currentTree.size() == 0) {
+			continue;
+		}
+
+		for (const ConstTensorExpr &currentExpr : currentTree) {
+			hasher.add(currentExpr.getType());
+
+			switch (currentExpr.getType()) {
+				case ExpressionType::Operator:
+					hasher.add(currentExpr.getOperator());
+					break;
+				case ExpressionType::Literal:
+					hasher.add(currentExpr.getLiteral().getNumerator());
+					hasher.add(currentExpr.getLiteral().getDenominator());
+					break;
+				case ExpressionType::Variable:
+					hashElement(hasher, currentExpr.getVariable(), referencedSpaces);
+					break;
+			}
+		}
+	}
+
+	// Importers don't have any input expressions, but they do depend on all of the known index spaces
+	std::vector< IndexSpace > relevantSpaces = input.empty() ? manager.getRegisteredSpaces() : referencedSpaces;
+	std::sort(relevantSpaces.begin(), relevantSpaces.end());
+
+	for (const IndexSpace &currentSpace : relevantSpaces) {
+		const IndexSpaceData &data = manager.getData(currentSpace);
+
+		hasher.add(currentSpace.getID());
+		hasher.add(data.getName());
+		hasher.add(data.getShortName());
+		hasher.add(data.getSize());
+		hasher.add(data.getDefaultSpin());
+		hasher.add(std::string_view(data.getLabels().data(), data.getLabels().size()));
+		hasher.add(data.getLabelExtension());
+	}
+
+	return fmt::format("{:016x}", hasher.getHash());
+}
+
+ExpressionCache::ExpressionCache(std::filesystem::path directory) : m_directory(std::move(directory)) {
+	std::error_code errorCode;
+	std::filesystem::create_directories(m_directory, errorCode);
+
+	if (errorCode) {
+		throw ProcessingException(
+			fmt::format("Can't create cache directory '{}': {}", m_directory.string(), errorCode.message()));
+	}
+}
+
+auto ExpressionCache::contains(const std::string &key) const -> bool {
+	return std::filesystem::is_regular_file(m_directory / key / CompletionMarker);
+}
+
+auto ExpressionCache::load(const std::string &key, const IndexSpaceManager &manager) const
+	-> std::optional< std::vector< NamedTensorExprTree > > {
+	if (!contains(key)) {
+		return {};
+	}
+
+	const std::filesystem::path filePath = m_directory / key / ExpressionFile;
+
+	try {
+		const MemoryMappedFile file = mapBinaryFile(filePath);
+
+		return BinaryImport::read(viewContents(file), manager, filePath.string());
+	} catch (const Exception &) {
+		// Corrupted cache entries are treated as not being cached at all
+		return {};
+	}
+}
+
+void ExpressionCache::store(const std::string &key, nonstd::span< const NamedTensorExprTree > expressions,
+							const IndexSpaceManager &manager) const {
+	// Write the entry into a temporary location first and only move it to its final location once it is complete
+	// in order to never leave behind partially written entries
+	const std::filesystem::path entryDir = m_directory / key;
+	const std::filesystem::path tmpDir   = m_directory / (key + ".tmp");
+
+	try {
+		std::filesystem::remove_all(tmpDir);
+		std::filesystem::create_directories(tmpDir);
+
+		{
+			std::ofstream stream(tmpDir / ExpressionFile, std::ios::binary | std::ios::trunc);
+			BinaryExport::write(expressions, manager, stream);
+		}
+
+		std::ofstream(tmpDir / CompletionMarker).close();
+
+		std::filesystem::remove_all(entryDir);
+		std::filesystem::rename(tmpDir, entryDir);
+	} catch (const std::exception &) {
+		std::error_code errorCode;
+		std::filesystem::remove_all(tmpDir, errorCode);
+
+		std::throw_with_nested(ProcessingException(fmt::format("Failed to store cache entry '{}'", key)));
+	}
+}
+
+auto ExpressionCache::getDirectory() const -> const std::filesystem::path & {
+	return m_directory;
+}
+
+} // namespace lizard
@@ -0,0 +1,383 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#include "ContractionOrder.hpp"
+#include "Term.hpp"
+
+#include "lizard/format/FormatSupport.hpp"
+#include "lizard/process/Factorization.hpp"
+
+#include <algorithm>
+#include <map>
+#include <optional>
+#include <set>
+
+namespace lizard {
+
+/**
+ * Upper limit for the number of steps taken while searching for the best matching between the factors of two terms
+ */
+constexpr const std::size_t MaxMatchingSteps = 10000;
+
+/**
+ * A (partial) matching of the factors of one term onto the factors of another term
+ */
+struct FactorMatching {
+	/**
+	 * For every factor of the first term the position of the matching factor in the second term (if any)
+	 */
+	std::vector< std::optional< std::size_t > > partners;
+	/**
+	 * Renaming of the dummy indices of the second term onto dummy indices of the first term
+	 */
+	std::map< IndexName, IndexName > renaming;
+	std::size_t matchCount = 0;
+};
+
+/**
+ * @returns The names of all indices that are contracted within the given term
+ */
+auto getDummyNames(const Term &term) -> std::set< IndexName > {
+	std::map< IndexName, std::size_t > occurrences;
+	for (const TensorElement &currentOperand : getOperands(term)) {
+		for (const Index &currentIndex : currentOperand.getIndices()) {
+			occurrences[getName(currentIndex)]++;
+		}
+	}
+
+	std::set< IndexName > dummies;
+	for (const auto &[name, count] : occurrences) {
+		if (count == 2) {
+			dummies.insert(name);
+		}
+	}
+
+	return dummies;
+}
+
+/**
+ * Tries to match the given factors onto each other, extending the given renaming as required
+ *
+ * @returns Whether the factors could be matched
+ */
+auto matchFactor(const TensorElement &lhs, const TensorElement &rhs, const std::set< IndexName > &lhsDummies,
+				 const std::set< IndexName > &rhsDummies, std::map< IndexName, IndexName > &renaming) -> bool {
+	if (lhs.getBlock() != rhs.getBlock()) {
+		return false;
+	}
+
+	std::map< IndexName, IndexName > extendedRenaming = renaming;
+
+	for (std::size_t i = 0; i < lhs.getIndices().size(); ++i) {
+		const Index &lhsIndex = lhs.getIndices()[i];
+		const Index &rhsIndex = rhs.getIndices()[i];
+
+		if (lhsIndex.getType() != rhsIndex.getType()) {
+			return false;
+		}
+
+		const IndexName lhsName = getName(lhsIndex);
+		const IndexName rhsName = getName(rhsIndex);
+
+		const bool lhsIsDummy = lhsDummies.find(lhsName) != lhsDummies.end();
+		const bool rhsIsDummy = rhsDummies.find(rhsName) != rhsDummies.end();
+
+		if (lhsIsDummy != rhsIsDummy) {
+			return false;
+		}
+
+		if (!rhsIsDummy) {
+			// External indices can't be renamed
+			if (lhsName != rhsName) {
+				return false;
+			}
+
+			continue;
+		}
+
+		if (auto iter = extendedRenaming.find(rhsName); iter != extendedRenaming.end()) {
+			if (iter->second != lhsName) {
+				return false;
+			}
+
+			continue;
+		}
+
+		if (std::any_of(extendedRenaming.begin(), extendedRenaming.end(),
+						[&](const auto &entry) { return entry.second == lhsName; })) {
+			// Renaming has to be one-to-one
+			return false;
+		}
+
+		extendedRenaming[rhsName] = lhsName;
+	}
+
+	renaming = std::move(extendedRenaming);
+
+	return true;
+}
+
+void findBestMatching(const Term &lhs, const Term &rhs, const std::set< IndexName > &lhsDummies,
+					  const std::set< IndexName > &rhsDummies, std::size_t position, std::vector< bool > &used,
+					  FactorMatching &current, FactorMatching &best, std::size_t &remainingSteps) {
+	if (remainingSteps == 0) {
+		return;
+	}
+	remainingSteps--;
+
+	if (position == lhs.factors.size()) {
+		if (current.matchCount > best.matchCount) {
+			best = current;
+		}
+
+		return;
+	}
+
+	if (current.matchCount + (lhs.factors.size() - position) <= best.matchCount) {
+		// It is impossible to find a better matching on this path
+		return;
+	}
+
+	for (std::size_t i = 0; i < rhs.factors.size(); ++i) {
+		if (used[i]) {
+			continue;
+		}
+
+		std::map< IndexName, IndexName > renaming = current.renaming;
+		if (!matchFactor(lhs.factors[position], rhs.factors[i], lhsDummies, rhsDummies, renaming)) {
+			continue;
+		}
+
+		std::swap(current.renaming, renaming);
+		current.partners[position] = i;
+		current.matchCount++;
+		used[i] = true;
+
+		findBestMatching(lhs, rhs, lhsDummies, rhsDummies, position + 1, used, current, best, remainingSteps);
+
+		used[i] = false;
+		current.matchCount--;
+		current.partners[position].reset();
+		std::swap(current.renaming, renaming);
+	}
+
+	// Leave the current factor unmatched
+	findBestMatching(lhs, rhs, lhsDummies, rhsDummies, position + 1, used, current, best, remainingSteps);
+}
+
+/**
+ * Renames the indices in the given factors according to the given renaming. Indices that are not covered by the
+ * renaming are given fresh names that don't clash with any of the given names.
+ *
+ * @returns The sign change that results from bringing the indices of the renamed factors back into canonical order
+ */
+auto renameIndices(std::vector< TensorElement > &factors, const std::map< IndexName, IndexName > &renaming,
+				   const std::set< IndexName > &renamable, std::set< IndexName > usedNames) -> int {
+	std::map< IndexName, IndexName > fullRenaming = renaming;
+	int sign                                      = 1;
+
+	for (TensorElement &currentFactor : factors) {
+		std::vector< Index > indices(currentFactor.getIndices().begin(), currentFactor.getIndices().end());
+
+		for (Index &currentIndex : indices) {
+			const IndexName name = getName(currentIndex);
+
+			auto iter = fullRenaming.find(name);
+			if (iter == fullRenaming.end()) {
+				if (renamable.find(name) == renamable.end()) {
+					continue;
+				}
+
+				IndexName freshName = { 0, name.second };
+				while (usedNames.find(freshName) != usedNames.end()) {
+					freshName.first++;
+				}
+				usedNames.insert(freshName);
+
+				iter = fullRenaming.insert({ name, freshName }).first;
+			}
+
+			currentIndex.setID(iter->second.first);
+		}
+
+		auto [element, elementSign] = TensorElement::create(currentFactor.getBlock(), std::move(indices));
+		currentFactor               = std::move(element);
+		sign *= elementSign;
+	}
+
+	return sign;
+}
+
+auto getSortedNames(const std::vector< Index > &indices) -> std::vector< IndexName > {
+	std::vector< IndexName > names;
+	names.reserve(indices.size());
+	for (const Index &currentIndex : indices) {
+		names.push_back(getName(currentIndex));
+	}
+	std::sort(names.begin(), names.end());
+
+	return names;
+}
+
+/**
+ * Attempts to pull the factors that the given terms have in common out of their sum
+ *
+ * @returns The factorized term or an empty optional, if the terms have no factors in common
+ */
+auto factorize(const Term &lhs, const Term &rhs) -> std::optional< Term > {
+	if (!rhs.compoundFactors.empty()) {
+		return {};
+	}
+
+	const std::set< IndexName > lhsDummies = getDummyNames(lhs);
+	const std::set< IndexName > rhsDummies = getDummyNames(rhs);
+
+	FactorMatching current;
+	current.partners.resize(lhs.factors.size());
+	FactorMatching best = current;
+
+	std::vector< bool > used(rhs.factors.size(), false);
+	std::size_t remainingSteps = MaxMatchingSteps;
+	findBestMatching(lhs, rhs, lhsDummies, rhsDummies, 0, used, current, best, remainingSteps);
+
+	if (best.matchCount == 0 || best.matchCount == rhs.factors.size()
+		|| (best.matchCount == lhs.factors.size() && lhs.compoundFactors.empty())) {
+		// Either nothing in common or one of the terms would be reduced to a pure number
+		return {};
+	}
+
+	Term common;
+	Term lhsRemainder;
+	lhsRemainder.prefactor       = lhs.prefactor;
+	lhsRemainder.compoundFactors = lhs.compoundFactors;
+	for (std::size_t i = 0; i < lhs.factors.size(); ++i) {
+		(best.partners[i].has_value() ? common : lhsRemainder).factors.push_back(lhs.factors[i]);
+	}
+
+	Term rhsRemainder;
+	rhsRemainder.prefactor = rhs.prefactor;
+	for (std::size_t i = 0; i < rhs.factors.size(); ++i) {
+		if (std::find(best.partners.begin(), best.partners.end(), i) == best.partners.end()) {
+			rhsRemainder.factors.push_back(rhs.factors[i]);
+		}
+	}
+
+	// Dummy indices of the rhs that are not shared with the common factors must not clash with any index of the lhs
+	std::set< IndexName > usedNames;
+	for (const TensorElement &currentOperand : getOperands(lhs)) {
+		for (const Index &currentIndex : currentOperand.getIndices()) {
+			usedNames.insert(getName(currentIndex));
+		}
+	}
+	for (const TensorExprTree &currentCompound : lhs.compoundFactors) {
+		for (const ConstTensorExpr &currentExpr : currentCompound) {
+			if (currentExpr.getType() == ExpressionType::Variable) {
+				for (const Index &currentIndex : currentExpr.getVariable().getIndices()) {
+					usedNames.insert(getName(currentIndex));
+				}
+			}
+		}
+	}
+	for (const TensorElement &currentFactor : rhs.factors) {
+		for (const Index &currentIndex : currentFactor.getIndices()) {
+			if (rhsDummies.find(getName(currentIndex)) == rhsDummies.end()) {
+				usedNames.insert(getName(currentIndex));
+			}
+		}
+	}
+
+	rhsRemainder.prefactor *= renameIndices(rhsRemainder.factors, best.renaming, rhsDummies, std::move(usedNames));
+
+	if (getSortedNames(getOpenIndices(lhsRemainder)) != getSortedNames(getOpenIndices(rhsRemainder))) {
+		// The remainders don't connect to the common factors in the same way
+		return {};
+	}
+
+	std::vector< Term > addends;
+	if (lhsRemainder.prefactor == 1 && lhsRemainder.factors.empty() && lhsRemainder.compoundFactors.size() == 1) {
+		// Extend the existing sum instead of nesting it
+		addends = splitIntoTerms(lhsRemainder.compoundFactors.front().getRoot());
+	} else {
+		addends.push_back(std::move(lhsRemainder));
+	}
+	addends.push_back(std::move(rhsRemainder));
+
+	common.compoundFactors.push_back(buildSum(addends));
+
+	return common;
+}
+
+auto Factorization::getName() const -> std::string {
+	return "Factorization";
+}
+
+void Factorization::process(std::vector< NamedTensorExprTree > &expressions, const IndexSpaceManager &manager) {
+	const CostModel model(manager);
+
+	for (NamedTensorExprTree &currentTree : expressions) {
+		if (currentTree.size() == 0) {
+			continue;
+		}
+
+		std::vector< Term > terms = splitIntoTerms(currentTree.getRoot());
+		const nonstd::span< const Index > externals = currentTree.getResult().getIndices();
+
+		std::vector< double > costs;
+		costs.reserve(terms.size());
+		for (const Term &currentTerm : terms) {
+			costs.push_back(estimateCost(currentTerm, externals, model).flops);
+		}
+
+		const std::size_t originalTermCount = terms.size();
+
+		while (true) {
+			std::optional< Term > bestTerm;
+			double bestCost     = 0;
+			double bestSavings  = 0;
+			std::size_t bestLhs = 0;
+			std::size_t bestRhs = 0;
+
+			for (std::size_t i = 0; i < terms.size(); ++i) {
+				for (std::size_t j = i + 1; j < terms.size(); ++j) {
+					std::optional< Term > factorized = factorize(terms[i], terms[j]);
+					if (!factorized.has_value()) {
+						continue;
+					}
+
+					const double cost    = estimateCost(factorized.value(), externals, model).flops;
+					const double savings = costs[i] + costs[j] - cost;
+
+					if (savings > bestSavings) {
+						bestTerm    = std::move(factorized);
+						bestCost    = cost;
+						bestSavings = savings;
+						bestLhs     = i;
+						bestRhs     = j;
+					}
+				}
+			}
+
+			if (!bestTerm.has_value()) {
+				break;
+			}
+
+			terms[bestLhs] = std::move(bestTerm.value());
+			costs[bestLhs] = bestCost;
+			terms.erase(terms.begin() + static_cast< std::ptrdiff_t >(bestRhs));
+			costs.erase(costs.begin() + static_cast< std::ptrdiff_t >(bestRhs));
+		}
+
+		if (terms.size() == originalTermCount) {
+			continue;
+		}
+
+		getLogger().debug("Factorized {} terms into {} terms in expression for {}", originalTermCount, terms.size(),
+						  TensorElementFormatter(currentTree.getResult(), manager));
+
+		static_cast< TensorExprTree & >(currentTree) = buildSum(terms);
+	}
+}
+
+} // namespace lizard
@@ -0,0 +1,123 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#include "lizard/process/GeCCoImport.hpp"
+#include "GeCCoTreeBuilder.hpp"
+#include "ParallelFor.hpp"
+#include "StableHasher.hpp"
+#include "lizard/core/Exception.hpp"
+#include "lizard/core/MemoryMappedFile.hpp"
+#include "lizard/parser/GeCCoContraction.hpp"
+#include "lizard/parser/GeCCoExportParser.hpp"
+#include "lizard/parser/ParseException.hpp"
+#include "lizard/process/ImportException.hpp"
+#include "lizard/process/TensorSymmetryRegistry.hpp"
+
+#include <fmt/format.h>
+
+#include <exception>
+#include <string_view>
+#include <utility>
+
+namespace lizard {
+
+/**
+ * The number of contractions that are parsed as one unit of work. This is deliberately independent of the number of
+ * threads, such that the shape of the imported trees doesn't depend on it either.
+ */
+constexpr const std::size_t ContractionsPerChunk = 32;
+
+GeCCoImport::GeCCoImport(std::filesystem::path filePath, std::vector< std::string > spaceNames,
+						 std::size_t threadCount, parser::GeCCoExportParser::Backend backend)
+	: m_filePath(std::move(filePath)), m_spaceNames(std::move(spaceNames)),
+	  m_threadCount(resolveThreadCount(threadCount)), m_backend(backend) {
+}
+
+auto GeCCoImport::getName() const -> std::string {
+	return "GeCCoImport";
+}
+
+auto GeCCoImport::getParameters() const -> std::string {
+	// Include the contents of the file(s) such that cached imports are invalidated once a file changes
+	std::string parameters =
+		fmt::format("content={},spaces={}", hashFileContents(m_filePath), fmt::join(m_spaceNames, "|"));
+
+	if (!m_symmetryFile.empty()) {
+		parameters += fmt::format(",symmetries={}", hashFileContents(m_symmetryFile));
+	}
+
+	return parameters;
+}
+
+auto GeCCoImport::getThreadCount() const -> std::size_t {
+	return m_threadCount;
+}
+
+auto GeCCoImport::getBackend() const -> parser::GeCCoExportParser::Backend {
+	return m_backend;
+}
+
+void GeCCoImport::setSymmetryFile(std::filesystem::path symmetryFile) {
+	m_symmetryFile = std::move(symmetryFile);
+}
+
+auto GeCCoImport::getSymmetryFile() const -> const std::filesystem::path & {
+	return m_symmetryFile;
+}
+
+auto GeCCoImport::importExpressions(const IndexSpaceManager &manager) const -> std::vector< NamedTensorExprTree > {
+	getLogger().info("Importing GeCCo contractions from '{}'", m_filePath.string());
+
+	const std::string fileName = m_filePath.string();
+
+	MemoryMappedFile file;
+	std::vector< parser::GeCCoExportParser::Chunk > chunks;
+	try {
+		file = MemoryMappedFile(m_filePath);
+
+		const std::string_view content(reinterpret_cast< const char * >(file.data()), file.size());
+		chunks = parser::GeCCoExportParser::splitIntoChunks(content, ContractionsPerChunk, fileName);
+	} catch (const Exception &) {
+		std::throw_with_nested(ImportException(fmt::format("Failed to parse '{}'", fileName)));
+	}
+
+	// The symmetry groups are built once up front and shared (read-only) by all builders
+	TensorSymmetryRegistry symmetries;
+	if (!m_symmetryFile.empty()) {
+		symmetries = TensorSymmetryRegistry::fromFile(m_symmetryFile, manager);
+
+		getLogger().info("Loaded symmetries of {} tensor blocks from '{}'", symmetries.size(), m_symmetryFile.string());
+	}
+	const TensorSymmetryRegistry *symmetryPtr = symmetries.empty() ? nullptr : &symmetries;
+
+	// Every chunk is converted into its own set of trees, which are merged (in input order) afterwards
+	std::vector< GeCCoTreeBuilder > builders(chunks.size(), GeCCoTreeBuilder(manager, m_spaceNames, symmetryPtr));
+	std::size_t threadCount = 0;
+	try {
+		threadCount = parallelFor(chunks.size(), m_threadCount, [&](std::size_t i) {
+			GeCCoTreeBuilder &builder = builders[i];
+
+			parser::GeCCoExportParser::parseChunk(
+				chunks[i], [&builder](const parser::GeCCoContraction &contraction) { builder.add(contraction); },
+				fileName, m_backend);
+		});
+	} catch (const parser::ParseException &) {
+		std::throw_with_nested(ImportException(fmt::format("Failed to parse '{}'", fileName)));
+	}
+
+	GeCCoTreeBuilder result(manager, m_spaceNames, symmetryPtr);
+	for (GeCCoTreeBuilder &currentBuilder : builders) {
+		result.merge(std::move(currentBuilder));
+	}
+
+	std::vector< NamedTensorExprTree > expressions = result.release();
+
+	getLogger().info("Imported {} contractions contributing to {} results ({} chunks parsed on {} threads)",
+					 result.getContractionCount(), expressions.size(), chunks.size(), threadCount);
+
+	return expressions;
+}
+
+} // namespace lizard
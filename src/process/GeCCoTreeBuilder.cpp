@@ -0,0 +1,352 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#include "GeCCoTreeBuilder.hpp"
+#include "lizard/core/Fraction.hpp"
+#include "lizard/process/ImportException.hpp"
+#include "lizard/process/TensorSymmetryRegistry.hpp"
+#include "lizard/symbolic/Index.hpp"
+#include "lizard/symbolic/IndexSpaceManager.hpp"
+#include "lizard/symbolic/IndexType.hpp"
+#include "lizard/symbolic/InvalidIndexSpaceException.hpp"
+#include "lizard/symbolic/Tensor.hpp"
+#include "lizard/symbolic/TensorBlock.hpp"
+#include "lizard/symbolic/TensorElement.hpp"
+#include "lizard/symbolic/TreeNode.hpp"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <exception>
+#include <iterator>
+#include <optional>
+#include <tuple>
+#include <utility>
+
+namespace lizard {
+
+/**
+ * The index type encoding used in GeCCo's index strings
+ */
+constexpr const int GeCCoCreator     = 1;
+constexpr const int GeCCoAnnihilator = 2;
+
+/**
+ * The precision with which GeCCo's (decimal) prefactors are converted into fractions
+ */
+constexpr const double FactorPrecision = 1e-10;
+
+/**
+ * Assigns lizard index IDs to the (space, ID) pairs used by GeCCo. GeCCo's IDs are only meaningful within a single
+ * contraction, so we relabel all indices: the result's indices are labelled first (in the order in which they appear
+ * in the result) and the contracted indices afterwards. Thus, all contractions contributing to the same result use
+ * the same labels for their external indices.
+ */
+class IndexLabeler {
+public:
+	/**
+	 * @returns The lizard ID assigned to the given GeCCo index, if any
+	 */
+	[[nodiscard]] auto find(int space, int id) const -> std::optional< Index::Id > {
+		auto iter = std::find_if(m_labels.begin(), m_labels.end(),
+								 [&](const Label &current) { return current.space == space && current.id == id; });
+
+		if (iter == m_labels.end()) {
+			return {};
+		}
+
+		return iter->lizardID;
+	}
+
+	/**
+	 * Assigns a new lizard ID to the given GeCCo index
+	 */
+	auto assign(int space, int id) -> Index::Id {
+		auto iter = std::find_if(m_nextIDs.begin(), m_nextIDs.end(),
+								 [space](const NextID &current) { return current.first == space; });
+
+		if (iter == m_nextIDs.end()) {
+			m_nextIDs.emplace_back(space, 0);
+			iter = std::prev(m_nextIDs.end());
+		}
+
+		m_labels.push_back(Label{ space, id, iter->second++ });
+
+		return m_labels.back().lizardID;
+	}
+
+private:
+	struct Label {
+		int space;
+		int id;
+		Index::Id lizardID;
+	};
+
+	using NextID = std::pair< int, Index::Id >;
+
+	std::vector< Label > m_labels;
+	std::vector< NextID > m_nextIDs;
+};
+
+void validateIndexString(const parser::GeCCoIndexString &string, const parser::GeCCoContraction &contraction,
+						 bool isResult) {
+	const std::size_t size = string.vertices.size();
+
+	if (string.types.size() != size || string.spaces.size() != size || string.ids.size() != size
+		|| (!isResult && string.resultFlags.size() != size)) {
+		throw ImportException(fmt::format("Inconsistent {} string in contraction #{}",
+										  isResult ? "result" : "contraction", contraction.index));
+	}
+
+	for (int currentType : string.types) {
+		if (currentType != GeCCoCreator && currentType != GeCCoAnnihilator) {
+			throw ImportException(
+				fmt::format("Invalid index type {} in contraction #{}", currentType, contraction.index));
+		}
+	}
+}
+
+auto toIndexType(int geccoType) -> IndexType {
+	return geccoType == GeCCoCreator ? IndexType::Creator : IndexType::Annihilator;
+}
+
+/**
+ * Suffix appended to the names of transposed operators. Transposed operators are distinct quantities, so we must not
+ * map them onto the non-transposed tensor. The suffix has to keep names valid identifiers in all export formats (e.g.
+ * ITF).
+ */
+constexpr const char *TransposedSuffix = "T";
+
+auto toTensor(const parser::GeCCoTensor &tensor) -> Tensor {
+	return Tensor(tensor.transposed ? tensor.name + TransposedSuffix : tensor.name);
+}
+
+auto createElement(const parser::GeCCoTensor &tensor, std::vector< Index > creators,
+				   const std::vector< Index > &annihilators, const TensorSymmetryRegistry *symmetries)
+	-> std::tuple< TensorElement, int > {
+	creators.insert(creators.end(), annihilators.begin(), annihilators.end());
+
+	if (symmetries != nullptr) {
+		return symmetries->createElement(toTensor(tensor), std::move(creators));
+	}
+
+	return TensorElement::create(toTensor(tensor), std::move(creators), TensorBlock::SlotSymmetry{});
+}
+
+GeCCoTreeBuilder::GeCCoTreeBuilder(const IndexSpaceManager &manager, std::vector< std::string > spaceNames,
+								   const TensorSymmetryRegistry *symmetries)
+	: m_manager(&manager), m_symmetries(symmetries), m_spaceNames(std::move(spaceNames)),
+	  m_spaces(m_spaceNames.size()) {
+}
+
+void GeCCoTreeBuilder::add(const parser::GeCCoContraction &contraction) {
+	const parser::GeCCoIndexString &contrString  = contraction.contractionString;
+	const parser::GeCCoIndexString &resultString = contraction.resultString;
+
+	if (contraction.vertexCount == 0 || contraction.vertices.size() != contraction.vertexCount
+		|| contraction.superVertex.size() != contraction.vertexCount || contraction.operatorCount == 0
+		|| contraction.operatorCount > contraction.vertexCount) {
+		throw ImportException(fmt::format("Inconsistent vertex specification in contraction #{}", contraction.index));
+	}
+
+	validateIndexString(contrString, contraction, false);
+	validateIndexString(resultString, contraction, true);
+
+	IndexLabeler labeler;
+	int sign = contraction.sign;
+
+	// Result
+	std::vector< Index > creators;
+	std::vector< Index > annihilators;
+	for (std::size_t i = 0; i < resultString.ids.size(); ++i) {
+		Index index(labeler.assign(resultString.spaces[i], resultString.ids[i]), resolveSpace(resultString.spaces[i]),
+					toIndexType(resultString.types[i]));
+
+		(index.getType() == IndexType::Creator ? creators : annihilators).push_back(std::move(index));
+	}
+
+	auto [resultElement, resultSign] =
+		createElement(contraction.result, std::move(creators), annihilators, m_symmetries);
+	sign *= resultSign;
+
+	// Operators (multiple vertices may belong to the same operator via the super vertex specification)
+	std::vector< TensorElement > elements;
+	elements.reserve(contraction.operatorCount);
+
+	for (int currentOperator = 1; currentOperator <= static_cast< int >(contraction.operatorCount); ++currentOperator) {
+		auto firstVertex = std::find(contraction.superVertex.begin(), contraction.superVertex.end(), currentOperator);
+		if (firstVertex == contraction.superVertex.end()) {
+			throw ImportException(fmt::format("Operator {} of contraction #{} is not associated with any vertex",
+											  currentOperator, contraction.index));
+		}
+
+		creators.clear();
+		annihilators.clear();
+
+		for (std::size_t i = 0; i < contrString.vertices.size(); ++i) {
+			const int vertex = contrString.vertices[i];
+			if (vertex < 1 || vertex > static_cast< int >(contraction.vertexCount)) {
+				throw ImportException(
+					fmt::format("Reference to invalid vertex {} in contraction #{}", vertex, contraction.index));
+			}
+
+			if (contraction.superVertex[static_cast< std::size_t >(vertex - 1)] != currentOperator) {
+				continue;
+			}
+
+			std::optional< Index::Id > id = labeler.find(contrString.spaces[i], contrString.ids[i]);
+			if (!id.has_value()) {
+				if (contrString.resultFlags[i]) {
+					throw ImportException(fmt::format("External index in contraction #{} doesn't appear in the result",
+													  contraction.index));
+				}
+
+				id = labeler.assign(contrString.spaces[i], contrString.ids[i]);
+			}
+
+			Index index(id.value(), resolveSpace(contrString.spaces[i]), toIndexType(contrString.types[i]));
+
+			(index.getType() == IndexType::Creator ? creators : annihilators).push_back(std::move(index));
+		}
+
+		const auto vertexIndex = static_cast< std::size_t >(firstVertex - contraction.superVertex.begin());
+
+		auto [element, elementSign] =
+			createElement(contraction.vertices[vertexIndex], creators, annihilators, m_symmetries);
+		sign *= elementSign;
+
+		elements.push_back(std::move(element));
+	}
+
+	Fraction factor =
+		Fraction::fromDecimal(contraction.externalFactor * contraction.contractionFactor, FactorPrecision);
+	factor *= sign;
+
+	// Reserve the space required for this contraction (as given by the operator count from /#VERTICES/) up front
+	ResultTree &target = getTree(resultElement);
+
+	const bool hasFactor        = factor != Fraction(1);
+	const bool needsSum         = target.tree.size() > 0;
+	const std::size_t variables = target.variableCount + contraction.operatorCount;
+	const std::size_t nodes =
+		target.tree.size() + 2 * contraction.operatorCount - 1 + (hasFactor ? 2 : 0) + (needsSum ? 1 : 0);
+
+	reserve(target, nodes, variables);
+
+	// Note: the contraction is added in postfix order, i.e. factor * (A * (B * ...))
+	if (hasFactor) {
+		target.tree.add(TreeNode(factor));
+	}
+
+	for (TensorElement &current : elements) {
+		target.tree.add(std::move(current));
+	}
+
+	for (std::size_t i = 0; i < elements.size() - 1 + (hasFactor ? 1 : 0); ++i) {
+		target.tree.add(TreeNode(ExpressionOperator::Times));
+	}
+
+	if (needsSum) {
+		target.tree.add(TreeNode(ExpressionOperator::Plus));
+	}
+
+	target.variableCount = variables;
+	m_contractionCount++;
+}
+
+void GeCCoTreeBuilder::merge(GeCCoTreeBuilder &&other) {
+	for (ResultTree &current : other.m_trees) {
+		ResultTree &target = getTree(current.tree.getResult());
+
+		if (target.tree.size() == 0) {
+			target = std::move(current);
+			continue;
+		}
+
+		reserve(target, target.tree.size() + current.tree.size() + 1, target.variableCount + current.variableCount);
+
+		for (const ConstTensorExpr &currentExpr : current.tree) {
+			switch (currentExpr.getType()) {
+				case ExpressionType::Variable:
+					target.tree.add(currentExpr.getVariable());
+					break;
+				case ExpressionType::Literal:
+					target.tree.add(TreeNode(currentExpr.getLiteral()));
+					break;
+				case ExpressionType::Operator:
+					target.tree.add(TreeNode(currentExpr.getOperator()));
+					break;
+			}
+		}
+
+		target.tree.add(TreeNode(ExpressionOperator::Plus));
+		target.variableCount += current.variableCount;
+	}
+
+	m_contractionCount += other.m_contractionCount;
+
+	other.m_trees.clear();
+	other.m_contractionCount = 0;
+}
+
+auto GeCCoTreeBuilder::getContractionCount() const -> std::size_t {
+	return m_contractionCount;
+}
+
+auto GeCCoTreeBuilder::release() -> std::vector< NamedTensorExprTree > {
+	std::vector< NamedTensorExprTree > trees;
+	trees.reserve(m_trees.size());
+
+	for (ResultTree &current : m_trees) {
+		trees.push_back(std::move(current.tree));
+	}
+
+	m_trees.clear();
+
+	return trees;
+}
+
+auto GeCCoTreeBuilder::resolveSpace(int geccoSpace) -> IndexSpace {
+	if (geccoSpace < 1 || static_cast< std::size_t >(geccoSpace) > m_spaceNames.size()) {
+		throw ImportException(fmt::format("No index space configured for GeCCo space {}", geccoSpace));
+	}
+
+	std::optional< IndexSpace > &space = m_spaces[static_cast< std::size_t >(geccoSpace - 1)];
+
+	if (!space.has_value()) {
+		try {
+			space = m_manager->createFromName(m_spaceNames[static_cast< std::size_t >(geccoSpace - 1)]);
+		} catch (const InvalidIndexSpaceException &) {
+			std::throw_with_nested(
+				ImportException(fmt::format("Can't resolve index space for GeCCo space {}", geccoSpace)));
+		}
+	}
+
+	return space.value();
+}
+
+auto GeCCoTreeBuilder::getTree(const TensorElement &result) -> ResultTree & {
+	auto iter = std::find_if(m_trees.begin(), m_trees.end(),
+							 [&result](const ResultTree &current) { return current.tree.getResult() == result; });
+
+	if (iter != m_trees.end()) {
+		return *iter;
+	}
+
+	return m_trees.emplace_back(ResultTree{ NamedTensorExprTree(result) });
+}
+
+void GeCCoTreeBuilder::reserve(ResultTree &target, std::size_t nodes, std::size_t variables) {
+	// The capacity is grown geometrically in order to not end up with a quadratic amount of reallocations for results
+	// that receive many contributions
+	if (nodes > target.nodeCapacity || variables > target.variableCapacity) {
+		target.nodeCapacity     = std::max(nodes, 2 * target.nodeCapacity);
+		target.variableCapacity = std::max(variables, 2 * target.variableCapacity);
+
+		target.tree.reserve(target.nodeCapacity, target.variableCapacity);
+	}
+}
+
+} // namespace lizard
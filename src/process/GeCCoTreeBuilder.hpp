@@ -0,0 +1,88 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#pragma once
+
+#include "lizard/parser/GeCCoContraction.hpp"
+#include "lizard/symbolic/IndexSpace.hpp"
+#include "lizard/symbolic/TensorExpressions.hpp"
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace lizard {
+
+class IndexSpaceManager;
+class TensorSymmetryRegistry;
+
+/**
+ * Helper class that converts GeCCo contractions into expression trees. Every contraction is appended (in postfix
+ * order) to the tree of its result tensor, such that contractions contributing to the same result end up as a sum in
+ * a single tree.
+ */
+class GeCCoTreeBuilder {
+public:
+	/**
+	 * @param manager The IndexSpaceManager to resolve index spaces with
+	 * @param spaceNames The names of the index spaces corresponding to GeCCo's space numbers (1-based, i.e. the first
+	 * name belongs to space 1)
+	 * @param symmetries The registry to look up the symmetries of tensor blocks in (must outlive the builder). If
+	 * nullptr, all tensor elements are created without any symmetry.
+	 */
+	GeCCoTreeBuilder(const IndexSpaceManager &manager, std::vector< std::string > spaceNames,
+					 const TensorSymmetryRegistry *symmetries = nullptr);
+
+	/**
+	 * Appends the given contraction to the tree of its result
+	 *
+	 * @throws ImportException if the contraction can't be represented
+	 */
+	void add(const parser::GeCCoContraction &contraction);
+
+	/**
+	 * Appends the trees built by the given builder to the ones of this builder. Trees for results that are already
+	 * known to this builder are added as a sum, all others are appended (in their original order).
+	 */
+	void merge(GeCCoTreeBuilder &&other);
+
+	/**
+	 * @returns The number of contractions that have been added so far
+	 */
+	[[nodiscard]] auto getContractionCount() const -> std::size_t;
+
+	/**
+	 * @returns The built expression trees (one per result tensor in order of first appearance). The builder must not
+	 * be used afterwards.
+	 */
+	[[nodiscard]] auto release() -> std::vector< NamedTensorExprTree >;
+
+private:
+	/**
+	 * The tree of a single result together with the node and variable capacity that has been reserved for it
+	 */
+	struct ResultTree {
+		NamedTensorExprTree tree;
+		std::size_t variableCount    = 0;
+		std::size_t nodeCapacity     = 0;
+		std::size_t variableCapacity = 0;
+	};
+
+	const IndexSpaceManager *m_manager;
+	const TensorSymmetryRegistry *m_symmetries;
+	std::vector< std::string > m_spaceNames;
+	std::vector< std::optional< IndexSpace > > m_spaces;
+	std::vector< ResultTree > m_trees;
+	std::size_t m_contractionCount = 0;
+
+	[[nodiscard]] auto resolveSpace(int geccoSpace) -> IndexSpace;
+
+	[[nodiscard]] auto getTree(const TensorElement &result) -> ResultTree &;
+
+	void reserve(ResultTree &target, std::size_t nodes, std::size_t variables);
+};
+
+} // namespace lizard
@@ -30,6 +30,15 @@ auto HardcodedImport::getName() const -> std::string {
 	return "HardcodedImport";
 }
 
+auto HardcodedImport::getParameters() const -> std::string {
+	switch (m_target) {
+		case ImportTarget::CCD_ENERGY:
+			return "target=CCD_ENERGY";
+	}
+
+	throw ImportException(fmt::format("Unknown import target ({})", fmt::underlying(m_target)));
+}
+
 auto HardcodedImport::importExpressions(const IndexSpaceManager &manager) const -> std::vector< NamedTensorExprTree > {
 	// Define common symmetries. These definitions assume that the creators are listed before the annihilators
 	const perm::PrimitivePermutationGroup fourIdxAntisymmetry = perm::antisymmetricRanges({ { 0, 1 }, { 2, 3 } });
@@ -4,44 +4,170 @@
 // tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
 
 #include "lizard/process/ITFExport.hpp"
+#include "ParallelFor.hpp"
+#include "lizard/process/ExportException.hpp"
+#include "lizard/process/MappedTensorExprTree.hpp"
 
+#include "itf/BufferColoring.hpp"
+#include "itf/ContractionFusion.hpp"
+#include "itf/Liveness.hpp"
 #include "itf/Operation.hpp"
+#include "itf/Scheduler.hpp"
+#include "itf/TensorFormatter.hpp"
 #include "itf/Translator.hpp"
 
+#include <fmt/format.h>
+
+#include <spdlog/logger.h>
+
+#include <algorithm>
+#include <fstream>
 #include <memory>
+#include <ostream>
 #include <string>
+#include <utility>
 #include <vector>
 
 
 namespace lizard {
 
+/**
+ * The amount of code blocks per thread that are translated before they are written out. This bounds the amount of
+ * generated code that has to be kept in memory at any given time.
+ */
+constexpr const std::size_t BlocksPerThread = 4;
+
+/**
+ * @returns An upper bound for the number of intermediates that translating the given tree can produce
+ */
+template< typename Tree > auto countPossibleIntermediates(const Tree &tree) -> std::size_t {
+	if (tree.size() == 0) {
+		return 0;
+	}
+
+	// Every intermediate is the result of a contraction and every contraction corresponds to a multiplication
+	return static_cast< std::size_t >(std::count_if(tree.begin(), tree.end(), [](const auto &current) {
+		return current.getType() == ExpressionType::Operator && current.getOperator() == ExpressionOperator::Times;
+	}));
+}
+
+/**
+ * Appends the ITF code block corresponding to the given expression tree to the given buffer. Intermediates are
+ * numbered starting at the given index.
+ */
+template< typename Tree >
+void translateBlock(fmt::memory_buffer &buffer, const Tree &tree, const IndexSpaceManager &manager,
+					std::size_t firstIntermediate, spdlog::logger &logger) {
+	itf::TranslationContext context(firstIntermediate);
+
+	std::vector< std::unique_ptr< itf::Operation > > operations = itf::translate(tree, context);
+
+	// Contractions into the same result that share an operand can be performed as a single contraction
+	const std::size_t fused = itf::fuseContractions(operations);
+	logger.debug("Fused {} contractions for {}", fused, tree.getResult().getBlock().getTensor().getName());
+
+	// Order independent contractions such that as few intermediates as possible are alive at the same time
+	const itf::PeakMemoryEstimate estimate = itf::scheduleOperations(operations, manager);
+	logger.debug("Estimated peak memory of intermediates for {}: {} elements (before reordering: {})",
+				 tree.getResult().getBlock().getTensor().getName(), estimate.after, estimate.before);
+
+	// Let intermediates with disjoint lifetimes share the same storage
+	const itf::ColoringResult coloring = itf::colorIntermediates(operations);
+	logger.debug("Stored {} intermediates for {} in {} buffers", coloring.intermediates,
+				 tree.getResult().getBlock().getTensor().getName(), coloring.buffers);
+
+	// Allocate intermediates only for as long as they are needed
+	itf::insertLifetimeOperations(operations);
+
+	itf::appendText(buffer, "----code(\"");
+	itf::appendText(buffer, tree.getResult().getBlock().getTensor().getName());
+	itf::appendText(buffer, "\")\n");
+	for (const std::unique_ptr< itf::Operation > &currentOperation : operations) {
+		currentOperation->formatTo(buffer, manager);
+		buffer.push_back('\n');
+	}
+}
+
+ITFExport::ITFExport(std::filesystem::path outputPath, std::size_t threadCount)
+	: m_outputPath(std::move(outputPath)), m_threadCount(resolveThreadCount(threadCount)) {
+}
+
 auto ITFExport::getName() const -> std::string {
 	return "ITF";
 }
 
+auto ITFExport::getParameters() const -> std::string {
+	return m_outputPath.string();
+}
+
+auto ITFExport::getOutputPath() const -> const std::filesystem::path & {
+	return m_outputPath;
+}
+
+auto ITFExport::getThreadCount() const -> std::size_t {
+	return m_threadCount;
+}
+
 void ITFExport::exportExpressions(nonstd::span< const NamedTensorExprTree > expressions,
 								  const IndexSpaceManager &manager) {
-	std::string output;
-	for (const NamedTensorExprTree &tree : expressions) {
-		std::vector< std::unique_ptr< itf::Operation > > operations = itf::translate(tree);
+	std::ofstream stream(m_outputPath);
+	if (!stream) {
+		throw ExportException(fmt::format("Can't open '{}' for writing", m_outputPath.string()));
+	}
 
-		// TODO
+	write(expressions, manager, stream);
 
-		// Insert operations for loading, storing and dropping tensors
+	getLogger().info("Wrote ITF code for {} expressions to '{}'", expressions.size(), m_outputPath.string());
+}
 
-		// Prepend operations for importing/declaring tensors
+void ITFExport::write(nonstd::span< const NamedTensorExprTree > expressions, const IndexSpaceManager &manager,
+					  std::ostream &stream) const {
+	writeTrees(expressions, manager, stream);
+}
+
+void ITFExport::write(nonstd::span< const MappedTensorExprTree > expressions, const IndexSpaceManager &manager,
+					  std::ostream &stream) const {
+	writeTrees(expressions, manager, stream);
+}
+
+template< typename Tree >
+void ITFExport::writeTrees(nonstd::span< const Tree > expressions, const IndexSpaceManager &manager,
+						   std::ostream &stream) const {
+	// Every tree gets its own range of intermediate numbers, which makes the generated names independent of the order
+	// in which the trees happen to be translated
+	std::vector< std::size_t > firstIntermediates;
+	firstIntermediates.reserve(expressions.size());
+	std::size_t nextIntermediate = 1;
+	for (const Tree &tree : expressions) {
+		firstIntermediates.push_back(nextIntermediate);
+		nextIntermediate += countPossibleIntermediates(tree);
+	}
+
+	const std::size_t windowSize = m_threadCount * BlocksPerThread;
+
+	std::vector< fmt::memory_buffer > blocks;
+
+	for (std::size_t windowStart = 0; windowStart < expressions.size(); windowStart += windowSize) {
+		const std::size_t windowEnd = std::min(windowStart + windowSize, expressions.size());
+
+		blocks.clear();
+		blocks.resize(windowEnd - windowStart);
+
+		parallelFor(blocks.size(), m_threadCount, [&](std::size_t i) {
+			translateBlock(blocks[i], expressions[windowStart + i], manager, firstIntermediates[windowStart + i],
+						   getLogger());
+		});
+
+		for (const fmt::memory_buffer &currentBlock : blocks) {
+			stream.write(currentBlock.data(), static_cast< std::streamsize >(currentBlock.size()));
+		}
 
-		// Stringify expressions (into a code-block)
-		output += "----code(\"";
-		output += tree.getResult().getBlock().getTensor().getName();
-		output += "\")\n";
-		for (const std::unique_ptr< itf::Operation > &currentOperation : operations) {
-			output += currentOperation->stringify(manager);
-			output += "\n";
+		if (!stream) {
+			throw ExportException("Failed to write ITF code");
 		}
 	}
 
-	getLogger().info("Resulting ITF code:\n{}", output);
+	stream.flush();
 }
 
 } // namespace lizard
@@ -0,0 +1,240 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#include "lizard/process/MappedTensorExprTree.hpp"
+#include "BinaryFormat.hpp"
+#include "lizard/process/ImportException.hpp"
+#include "lizard/symbolic/DepthFirst.hpp"
+#include "lizard/symbolic/ExpressionException.hpp"
+
+#include <fmt/format.h>
+
+#include <cassert>
+#include <exception>
+#include <string>
+#include <utility>
+
+namespace lizard {
+
+MappedTensorExpr::MappedTensorExpr(Numeric nodeID, const MappedTensorExprTree &tree)
+	: m_nodeID(nodeID), m_tree(&tree) {
+}
+
+auto MappedTensorExpr::getCardinality() const -> ExpressionCardinality {
+	return node().getCardinality();
+}
+
+auto MappedTensorExpr::getType() const -> ExpressionType {
+	return node().getType();
+}
+
+auto MappedTensorExpr::getParent() const -> MappedTensorExpr {
+	assert(!isRoot()); // NOLINT
+	return { node().getParent(), *m_tree };
+}
+
+auto MappedTensorExpr::getVariable() const -> TensorElement {
+	assert(getType() == ExpressionType::Variable); // NOLINT
+	return m_tree->unpackVariable(node().getLeftChild());
+}
+
+auto MappedTensorExpr::getOperator() const -> ExpressionOperator {
+	return node().getOperator();
+}
+
+auto MappedTensorExpr::getLiteral() const -> Fraction {
+	assert(getType() == ExpressionType::Literal); // NOLINT
+	return { static_cast< Fraction::field_type >(node().getLeftChild()),
+			 static_cast< Fraction::field_type >(node().getRightChild()) };
+}
+
+auto MappedTensorExpr::getLeftArg() const -> MappedTensorExpr {
+	assert(getCardinality() == ExpressionCardinality::Binary); // NOLINT
+	return { node().getLeftChild(), *m_tree };
+}
+
+auto MappedTensorExpr::getRightArg() const -> MappedTensorExpr {
+	assert(getCardinality() == ExpressionCardinality::Binary); // NOLINT
+	return { node().getRightChild(), *m_tree };
+}
+
+auto MappedTensorExpr::isRoot() const -> bool {
+	return !node().hasParent();
+}
+
+auto MappedTensorExpr::size() const -> Numeric::numeric_type {
+	Numeric::numeric_type size = 0;
+	for (auto it = begin(); it != end(); ++it) {
+		size++;
+	}
+
+	return size;
+}
+
+auto MappedTensorExpr::getContainingTree() const -> const MappedTensorExprTree & {
+	return *m_tree;
+}
+
+auto MappedTensorExpr::isSame(const MappedTensorExpr &other) const -> bool {
+	return m_tree == other.m_tree && m_nodeID == other.m_nodeID;
+}
+
+auto MappedTensorExpr::node() const -> TreeNode {
+	return m_tree->node(m_nodeID);
+}
+
+auto operator==(const MappedTensorExpr &lhs, const MappedTensorExpr &rhs) -> bool {
+	if (lhs.getType() != rhs.getType()) {
+		return false;
+	}
+
+	switch (lhs.getType()) {
+		case ExpressionType::Literal:
+			return lhs.getLiteral() == rhs.getLiteral();
+		case ExpressionType::Variable:
+			return lhs.getVariable() == rhs.getVariable();
+		case ExpressionType::Operator:
+			return lhs.getOperator() == rhs.getOperator() && lhs.getLeftArg() == rhs.getLeftArg()
+				   && lhs.getRightArg() == rhs.getRightArg();
+	}
+
+	return false;
+}
+
+auto operator!=(const MappedTensorExpr &lhs, const MappedTensorExpr &rhs) -> bool {
+	return !(lhs == rhs);
+}
+
+
+
+template< TreeTraversal iteration_order >
+auto MappedTensorExpr::Iterator< iteration_order >::begin(const MappedTensorExprTree &tree, Numeric rootID)
+	-> Iterator {
+	if constexpr (iteration_order == TreeTraversal::DepthFirst_PreOrder) {
+		// The root node is in fact the first TreeNode to be visited
+		return { tree, rootID, rootID, rootID };
+	} else {
+		// Start in a state that indicates that we are coming from the root's parent. Incrementing from this state
+		// will find the first TreeNode to be visited.
+		Iterator iter(tree, rootID, rootID, tree.node(rootID).getParent());
+		iter.increment();
+		return iter;
+	}
+}
+
+template< TreeTraversal iteration_order > void MappedTensorExpr::Iterator< iteration_order >::increment() {
+	constexpr depth_first::Order order = [&]() {
+		switch (iteration_order) {
+			case TreeTraversal::DepthFirst_PreOrder:
+				return depth_first::Order::Pre;
+			case TreeTraversal::DepthFirst_InOrder:
+				return depth_first::Order::In;
+			case TreeTraversal::DepthFirst_PostOrder:
+				break;
+		}
+		return depth_first::Order::Post;
+	}();
+
+	do {
+		const TreeNode currentNode = m_tree->node(m_currentID);
+
+		depth_first::TraversalStep step = depth_first::stepTraversal(currentNode, m_currentID, m_previousID, order);
+
+		if (m_currentID == m_rootID && step.nextNodeID == currentNode.getParent()) {
+			// We are about to leave the sub-tree that is being iterated over
+			m_currentID.reset();
+			break;
+		}
+
+		m_previousID = m_currentID;
+		m_currentID  = step.nextNodeID;
+
+		if (step.visitNextNode) {
+			break;
+		}
+	} while (m_currentID.isValid());
+
+	if (!m_currentID.isValid()) {
+		// Ensure that in this case, we equal the end iterator
+		m_previousID.reset();
+	}
+}
+
+template class MappedTensorExpr::Iterator< TreeTraversal::DepthFirst_PreOrder >;
+template class MappedTensorExpr::Iterator< TreeTraversal::DepthFirst_InOrder >;
+template class MappedTensorExpr::Iterator< TreeTraversal::DepthFirst_PostOrder >;
+
+
+
+MappedTensorExprTree::MappedTensorExprTree(const std::filesystem::path &path, const IndexSpaceManager &manager,
+										   std::size_t position)
+	: m_position(position) {
+	try {
+		m_file   = mapBinaryFile(path);
+		m_reader = std::make_unique< BinaryExpressionReader >(viewContents(m_file), manager, path.string());
+
+		const BinaryTreeLayout layout = m_reader->getTreeLayout(position);
+		m_nodes                       = layout.nodes;
+		m_elements                    = layout.elements;
+		m_size                        = layout.nodeCount;
+		m_variableCount               = layout.variableCount;
+	} catch (const ImportException &) {
+		std::throw_with_nested(ExpressionException(
+			fmt::format("'{}' doesn't contain a valid expression tree at position {}", path.string(), position)));
+	}
+}
+
+// The views refer to the mapped memory, which stays in place when the mapping is moved
+MappedTensorExprTree::MappedTensorExprTree(MappedTensorExprTree &&other) noexcept = default;
+
+MappedTensorExprTree::~MappedTensorExprTree() = default;
+
+auto MappedTensorExprTree::operator=(MappedTensorExprTree &&other) noexcept -> MappedTensorExprTree & = default;
+
+auto MappedTensorExprTree::getResult() const -> const TensorElement & {
+	return m_reader->getResults()[m_position];
+}
+
+auto MappedTensorExprTree::isEmpty() const -> bool {
+	return m_size == 0;
+}
+
+auto MappedTensorExprTree::getRoot() const -> MappedTensorExpr {
+	assert(!isEmpty()); // NOLINT
+
+	// Nodes are stored in post-order, so the root comes last
+	return { Numeric(m_size - 1), *this };
+}
+
+auto MappedTensorExprTree::size() const -> Numeric::numeric_type {
+	return m_size;
+}
+
+auto MappedTensorExprTree::variableCount() const -> Numeric::numeric_type {
+	return m_variableCount;
+}
+
+auto MappedTensorExprTree::materialize() const -> NamedTensorExprTree {
+	try {
+		return m_reader->readTree(m_position);
+	} catch (const ImportException &) {
+		std::throw_with_nested(ExpressionException("Failed to materialize mapped expression tree"));
+	}
+}
+
+auto MappedTensorExprTree::node(Numeric nodeID) const -> TreeNode {
+	assert(nodeID < m_size); // NOLINT
+	return decodeNode(m_nodes, nodeID);
+}
+
+auto MappedTensorExprTree::unpackVariable(Numeric elementOffset) const -> TensorElement {
+	try {
+		return m_reader->readElement(m_elements, elementOffset);
+	} catch (const ImportException &) {
+		std::throw_with_nested(ExpressionException("Failed to unpack tensor element of mapped expression tree"));
+	}
+}
+
+} // namespace lizard
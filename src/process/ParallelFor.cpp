@@ -0,0 +1,25 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#include "ParallelFor.hpp"
+
+namespace lizard {
+
+ThreadJoiner::ThreadJoiner(std::vector< std::thread > &threads) : m_threads(threads) {
+}
+
+ThreadJoiner::~ThreadJoiner() {
+	for (std::thread &current : m_threads) {
+		if (current.joinable()) {
+			current.join();
+		}
+	}
+}
+
+auto resolveThreadCount(std::size_t threadCount) -> std::size_t {
+	return threadCount > 0 ? threadCount : std::max(std::thread::hardware_concurrency(), 1U);
+}
+
+} // namespace lizard
@@ -0,0 +1,93 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace lizard {
+
+/**
+ * Joins all (joinable) threads in the given list upon destruction. This ensures that leaving a scope by means of an
+ * exception doesn't destroy any joinable thread, which would terminate the program.
+ */
+class ThreadJoiner {
+public:
+	explicit ThreadJoiner(std::vector< std::thread > &threads);
+	ThreadJoiner(const ThreadJoiner &) = delete;
+	ThreadJoiner(ThreadJoiner &&)      = delete;
+	~ThreadJoiner();
+	auto operator=(const ThreadJoiner &) -> ThreadJoiner & = delete;
+	auto operator=(ThreadJoiner &&) -> ThreadJoiner &      = delete;
+
+private:
+	std::vector< std::thread > &m_threads;
+};
+
+/**
+ * @returns The given thread count or, if it is zero, the number of concurrent threads supported by the hardware
+ */
+[[nodiscard]] auto resolveThreadCount(std::size_t threadCount) -> std::size_t;
+
+/**
+ * Invokes the given function for every position in [0, count), using up to the given number of threads (including the
+ * calling one). Positions are handed out in increasing order, with every thread fetching the next unprocessed
+ * position once it is done with its previous one.
+ *
+ * If the function throws for any position, the remaining positions are still processed and the exception thrown for
+ * the lowest position is rethrown once all threads have finished.
+ *
+ * @returns The number of threads that have been used
+ */
+template< typename Function >
+auto parallelFor(std::size_t count, std::size_t threadCount, const Function &function) -> std::size_t {
+	std::vector< std::exception_ptr > errors(count, nullptr);
+	std::atomic< std::size_t > next(0);
+
+	auto worker = [&]() {
+		for (std::size_t i = next++; i < count; i = next++) {
+			try {
+				function(i);
+			} catch (...) {
+				errors[i] = std::current_exception();
+			}
+		}
+	};
+
+	std::vector< std::thread > threads;
+	threadCount = std::max< std::size_t >(std::min(threadCount, count), 1);
+	threads.reserve(threadCount - 1);
+
+	{
+		const ThreadJoiner joiner(threads);
+
+		try {
+			for (std::size_t i = 1; i < threadCount; ++i) {
+				threads.emplace_back(worker);
+			}
+		} catch (const std::system_error &) {
+			// Failing to start additional threads only reduces the degree of parallelism, as the calling thread
+			// processes whatever remains
+		}
+
+		worker();
+	}
+
+	for (const std::exception_ptr &currentError : errors) {
+		if (currentError) {
+			std::rethrow_exception(currentError);
+		}
+	}
+
+	return threads.size() + 1;
+}
+
+} // namespace lizard
@@ -6,8 +6,10 @@
 #include "lizard/process/Processor.hpp"
 #include "lizard/core/SignedCast.hpp"
 #include "lizard/format/FormatSupport.hpp"
+#include "lizard/process/CostModel.hpp"
 #include "lizard/process/ExportStrategy.hpp"
 #include "lizard/process/ImportStrategy.hpp"
+#include "lizard/process/ProcessingException.hpp"
 #include "lizard/process/ReporterConfig.hpp"
 #include "lizard/process/RewriteStrategy.hpp"
 #include "lizard/symbolic/TensorExpressions.hpp"
@@ -18,6 +20,8 @@
 
 #include <cassert>
 #include <iterator>
+#include <optional>
+#include <string>
 #include <type_traits>
 #include <vector>
 
@@ -38,6 +42,10 @@ void Processor::setLogger(std::shared_ptr< spdlog::logger > logger) {
 	m_log = std::move(logger);
 }
 
+void Processor::setCache(std::optional< ExpressionCache > cache) {
+	m_cache = std::move(cache);
+}
+
 void Processor::enqueue(ProcessingStep step) {
 	m_steps.push_back(std::move(step));
 }
@@ -77,6 +85,18 @@ void Processor::run() {
 
 		m_log->info(fmt::format("{}/{}: {}", i + 1, nSteps, strategy));
 
+		// Export steps are executed for their side-effects and therefore can't be skipped
+		std::string cacheKey;
+		if (m_cache && strategy.getType() != StrategyType::Export) {
+			cacheKey = ExpressionCache::computeKey(expressions, strategy, m_spaceManager);
+
+			if (std::optional< std::vector< NamedTensorExprTree > > cached = m_cache->load(cacheKey, m_spaceManager)) {
+				expressions = std::move(cached.value());
+				m_log->info("-> Restored {} expressions from cache ({})", expressions.size(), cacheKey);
+				continue;
+			}
+		}
+
 		std::shared_ptr< spdlog::logger > subLogger = createLogger(strategy, currentStep.getReporterConfig());
 
 		strategy.setLogger(subLogger);
@@ -106,6 +126,13 @@ void Processor::run() {
 				auto &rewriteStrategy = dynamic_cast< RewriteStrategy & >(strategy);
 
 				rewriteStrategy.process(expressions, m_spaceManager);
+
+				if (m_log->should_log(spdlog::level::debug)) {
+					const CostReport report = CostModel(m_spaceManager).estimate(expressions);
+					m_log->debug("-> Estimated cost: {:.3e} FLOPs (scaling {}), largest intermediate: {:.3e} elements",
+								 report.total.flops, report.total.scaling.toString(m_spaceManager),
+								 report.total.peakIntermediateSize);
+				}
 				break;
 			}
 		}
@@ -113,6 +140,15 @@ void Processor::run() {
 		// unregister logger again
 		spdlog::drop(subLogger->name());
 
+		if (!cacheKey.empty()) {
+			try {
+				m_cache->store(cacheKey, expressions, m_spaceManager);
+			} catch (const ProcessingException &e) {
+				// Failing to populate the cache only slows down subsequent runs - it must not abort this one
+				m_log->warn("Failed to cache result of step {}: {}", i + 1, e.what());
+			}
+		}
+
 		if (nExpressions < expressions.size()) {
 			const std::size_t diff = expressions.size() - nExpressions;
 			m_log->info("-> Added {} {}", diff, diff > 1 ? "expressions" : "expression");
@@ -17,7 +17,9 @@
 
 #include <fmt/core.h>
 
+#include <algorithm>
 #include <cassert>
+#include <cstddef>
 
 namespace lizard {
 
@@ -27,6 +29,20 @@ auto SkeletonQuantityMapper::getName() const -> std::string {
 
 void replaceBySkeleton(TensorExpr &expression, const IndexTracker &tracker);
 
+namespace {
+
+/**
+ * @returns Whether the given indices are those of a density-fitting factor B[P,p+,q-], i.e. a single creator and
+ * annihilator accompanied by spin-free external indices
+ */
+auto isFittingFactor(nonstd::span< const Index > indices, const IndexTracker &tracker) -> bool {
+	return tracker.creators().size() == 1 && tracker.annihilators().size() == 1
+		   && std::all_of(tracker.externals().begin(), tracker.externals().end(),
+						  [&](std::size_t position) { return indices[position].getSpace().getSpin() == Spin::None; });
+}
+
+} // namespace
+
 void SkeletonQuantityMapper::process(std::vector< NamedTensorExprTree > &expressions,
 									 const IndexSpaceManager &manager) {
 	for (NamedTensorExprTree &currentTree : expressions) {
@@ -72,20 +88,32 @@ void SkeletonQuantityMapper::process(std::vector< NamedTensorExprTree > &express
 					TensorElementFormatter(currentElement, manager)));
 			}
 
-			auto iter = std::find_if(
-				currentElement.getBlock().getIndexSlots().begin(), currentElement.getBlock().getIndexSlots().end(),
-				[](const IndexSpace &space) { return space.getSpin() == Spin::None || space.getSpin() == Spin::Both; });
+			// External indices (e.g. auxiliary indices of density-fitting factors) are spin-free by nature and are
+			// simply carried over to the skeleton quantity
+			const nonstd::span< const Index > indices = currentElement.getIndices();
+
+			auto iter = std::find_if(indices.begin(), indices.end(), [](const Index &index) {
+				return index.getSpace().getSpin() == Spin::Both
+					   || (index.getSpace().getSpin() == Spin::None && index.getType() != IndexType::External);
+			});
 
-			if (iter != currentElement.getBlock().getIndexSlots().end()) {
+			if (iter != indices.end()) {
 				getLogger().debug(
 					"Skipping {} - contains indices that have no spin or are still in spin-orbit formalism",
 					TensorElementFormatter(currentElement, manager));
 				continue;
 			}
 
-			const nonstd::span< const Index > indices = currentElement.getIndices();
 			IndexTracker tracker(indices);
 
+			if (!tracker.externals().empty() && !isFittingFactor(indices, tracker)) {
+				// Out of all tensors with external indices, only density-fitting factors B[P,p+,q-] have a known
+				// mapping to skeleton quantities
+				getLogger().debug("Skipping {} - contains external indices but is not a density-fitting factor",
+								  TensorElementFormatter(currentElement, manager));
+				continue;
+			}
+
 			// Verify that the expected symmetries exist
 			if (!containsAntisymmetryOf(currentElement.getBlock().getSlotSymmetry(), tracker.creators())) {
 				getLogger().debug("Skipping {} - The creator indices are not fully antisymmetric",
@@ -102,7 +130,6 @@ void SkeletonQuantityMapper::process(std::vector< NamedTensorExprTree > &express
 			// Therefore, the amount of Alpha and Beta spin in creators and annihilators must be identical
 
 			assert(tracker.creators().size() == tracker.annihilators().size()); // NOLINT
-			assert(tracker.externals().empty());                                // NOLINT
 
 			if (tracker.creators().empty()) {
 				// Nothing to do for scalar tensors
@@ -150,10 +177,17 @@ void replaceBySkeleton(TensorExpr &expression, const IndexTracker &tracker) {
 		baseIndexSequence.emplace_back(current.getID(), std::move(skeletonSpace), current.getType());
 	}
 
-	// Create skeleton symmetry that reflects the particle-1,2-symmetry, which skeleton
-	// quantities ought to have (same as spin-summed quantities)
-	perm::PrimitivePermutationGroup skeletonSymmetry =
-		makeColumnsymmetricExchanges(tracker.creators(), tracker.annihilators());
+	perm::PrimitivePermutationGroup skeletonSymmetry;
+	if (tracker.externals().empty()) {
+		// Create skeleton symmetry that reflects the particle-1,2-symmetry, which skeleton
+		// quantities ought to have (same as spin-summed quantities)
+		skeletonSymmetry = makeColumnsymmetricExchanges(tracker.creators(), tracker.annihilators());
+	} else {
+		// Density-fitting factors B[P,p+,q-]: the skeleton quantity is the element itself without spin labels on
+		// its orbital indices and therefore keeps all of its symmetries (e.g. (pq|P) = (qp|P))
+		assert(tracker.creators().size() == 1 && tracker.annihilators().size() == 1); // NOLINT
+		skeletonSymmetry = element.getBlock().getSlotSymmetry();
+	}
 
 
 	TensorExprTree replacementTree;
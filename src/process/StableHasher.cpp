@@ -0,0 +1,30 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#include "StableHasher.hpp"
+#include "lizard/core/Exception.hpp"
+#include "lizard/core/MemoryMappedFile.hpp"
+
+#include <fmt/core.h>
+
+namespace lizard {
+
+auto hashFileContents(const std::filesystem::path &filePath) -> std::string {
+	StableHasher hasher;
+
+	try {
+		const MemoryMappedFile file(filePath);
+
+		// NOLINTNEXTLINE(*-reinterpret-cast)
+		hasher.add(std::string_view(reinterpret_cast< const char * >(file.data()), file.size()));
+	} catch (const Exception &) {
+		// The import itself will report the actual error
+		return "unreadable";
+	}
+
+	return fmt::format("{:016x}", hasher.getHash());
+}
+
+} // namespace lizard
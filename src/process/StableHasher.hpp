@@ -0,0 +1,56 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace lizard {
+
+/**
+ * Implementation of the 64-bit FNV-1a hash. Unlike std::hash, its results are guaranteed to be stable across
+ * different runs and platforms, which is required for using them as persistent cache keys.
+ */
+class StableHasher {
+public:
+	void add(std::string_view data) {
+		add(static_cast< std::uint64_t >(data.size()));
+		for (char current : data) {
+			addByte(static_cast< std::uint8_t >(current));
+		}
+	}
+
+	template< typename T, typename = std::enable_if_t< std::is_integral_v< T > || std::is_enum_v< T > > >
+	void add(T value) {
+		auto numeric = static_cast< std::uint64_t >(value);
+		for (std::size_t i = 0; i < sizeof(T); ++i) {
+			addByte(static_cast< std::uint8_t >(numeric >> (8 * i)));
+		}
+	}
+
+	[[nodiscard]] auto getHash() const -> std::uint64_t { return m_hash; }
+
+private:
+	std::uint64_t m_hash = 0xcbf29ce484222325ULL;
+
+	void addByte(std::uint8_t byte) {
+		m_hash ^= byte;
+		m_hash *= 0x100000001b3ULL;
+	}
+};
+
+/**
+ * @returns A textual representation of the StableHasher hash over the contents of the given file, which can be used to
+ * make cache keys depend on the contents of input files. If the file can't be read, a fixed placeholder is returned
+ * instead.
+ */
+[[nodiscard]] auto hashFileContents(const std::filesystem::path &filePath) -> std::string;
+
+} // namespace lizard
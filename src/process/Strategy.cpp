@@ -17,6 +17,10 @@ void Strategy::setLogger(std::shared_ptr< spdlog::logger > logger) {
 	m_log = std::move(logger);
 }
 
+auto Strategy::getParameters() const -> std::string {
+	return {};
+}
+
 auto Strategy::getLogger() const -> spdlog::logger & {
 	assert(m_log); // NOLINT
 
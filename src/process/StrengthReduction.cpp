@@ -0,0 +1,75 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#include "ContractionOrder.hpp"
+#include "Term.hpp"
+
+#include "lizard/format/FormatSupport.hpp"
+#include "lizard/process/StrengthReduction.hpp"
+
+#include <fmt/core.h>
+
+#include <algorithm>
+
+namespace lizard {
+
+StrengthReduction::StrengthReduction(std::size_t exhaustiveSearchLimit)
+	: m_exhaustiveSearchLimit(std::min(exhaustiveSearchLimit, MaxExhaustiveSearchLimit)) {
+}
+
+auto StrengthReduction::getName() const -> std::string {
+	return "StrengthReduction";
+}
+
+auto StrengthReduction::getParameters() const -> std::string {
+	return fmt::format("exhaustiveSearchLimit={}", m_exhaustiveSearchLimit);
+}
+
+void StrengthReduction::process(std::vector< NamedTensorExprTree > &expressions, const IndexSpaceManager &manager) {
+	const CostModel model(manager);
+
+	for (NamedTensorExprTree &currentTree : expressions) {
+		if (currentTree.size() == 0) {
+			continue;
+		}
+
+		std::vector< Term > terms = splitIntoTerms(currentTree.getRoot());
+
+		if (std::none_of(terms.begin(), terms.end(), [](const Term &term) {
+				return term.factors.size() + term.compoundFactors.size() > 2;
+			})) {
+			// There is no choice in how to contract products of at most two factors
+			continue;
+		}
+
+		TensorExprTree optimized;
+		ExpressionCost totalCost;
+
+		for (const Term &currentTerm : terms) {
+			if (currentTerm.factors.size() + currentTerm.compoundFactors.size() <= 2) {
+				appendTerm(optimized, currentTerm);
+				continue;
+			}
+
+			std::vector< PlanNode > plan;
+			totalCost += planContraction(currentTerm, currentTree.getResult().getIndices(), model,
+										 m_exhaustiveSearchLimit, plan);
+
+			appendPlannedTerm(optimized, currentTerm, plan);
+		}
+
+		for (std::size_t i = 1; i < terms.size(); ++i) {
+			optimized.add(TreeNode(ExpressionOperator::Plus));
+		}
+
+		getLogger().debug("Optimized contraction order in expression for {} (estimated cost: {:.3g} FLOPs, scaling {})",
+						  TensorElementFormatter(currentTree.getResult(), manager), totalCost.flops,
+						  totalCost.scaling.toString(manager));
+
+		static_cast< TensorExprTree & >(currentTree) = std::move(optimized);
+	}
+}
+
+} // namespace lizard
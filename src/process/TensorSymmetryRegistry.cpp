@@ -0,0 +1,220 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#include "lizard/process/TensorSymmetryRegistry.hpp"
+#include "lizard/parser/ParseException.hpp"
+#include "lizard/parser/TensorSymmetryParser.hpp"
+#include "lizard/parser/TensorSymmetrySpecification.hpp"
+#include "lizard/process/ImportException.hpp"
+#include "lizard/symbolic/IndexSpaceManager.hpp"
+#include "lizard/symbolic/IndexType.hpp"
+#include "lizard/symbolic/InvalidIndexSpaceException.hpp"
+
+#include <libperm/ExplicitPermutation.hpp>
+#include <libperm/Utils.hpp>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <exception>
+#include <iterator>
+#include <utility>
+
+namespace lizard {
+
+/**
+ * A block whose symmetry is still being assembled
+ */
+struct PendingBlockSymmetry {
+	std::string tensorName;
+	std::size_t creatorCount;
+	TensorBlock::IndexSlots slots;
+	TensorBlock::SlotSymmetry group;
+};
+
+/**
+ * @returns The index spaces that the given name may stand for (one per definition of the name)
+ */
+auto expandSpaceName(const std::string &name, const std::vector< parser::IndexSpaceDefinition > &definitions)
+	-> std::vector< std::string > {
+	auto iter = std::find_if(definitions.begin(), definitions.end(),
+							 [&](const parser::IndexSpaceDefinition &current) { return current.name == name; });
+
+	if (iter == definitions.end()) {
+		return { name };
+	}
+
+	return iter->choices;
+}
+
+auto resolveSymmetrySpace(const std::string &name, const std::string &tensorName, const IndexSpaceManager &manager)
+	-> IndexSpace {
+	try {
+		return manager.createFromName(name);
+	} catch (const InvalidIndexSpaceException &) {
+		std::throw_with_nested(
+			ImportException(fmt::format("Unknown index space '{}' in symmetry of tensor '{}'", name, tensorName)));
+	}
+}
+
+/**
+ * @returns All index slot sequences described by the given symmetry definition
+ */
+auto expandSlots(const parser::TensorSymmetryDefinition &symmetry,
+				 const std::vector< parser::IndexSpaceDefinition > &definitions, const IndexSpaceManager &manager)
+	-> std::vector< TensorBlock::IndexSlots > {
+	std::vector< std::vector< IndexSpace > > choices;
+	choices.reserve(symmetry.creatorSpaces.size() + symmetry.annihilatorSpaces.size());
+
+	for (const std::vector< std::string > *names : { &symmetry.creatorSpaces, &symmetry.annihilatorSpaces }) {
+		for (const std::string &currentName : *names) {
+			std::vector< IndexSpace > &slotChoices = choices.emplace_back();
+
+			for (const std::string &currentSpace : expandSpaceName(currentName, definitions)) {
+				slotChoices.push_back(resolveSymmetrySpace(currentSpace, symmetry.tensorName, manager));
+			}
+		}
+	}
+
+	// Form the cartesian product of the choices of all slots
+	std::vector< TensorBlock::IndexSlots > slotSequences = { {} };
+	for (const std::vector< IndexSpace > &slotChoices : choices) {
+		std::vector< TensorBlock::IndexSlots > extended;
+		extended.reserve(slotSequences.size() * slotChoices.size());
+
+		for (const TensorBlock::IndexSlots &current : slotSequences) {
+			for (const IndexSpace &currentSpace : slotChoices) {
+				extended.push_back(current);
+				extended.back().push_back(currentSpace);
+			}
+		}
+
+		slotSequences = std::move(extended);
+	}
+
+	return slotSequences;
+}
+
+auto toGenerator(const parser::TensorSymmetryDefinition &symmetry) -> perm::ExplicitPermutation {
+	using value_type = perm::ExplicitPermutation::value_type;
+
+	std::vector< value_type > images(symmetry.creatorSpaces.size() + symmetry.annihilatorSpaces.size());
+	for (std::size_t i = 0; i < images.size(); ++i) {
+		images[i] = static_cast< value_type >(i);
+	}
+
+	for (const parser::SlotExchange &currentExchange : symmetry.exchanges) {
+		std::swap(images[currentExchange.first - 1], images[currentExchange.second - 1]);
+	}
+
+	return perm::ExplicitPermutation(std::move(images), symmetry.factor);
+}
+
+TensorSymmetryRegistry::TensorSymmetryRegistry(const parser::TensorSymmetrySpecification &specification,
+											   const IndexSpaceManager &manager) {
+	std::vector< PendingBlockSymmetry > pending;
+
+	for (const parser::TensorSymmetryDefinition &currentSymmetry : specification.symmetries) {
+		const perm::ExplicitPermutation generator = toGenerator(currentSymmetry);
+		const std::size_t creatorCount            = currentSymmetry.creatorSpaces.size();
+
+		for (TensorBlock::IndexSlots &currentSlots : expandSlots(currentSymmetry, specification.indexSpaces, manager)) {
+			auto iter = std::find_if(pending.begin(), pending.end(), [&](const PendingBlockSymmetry &current) {
+				return current.tensorName == currentSymmetry.tensorName && current.creatorCount == creatorCount
+					   && current.slots == currentSlots;
+			});
+
+			if (iter == pending.end()) {
+				pending.push_back(PendingBlockSymmetry{ currentSymmetry.tensorName, creatorCount,
+														std::move(currentSlots), TensorBlock::SlotSymmetry{} });
+				iter = std::prev(pending.end());
+			}
+
+			iter->group.addGenerator(generator);
+		}
+	}
+
+	for (PendingBlockSymmetry &current : pending) {
+		perm::Permutation canonicalOrder = perm::computeCanonicalizationPermutation(current.slots, current.group);
+
+		TensorBlock block =
+			std::get< 0 >(TensorBlock::create(Tensor(current.tensorName), current.slots, std::move(current.group)));
+
+		m_entries[current.tensorName].push_back(
+			Entry{ current.creatorCount, std::move(current.slots),
+				   BlockSymmetry{ std::move(block), std::move(canonicalOrder) } });
+	}
+
+	m_size = pending.size();
+}
+
+auto TensorSymmetryRegistry::fromFile(const std::filesystem::path &filePath, const IndexSpaceManager &manager)
+	-> TensorSymmetryRegistry {
+	parser::TensorSymmetrySpecification specification;
+
+	try {
+		parser::TensorSymmetryParser parser;
+		specification = parser.parse(filePath);
+	} catch (const parser::ParseException &) {
+		std::throw_with_nested(ImportException(fmt::format("Failed to parse '{}'", filePath.string())));
+	}
+
+	return TensorSymmetryRegistry(specification, manager);
+}
+
+auto TensorSymmetryRegistry::find(std::string_view tensorName, std::size_t creatorCount,
+								  const TensorBlock::IndexSlots &slots) const -> const BlockSymmetry * {
+	auto iter = m_entries.find(tensorName);
+
+	if (iter == m_entries.end()) {
+		return nullptr;
+	}
+
+	for (const Entry &current : iter->second) {
+		if (current.creatorCount == creatorCount && current.slots == slots) {
+			return &current.symmetry;
+		}
+	}
+
+	return nullptr;
+}
+
+auto TensorSymmetryRegistry::createElement(Tensor tensor, std::vector< Index > indices) const
+	-> std::tuple< TensorElement, int > {
+	TensorBlock::IndexSlots slots(indices.size());
+	std::size_t creatorCount = 0;
+
+	for (std::size_t i = 0; i < indices.size(); ++i) {
+		slots[i] = indices[i].getSpace();
+
+		if (indices[i].getType() == IndexType::Creator) {
+			creatorCount++;
+		}
+	}
+
+	const BlockSymmetry *symmetry = find(tensor.getName(), creatorCount, slots);
+
+	if (symmetry == nullptr) {
+		return TensorElement::create(std::move(tensor), std::move(indices), TensorBlock::SlotSymmetry{});
+	}
+
+	// Bring the indices into the (canonical) slot order of the prebuilt block. The block's symmetry then only has to
+	// sort indices within slots of the same space.
+	perm::applyPermutation(indices, symmetry->canonicalOrder);
+
+	auto [element, sign] = TensorElement::create(symmetry->block, std::move(indices));
+
+	return { std::move(element), sign * symmetry->canonicalOrder->sign() };
+}
+
+auto TensorSymmetryRegistry::size() const -> std::size_t {
+	return m_size;
+}
+
+auto TensorSymmetryRegistry::empty() const -> bool {
+	return m_size == 0;
+}
+
+} // namespace lizard
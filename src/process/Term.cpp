@@ -0,0 +1,513 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#include "Term.hpp"
+
+#include "lizard/symbolic/ExpressionOperator.hpp"
+#include "lizard/symbolic/ExpressionType.hpp"
+#include "lizard/symbolic/TreeNode.hpp"
+#include "lizard/symbolic/TreeTraversal.hpp"
+
+#include <libperm/Permutation.hpp>
+#include <libperm/Utils.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <set>
+#include <string_view>
+#include <tuple>
+#include <utility>
+
+namespace lizard {
+
+void collectFactors(const ConstTensorExpr &expression, Term &term) {
+	switch (expression.getType()) {
+		case ExpressionType::Literal:
+			term.prefactor *= expression.getLiteral();
+			return;
+		case ExpressionType::Variable:
+			term.factors.push_back(expression.getVariable());
+			return;
+		case ExpressionType::Operator:
+			break;
+	}
+
+	switch (expression.getOperator()) {
+		case ExpressionOperator::Times:
+			collectFactors(expression.getLeftArg(), term);
+			collectFactors(expression.getRightArg(), term);
+			break;
+		case ExpressionOperator::Plus: {
+			TensorExprTree compound;
+			appendExpression(compound, expression);
+			term.compoundFactors.push_back(std::move(compound));
+			break;
+		}
+	}
+}
+
+void collectTerms(const ConstTensorExpr &expression, std::vector< Term > &terms) {
+	if (expression.getType() == ExpressionType::Operator && expression.getOperator() == ExpressionOperator::Plus) {
+		collectTerms(expression.getLeftArg(), terms);
+		collectTerms(expression.getRightArg(), terms);
+		return;
+	}
+
+	Term term;
+	collectFactors(expression, term);
+	terms.push_back(std::move(term));
+}
+
+auto splitIntoTerms(const ConstTensorExpr &expression) -> std::vector< Term > {
+	std::vector< Term > terms;
+	collectTerms(expression, terms);
+
+	return terms;
+}
+
+auto getOpenIndices(const Term &term) -> std::vector< Index > {
+	std::vector< Index > indices;
+	for (const TensorElement &currentFactor : term.factors) {
+		indices.insert(indices.end(), currentFactor.getIndices().begin(), currentFactor.getIndices().end());
+	}
+	for (const TensorExprTree &currentCompound : term.compoundFactors) {
+		const std::vector< Index > compoundIndices = getOpenIndices(splitIntoTerms(currentCompound.getRoot()).front());
+		indices.insert(indices.end(), compoundIndices.begin(), compoundIndices.end());
+	}
+
+	std::map< IndexName, std::size_t > occurrences;
+	for (const Index &currentIndex : indices) {
+		occurrences[getName(currentIndex)]++;
+	}
+
+	std::vector< Index > open;
+	std::copy_if(indices.begin(), indices.end(), std::back_inserter(open),
+				 [&](const Index &index) { return occurrences[getName(index)] == 1; });
+
+	return open;
+}
+
+void appendExpression(TensorExprTree &tree, const ConstTensorExpr &expression) {
+	for (auto iter = expression.cbegin< TreeTraversal::DepthFirst_PostOrder >();
+		 iter != expression.cend< TreeTraversal::DepthFirst_PostOrder >(); ++iter) {
+		switch (iter->getType()) {
+			case ExpressionType::Literal:
+				tree.add(TreeNode(iter->getLiteral()));
+				break;
+			case ExpressionType::Variable:
+				tree.add(iter->getVariable());
+				break;
+			case ExpressionType::Operator:
+				tree.add(TreeNode(iter->getOperator()));
+				break;
+		}
+	}
+}
+
+void appendTerm(TensorExprTree &tree, const Term &term) {
+	// All operands are added before the respective operators, which results in a right-associative product
+	// (a * (b * c)), which is the same form the parsers produce for such expressions
+	std::size_t operandCount = 0;
+
+	if (term.prefactor != 1 || (term.factors.empty() && term.compoundFactors.empty())) {
+		tree.add(TreeNode(term.prefactor));
+		operandCount++;
+	}
+
+	for (const TensorElement &current : term.factors) {
+		tree.add(current);
+		operandCount++;
+	}
+
+	for (const TensorExprTree &current : term.compoundFactors) {
+		appendExpression(tree, current.getRoot());
+		operandCount++;
+	}
+
+	for (std::size_t i = 1; i < operandCount; ++i) {
+		tree.add(TreeNode(ExpressionOperator::Times));
+	}
+}
+
+auto buildSum(const std::vector< Term > &terms) -> TensorExprTree {
+	TensorExprTree tree;
+
+	if (terms.empty()) {
+		tree.add(TreeNode(0));
+		return tree;
+	}
+
+	for (const Term &current : terms) {
+		appendTerm(tree, current);
+	}
+
+	for (std::size_t i = 1; i < terms.size(); ++i) {
+		tree.add(TreeNode(ExpressionOperator::Plus));
+	}
+
+	return tree;
+}
+
+auto compareElements(const TensorElement &lhs, const TensorElement &rhs) -> bool {
+	const std::string_view lhsName = lhs.getBlock().getTensor().getName();
+	const std::string_view rhsName = rhs.getBlock().getTensor().getName();
+
+	if (lhsName != rhsName) {
+		return lhsName < rhsName;
+	}
+
+	return std::lexicographical_compare(lhs.getIndices().begin(), lhs.getIndices().end(), rhs.getIndices().begin(),
+										rhs.getIndices().end());
+}
+
+/**
+ * Upper limit for the number of factor orderings that are considered during canonicalization of a single term
+ */
+constexpr const std::size_t MaxCanonicalizationCandidates = 5040;
+
+auto getName(const Index &index) -> IndexName {
+	return { index.getID(), index.getSpace().getID() };
+}
+
+/**
+ * Description of the index structure of a tensor element that doesn't depend on the names of its dummy indices. For
+ * every index slot, it contains the slot's space and type, whether it holds a dummy index and (for non-dummy indices)
+ * the index's ID.
+ */
+using IndexSignature = std::vector< std::tuple< IndexSpace, IndexType, bool, Index::Id > >;
+
+/**
+ * A factor of a term together with the information required to find its canonical representation
+ */
+struct CanonicalizationFactor {
+	TensorElement element;
+	IndexSignature signature;
+	std::vector< perm::Permutation > symmetry;
+};
+
+/**
+ * @returns The signature of the given sequence of indices
+ */
+auto createSignature(const std::vector< Index > &indices, const std::set< IndexName > &dummies) -> IndexSignature {
+	IndexSignature signature;
+	signature.reserve(indices.size());
+
+	for (const Index &currentIndex : indices) {
+		const bool isDummy = dummies.find(getName(currentIndex)) != dummies.end();
+
+		signature.emplace_back(currentIndex.getSpace(), currentIndex.getType(), isDummy,
+							   isDummy ? Index::Id{} : currentIndex.getID());
+	}
+
+	return signature;
+}
+
+/**
+ * @returns Whether the given permutation maps every index slot onto a slot of the same space
+ */
+auto preservesSlots(const perm::Permutation &permutation, const TensorBlock::IndexSlots &slots) -> bool {
+	for (std::size_t i = 0; i < slots.size(); ++i) {
+		if (slots[permutation->image(static_cast< perm::Permutation::value_type >(i))] != slots[i]) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/**
+ * @returns The lexicographically smallest signature of the given element out of all index orders that are related by
+ * the element's slot symmetry. Thereby, the result is the same for all equivalent ways of writing the element.
+ */
+auto getSignature(const TensorElement &element, const std::vector< perm::Permutation > &symmetry,
+				  const std::set< IndexName > &dummies) -> IndexSignature {
+	const std::vector< Index > indices(element.getIndices().begin(), element.getIndices().end());
+	IndexSignature best = createSignature(indices, dummies);
+
+	for (const perm::Permutation &currentPerm : symmetry) {
+		std::vector< Index > permuted = indices;
+		perm::applyPermutation(permuted, currentPerm);
+
+		IndexSignature signature = createSignature(permuted, dummies);
+		if (signature < best) {
+			best = std::move(signature);
+		}
+	}
+
+	return best;
+}
+
+/**
+ * Orders factors in a way that is independent of the names of the dummy indices they carry and of the order in which
+ * their indices are written
+ */
+auto compareSignatures(const CanonicalizationFactor &lhs, const CanonicalizationFactor &rhs) -> bool {
+	const std::string_view lhsName = lhs.element.getBlock().getTensor().getName();
+	const std::string_view rhsName = rhs.element.getBlock().getTensor().getName();
+
+	if (lhsName != rhsName) {
+		return lhsName < rhsName;
+	}
+
+	if (lhs.signature.size() != rhs.signature.size()) {
+		return lhs.signature.size() < rhs.signature.size();
+	}
+
+	return lhs.signature < rhs.signature;
+}
+
+/**
+ * Renames the dummy indices in the given factors in the order of their first appearance, using the lowest IDs that
+ * are not taken by any of the non-dummy indices. Before renaming, the indices of every factor are reordered by means of
+ * the respective permutation out of the given ones, which has to be a member of the factor's slot symmetry (nullptr
+ * keeps the current order). The applied renaming is stored in the given map.
+ *
+ * @returns The sign change that results from reordering the indices and from bringing the indices of the renamed
+ * factors back into canonical order
+ */
+auto relabelDummies(std::vector< TensorElement > &factors, const std::vector< const perm::Permutation * > &images,
+					const std::set< IndexName > &dummies, const std::set< IndexName > &fixed,
+					std::map< IndexName, Index::Id > &replacements) -> int {
+	assert(factors.size() == images.size()); // NOLINT
+
+	std::map< IndexSpace::Id, Index::Id > nextID;
+	replacements.clear();
+	int sign = 1;
+
+	for (std::size_t i = 0; i < factors.size(); ++i) {
+		TensorElement &currentFactor = factors[i];
+		std::vector< Index > indices(currentFactor.getIndices().begin(), currentFactor.getIndices().end());
+
+		if (images[i] != nullptr) {
+			perm::applyPermutation(indices, *images[i]);
+			sign *= (*images[i])->sign();
+		}
+
+		for (Index &currentIndex : indices) {
+			const IndexName name = getName(currentIndex);
+			if (dummies.find(name) == dummies.end()) {
+				continue;
+			}
+
+			auto iter = replacements.find(name);
+			if (iter == replacements.end()) {
+				Index::Id &candidate = nextID[name.second];
+				while (fixed.find({ candidate, name.second }) != fixed.end()) {
+					candidate++;
+				}
+
+				iter = replacements.insert({ name, candidate++ }).first;
+			}
+
+			currentIndex.setID(iter->second);
+		}
+
+		auto [element, elementSign] = TensorElement::create(currentFactor.getBlock(), std::move(indices));
+		currentFactor               = std::move(element);
+		sign *= elementSign;
+	}
+
+	return sign;
+}
+
+auto canonicalize(Term &term, bool renameExternals) -> std::map< IndexName, Index::Id > {
+	// Dummy indices are those that are contracted within the product, i.e. that appear exactly twice. Indices that
+	// appear inside compound factors are never renamed as that would require renaming them inside of those as well.
+	std::map< IndexName, std::size_t > occurrences;
+	for (const TensorElement &currentFactor : term.factors) {
+		for (const Index &currentIndex : currentFactor.getIndices()) {
+			occurrences[getName(currentIndex)]++;
+		}
+	}
+
+	std::set< IndexName > fixed;
+	for (const TensorExprTree &currentCompound : term.compoundFactors) {
+		for (const ConstTensorExpr &currentExpr : currentCompound) {
+			if (currentExpr.getType() == ExpressionType::Variable) {
+				for (const Index &currentIndex : currentExpr.getVariable().getIndices()) {
+					fixed.insert(getName(currentIndex));
+				}
+			}
+		}
+	}
+
+	std::set< IndexName > dummies;
+	for (const auto &[name, count] : occurrences) {
+		if ((count == 2 || renameExternals) && fixed.find(name) == fixed.end()) {
+			dummies.insert(name);
+		} else {
+			fixed.insert(name);
+		}
+	}
+
+	std::vector< CanonicalizationFactor > factors;
+	factors.reserve(term.factors.size());
+	for (TensorElement &currentFactor : term.factors) {
+		std::vector< perm::Permutation > symmetry;
+		currentFactor.getBlock().getSlotSymmetry().getElementsTo(symmetry);
+
+		// Only permutations that keep every index in a slot of its space yield a valid way of writing the element
+		const TensorBlock::IndexSlots &slots = currentFactor.getBlock().getIndexSlots();
+		const auto isInvalid = [&slots](const perm::Permutation &current) { return !preservesSlots(current, slots); };
+		symmetry.erase(std::remove_if(symmetry.begin(), symmetry.end(), isInvalid), symmetry.end());
+
+		IndexSignature signature = getSignature(currentFactor, symmetry, dummies);
+
+		factors.push_back({ std::move(currentFactor), std::move(signature), std::move(symmetry) });
+	}
+
+	std::stable_sort(factors.begin(), factors.end(), &compareSignatures);
+
+	// Factors that can't be distinguished without looking at the names of dummy indices have to be tried out in all
+	// possible orders in order to find the canonical one
+	std::vector< std::pair< std::size_t, std::size_t > > ties;
+	std::size_t candidateCount = 1;
+	for (std::size_t begin = 0; begin < factors.size();) {
+		std::size_t end = begin + 1;
+		while (end < factors.size() && !compareSignatures(factors[begin], factors[end])) {
+			end++;
+		}
+
+		if (end - begin > 1) {
+			ties.push_back({ begin, end });
+
+			for (std::size_t i = 2; i <= end - begin; ++i) {
+				candidateCount *= i;
+			}
+		}
+
+		begin = end;
+	}
+
+	if (candidateCount > MaxCanonicalizationCandidates) {
+		// Too many possibilities -> stick to the initial order, which may cause some equivalent terms to be missed
+		ties.clear();
+		candidateCount = 1;
+	}
+
+	// The order in which the indices of a factor are written can be changed by its slot symmetry, which affects the
+	// order in which dummy indices are encountered. Therefore, all symmetry-equivalent index orders have to be tried
+	// out as well.
+	for (const CanonicalizationFactor &currentFactor : factors) {
+		candidateCount *= std::max< std::size_t >(currentFactor.symmetry.size(), 1);
+
+		if (candidateCount > MaxCanonicalizationCandidates) {
+			break;
+		}
+	}
+
+	if (candidateCount > MaxCanonicalizationCandidates) {
+		// Too many possibilities -> stick to the canonical index order of the individual factors
+		for (CanonicalizationFactor &currentFactor : factors) {
+			currentFactor.symmetry.clear();
+		}
+	}
+
+	const auto elementOrder = [](const CanonicalizationFactor &lhs, const CanonicalizationFactor &rhs) {
+		return compareElements(lhs.element, rhs.element);
+	};
+
+	// Enumerating all permutations requires starting from the lexicographically smallest one
+	for (const auto &[begin, end] : ties) {
+		std::sort(factors.begin() + static_cast< std::ptrdiff_t >(begin),
+				  factors.begin() + static_cast< std::ptrdiff_t >(end), elementOrder);
+	}
+
+	std::vector< TensorElement > best;
+	int bestSign = 1;
+	std::map< IndexName, Index::Id > bestRenaming;
+	std::map< IndexName, Index::Id > renaming;
+
+	std::vector< std::size_t > imageChoices(factors.size(), 0);
+	std::vector< const perm::Permutation * > images(factors.size(), nullptr);
+
+	while (true) {
+		// Try all combinations of symmetry-equivalent index orders of the factors (odometer-style)
+		while (true) {
+			std::vector< TensorElement > candidate;
+			candidate.reserve(factors.size());
+			for (std::size_t i = 0; i < factors.size(); ++i) {
+				candidate.push_back(factors[i].element);
+				images[i] = factors[i].symmetry.empty() ? nullptr : &factors[i].symmetry[imageChoices[i]];
+			}
+
+			const int sign = relabelDummies(candidate, images, dummies, fixed, renaming);
+
+			if (best.empty()
+				|| std::lexicographical_compare(candidate.begin(), candidate.end(), best.begin(), best.end(),
+												&compareElements)) {
+				best         = std::move(candidate);
+				bestSign     = sign;
+				bestRenaming = renaming;
+			}
+
+			std::size_t i = 0;
+			for (; i < factors.size(); ++i) {
+				if (++imageChoices[i] < factors[i].symmetry.size()) {
+					break;
+				}
+
+				imageChoices[i] = 0;
+			}
+
+			if (i == factors.size()) {
+				break;
+			}
+		}
+
+		// Advance to the next combination of orderings of the tied factors (odometer-style)
+		std::size_t i = 0;
+		for (; i < ties.size(); ++i) {
+			auto begin = factors.begin() + static_cast< std::ptrdiff_t >(ties[i].first);
+			auto end   = factors.begin() + static_cast< std::ptrdiff_t >(ties[i].second);
+
+			if (std::next_permutation(begin, end, elementOrder)) {
+				break;
+			}
+		}
+
+		if (i == ties.size()) {
+			break;
+		}
+	}
+
+	term.factors = std::move(best);
+	term.prefactor *= bestSign;
+
+	return bestRenaming;
+}
+
+void combineHash(std::size_t &seed, std::size_t hash) {
+	seed ^= hash + 0x9e3779b9 + (seed << 6) + (seed >> 2); // NOLINT
+}
+
+auto hashFactors(const Term &term) -> std::size_t {
+	std::size_t hash = term.factors.size();
+
+	for (const TensorElement &current : term.factors) {
+		combineHash(hash, std::hash< TensorElement >{}(current));
+	}
+
+	for (const TensorExprTree &current : term.compoundFactors) {
+		combineHash(hash, current.size());
+
+		for (const ConstTensorExpr &currentExpr : current) {
+			if (currentExpr.getType() == ExpressionType::Variable) {
+				combineHash(hash, std::hash< TensorElement >{}(currentExpr.getVariable()));
+			}
+		}
+	}
+
+	return hash;
+}
+
+auto haveSameFactors(const Term &lhs, const Term &rhs) -> bool {
+	return lhs.factors == rhs.factors && lhs.compoundFactors == rhs.compoundFactors;
+}
+
+} // namespace lizard
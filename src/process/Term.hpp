@@ -0,0 +1,86 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#pragma once
+
+#include "lizard/core/Fraction.hpp"
+#include "lizard/symbolic/TensorExpressions.hpp"
+
+#include <cstdint>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace lizard {
+
+/**
+ * Flat representation of a single term of a sum, i.e. of a product of the form
+ * prefactor * factors[0] * factors[1] * ... * compoundFactors[0] * ...
+ * Compound factors are those that can't be represented as a single TensorElement (e.g. parenthesized sums).
+ */
+struct Term {
+	Fraction prefactor = 1;
+	std::vector< TensorElement > factors;
+	std::vector< TensorExprTree > compoundFactors;
+};
+
+/**
+ * Name of an index, which is independent of its type and of the spin of its space
+ */
+using IndexName = std::pair< Index::Id, IndexSpace::Id >;
+
+/**
+ * @returns The name of the given Index
+ */
+[[nodiscard]] auto getName(const Index &index) -> IndexName;
+
+/**
+ * Splits the given expression into its additive terms
+ */
+[[nodiscard]] auto splitIntoTerms(const ConstTensorExpr &expression) -> std::vector< Term >;
+
+/**
+ * @returns The indices of the given term that are not contracted within it, in order of their appearance. For compound
+ * factors, the open indices of their first addend are used.
+ */
+[[nodiscard]] auto getOpenIndices(const Term &term) -> std::vector< Index >;
+
+/**
+ * Appends the given expression (in post-order) to the given tree
+ */
+void appendExpression(TensorExprTree &tree, const ConstTensorExpr &expression);
+
+/**
+ * Appends the product represented by the given term to the given tree
+ */
+void appendTerm(TensorExprTree &tree, const Term &term);
+
+/**
+ * @returns A tree representing the sum of the given terms. If there are no terms, the tree will represent zero.
+ */
+[[nodiscard]] auto buildSum(const std::vector< Term > &terms) -> TensorExprTree;
+
+/**
+ * Brings the given term into a canonical form in which terms that only differ in the order of their factors, in the
+ * names of their contracted (dummy) indices and/or in the order in which the slot symmetries of their factors allow to
+ * write their indices become identical. Any sign change that results from restoring the canonical index order of the
+ * renamed tensor elements is absorbed into the term's prefactor.
+ *
+ * @param renameExternals Whether the indices that are not contracted within the term shall be renamed as well
+ * @returns The applied renaming as a map of original index names to the new ID of the respective index
+ */
+auto canonicalize(Term &term, bool renameExternals = false) -> std::map< IndexName, Index::Id >;
+
+/**
+ * @returns A hash over the non-literal part of the given term
+ */
+[[nodiscard]] auto hashFactors(const Term &term) -> std::size_t;
+
+/**
+ * @returns Whether the non-literal parts of the given terms are identical
+ */
+[[nodiscard]] auto haveSameFactors(const Term &lhs, const Term &rhs) -> bool;
+
+} // namespace lizard
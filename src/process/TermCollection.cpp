@@ -0,0 +1,68 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#include "Term.hpp"
+
+#include "lizard/format/FormatSupport.hpp"
+#include "lizard/process/TermCollection.hpp"
+
+#include <algorithm>
+#include <unordered_map>
+
+namespace lizard {
+
+auto TermCollection::getName() const -> std::string {
+	return "TermCollection";
+}
+
+void TermCollection::process(std::vector< NamedTensorExprTree > &expressions, const IndexSpaceManager &manager) {
+	for (NamedTensorExprTree &currentTree : expressions) {
+		if (currentTree.size() == 0) {
+			continue;
+		}
+
+		std::vector< Term > terms           = splitIntoTerms(currentTree.getRoot());
+		const std::size_t originalTermCount = terms.size();
+
+		std::vector< Term > collected;
+		collected.reserve(terms.size());
+
+		// Maps the hash of the non-literal part of a term to the positions of all collected terms with that hash
+		std::unordered_map< std::size_t, std::vector< std::size_t > > buckets;
+
+		for (Term &currentTerm : terms) {
+			canonicalize(currentTerm);
+
+			std::vector< std::size_t > &candidates = buckets[hashFactors(currentTerm)];
+
+			auto iter = std::find_if(candidates.begin(), candidates.end(), [&](std::size_t candidate) {
+				return haveSameFactors(collected[candidate], currentTerm);
+			});
+
+			if (iter != candidates.end()) {
+				collected[*iter].prefactor += currentTerm.prefactor;
+			} else {
+				candidates.push_back(collected.size());
+				collected.push_back(std::move(currentTerm));
+			}
+		}
+
+		// Terms whose prefactors have cancelled out don't contribute anymore
+		collected.erase(
+			std::remove_if(collected.begin(), collected.end(), [](const Term &term) { return term.prefactor == 0; }),
+			collected.end());
+
+		if (collected.size() == originalTermCount) {
+			continue;
+		}
+
+		getLogger().debug("Collected {} terms into {} terms in expression for {}", originalTermCount, collected.size(),
+						  TensorElementFormatter(currentTree.getResult(), manager));
+
+		static_cast< TensorExprTree & >(currentTree) = buildSum(collected);
+	}
+}
+
+} // namespace lizard
@@ -6,24 +6,41 @@
 #include "lizard/process/TextExport.hpp"
 #include "lizard/format/FormatSupport.hpp"
 #include "lizard/format/details/SymbolicFormatter.hpp"
+#include "lizard/process/MappedTensorExprTree.hpp"
 
 #include <fmt/core.h>
 
+#include <string>
 
 
-struct TreeSpanFormatter : lizard::details::SymbolicFormatter< nonstd::span< const lizard::NamedTensorExprTree > > {
-	using lizard::details::SymbolicFormatter< nonstd::span< const lizard::NamedTensorExprTree > >::SymbolicFormatter;
+auto formatTree(const lizard::NamedTensorExprTree &tree, const lizard::IndexSpaceManager &manager) -> std::string {
+	return fmt::format("{}", lizard::NamedTensorExprTreeFormatter(tree, manager));
+}
+
+auto formatTree(const lizard::MappedTensorExprTree &tree, const lizard::IndexSpaceManager &manager) -> std::string {
+	if (tree.isEmpty()) {
+		return fmt::format("{} = 0", lizard::TensorElementFormatter(tree.getResult(), manager));
+	}
+
+	return fmt::format("{} = {}", lizard::TensorElementFormatter(tree.getResult(), manager),
+					   lizard::details::formatExpression(tree.getRoot(), manager));
+}
+
+
+template< typename Tree > struct TreeSpanFormatter : lizard::details::SymbolicFormatter< nonstd::span< const Tree > > {
+	using lizard::details::SymbolicFormatter< nonstd::span< const Tree > >::SymbolicFormatter;
 };
 
 
-template<> struct fmt::formatter< TreeSpanFormatter > : fmt::formatter< std::string_view > {
-	template< typename FormatContext > auto format(const TreeSpanFormatter &formatter, FormatContext &ctx) {
+template< typename Tree > struct fmt::formatter< TreeSpanFormatter< Tree > > : fmt::formatter< std::string_view > {
+	template< typename FormatContext > auto format(const TreeSpanFormatter< Tree > &formatter, FormatContext &ctx) {
 		const lizard::IndexSpaceManager &manager = formatter.getManager();
 
 		std::string formatted = fmt::format("Total amount of expressions: {}", formatter.get().size());
 
-		for (const lizard::NamedTensorExprTree &tree : formatter.get()) {
-			formatted += fmt::format("\n  {}", lizard::NamedTensorExprTreeFormatter(tree, manager));
+		for (const Tree &tree : formatter.get()) {
+			formatted += "\n  ";
+			formatted += formatTree(tree, manager);
 		}
 
 		return fmt::formatter< std::string_view >::format(formatted, ctx);
@@ -38,7 +55,12 @@ auto TextExport::getName() const -> std::string {
 
 void TextExport::exportExpressions(nonstd::span< const NamedTensorExprTree > expressions,
 								   const IndexSpaceManager &manager) {
-	getLogger().info("{}", TreeSpanFormatter(expressions, manager));
+	getLogger().info("{}", TreeSpanFormatter< NamedTensorExprTree >(expressions, manager));
+}
+
+void TextExport::exportExpressions(nonstd::span< const MappedTensorExprTree > expressions,
+								   const IndexSpaceManager &manager) {
+	getLogger().info("{}", TreeSpanFormatter< MappedTensorExprTree >(expressions, manager));
 }
 
 } // namespace lizard
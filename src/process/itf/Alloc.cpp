@@ -6,16 +6,15 @@
 #include "Alloc.hpp"
 #include "TensorFormatter.hpp"
 
-#include <fmt/core.h>
-
 
 namespace lizard::itf {
 
 Alloc::Alloc(TensorElement element) : m_element(std::move(element)) {
 }
 
-auto Alloc::stringify(const IndexSpaceManager &manager) const -> std::string {
-	return fmt::format("alloc {}", TensorFormatter(m_element, manager));
+void Alloc::formatTo(fmt::memory_buffer &buffer, const IndexSpaceManager &manager) const {
+	appendText(buffer, "alloc ");
+	appendTensor(buffer, m_element, manager);
 }
 
 } // namespace lizard::itf
@@ -18,7 +18,7 @@ class Alloc : public Operation {
 public:
 	Alloc(TensorElement element);
 
-	[[nodiscard]] auto stringify(const IndexSpaceManager &manager) const -> std::string override;
+	void formatTo(fmt::memory_buffer &buffer, const IndexSpaceManager &manager) const override;
 
 private:
 	TensorElement m_element;
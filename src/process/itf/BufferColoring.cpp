@@ -0,0 +1,86 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#include "BufferColoring.hpp"
+#include "Contract.hpp"
+#include "Liveness.hpp"
+
+#include <algorithm>
+#include <string>
+#include <unordered_map>
+
+
+namespace lizard::itf {
+
+struct IntermediateUsage {
+	TensorBlock block;
+	std::size_t firstWrite;
+	std::size_t lastAccess;
+};
+
+struct Buffer {
+	TensorBlock block;
+	std::size_t lastAccess;
+};
+
+[[nodiscard]] auto haveSameShape(const TensorBlock &lhs, const TensorBlock &rhs) -> bool {
+	return lhs.getIndexSlots() == rhs.getIndexSlots() && lhs.getSlotSymmetry() == rhs.getSlotSymmetry();
+}
+
+auto colorIntermediates(std::vector< std::unique_ptr< Operation > > &operations) -> ColoringResult {
+	// Intermediates are listed in the order in which they are first written to
+	std::vector< IntermediateUsage > usages;
+	std::unordered_map< std::string, std::size_t > usageIndices;
+
+	auto recordAccess = [&](const TensorElement &element, std::size_t position) {
+		if (!isIntermediate(element)) {
+			return;
+		}
+
+		auto [iter, inserted] =
+			usageIndices.insert({ std::string(element.getBlock().getTensor().getName()), usages.size() });
+		if (inserted) {
+			usages.push_back(IntermediateUsage{ element.getBlock(), position, position });
+		} else {
+			usages[iter->second].lastAccess = position;
+		}
+	};
+
+	for (std::size_t i = 0; i < operations.size(); ++i) {
+		if (const TensorElement *written = getWrittenElement(*operations[i]); written != nullptr) {
+			recordAccess(*written, i);
+		}
+
+		for (const TensorElement &currentElement : getReadElements(*operations[i])) {
+			recordAccess(currentElement, i);
+		}
+	}
+
+	std::vector< Buffer > buffers;
+
+	for (const IntermediateUsage &currentUsage : usages) {
+		auto iter = std::find_if(buffers.begin(), buffers.end(), [&](const Buffer &buffer) {
+			// An operation can't read from a buffer and write to it at the same time, hence the strict comparison
+			return buffer.lastAccess < currentUsage.firstWrite && haveSameShape(buffer.block, currentUsage.block);
+		});
+
+		if (iter == buffers.end()) {
+			buffers.push_back(Buffer{ currentUsage.block, currentUsage.lastAccess });
+			continue;
+		}
+
+		iter->lastAccess = currentUsage.lastAccess;
+
+		for (std::size_t i = currentUsage.firstWrite; i <= currentUsage.lastAccess; ++i) {
+			if (auto *contraction = dynamic_cast< Contract * >(operations[i].get()); contraction != nullptr) {
+				contraction->replaceTensor(currentUsage.block.getTensor(), iter->block.getTensor());
+			}
+		}
+	}
+
+	return { usages.size(), buffers.size() };
+}
+
+} // namespace lizard::itf
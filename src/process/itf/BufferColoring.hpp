@@ -0,0 +1,40 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#pragma once
+
+#include "Operation.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace lizard::itf {
+
+/**
+ * Statistics about the storage required for the intermediates in a sequence of operations
+ */
+struct ColoringResult {
+	/**
+	 * The number of distinct intermediates
+	 */
+	std::size_t intermediates = 0;
+	/**
+	 * The number of distinct buffers (tensor names) used to store these intermediates
+	 */
+	std::size_t buffers = 0;
+};
+
+/**
+ * Lets intermediates share storage, if their lifetimes don't overlap and they have the same shape (index slots and
+ * symmetry). This corresponds to coloring the interference graph of the intermediates, which is an interval graph and
+ * can therefore be colored optimally by assigning buffers in the order in which the intermediates are first written
+ * to. All intermediates sharing a buffer are renamed to the name of the buffer's first user.
+ *
+ * Note: This has to be applied before alloc and drop operations are inserted.
+ */
+auto colorIntermediates(std::vector< std::unique_ptr< Operation > > &operations) -> ColoringResult;
+
+} // namespace lizard::itf
@@ -6,10 +6,6 @@
 #include "Contract.hpp"
 #include "TensorFormatter.hpp"
 
-#include "lizard/format/FormatSupport.hpp"
-
-#include <fmt/core.h>
-
 
 namespace lizard::itf {
 
@@ -34,14 +30,23 @@ auto Contract::getRhs() const -> const TensorExpression & {
 	return m_rhs;
 }
 
-auto Contract::stringify(const IndexSpaceManager &manager) const -> std::string {
-	if (getFactor() == 1) {
-		return fmt::format(".{} += {} {}", itf::TensorFormatter(m_result, manager), m_lhs.stringify(manager),
-						   m_rhs.stringify(manager));
-	}
+void Contract::replaceTensor(const Tensor &original, const Tensor &replacement) {
+	replaceTensorIn(m_result, original, replacement);
+	m_lhs.replaceTensor(original, replacement);
+	m_rhs.replaceTensor(original, replacement);
+}
 
-	return fmt::format(".{} += {}*{} {}", itf::TensorFormatter(m_result, manager), getFactor(),
-					   m_lhs.stringify(manager), m_rhs.stringify(manager));
+void Contract::formatTo(fmt::memory_buffer &buffer, const IndexSpaceManager &manager) const {
+	buffer.push_back('.');
+	appendTensor(buffer, m_result, manager);
+	appendText(buffer, " += ");
+	if (getFactor() != 1) {
+		appendFactor(buffer, getFactor());
+		buffer.push_back('*');
+	}
+	m_lhs.formatTo(buffer, manager);
+	buffer.push_back(' ');
+	m_rhs.formatTo(buffer, manager);
 }
 
 } // namespace lizard::itf
@@ -40,7 +40,13 @@ public:
 	 */
 	[[nodiscard]] auto getRhs() const -> const TensorExpression &;
 
-	[[nodiscard]] auto stringify(const IndexSpaceManager &manager) const -> std::string override;
+	/**
+	 * Replaces all references to the given tensor (in the result as well as in the operands) by references to the
+	 * replacement tensor
+	 */
+	void replaceTensor(const Tensor &original, const Tensor &replacement);
+
+	void formatTo(fmt::memory_buffer &buffer, const IndexSpaceManager &manager) const override;
 
 private:
 	TensorElement m_result;
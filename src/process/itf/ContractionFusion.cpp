@@ -0,0 +1,159 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#include "ContractionFusion.hpp"
+#include "Contract.hpp"
+#include "Liveness.hpp"
+#include "TensorExpression.hpp"
+
+#include "lizard/symbolic/ExpressionCardinality.hpp"
+#include "lizard/symbolic/Tensor.hpp"
+#include "lizard/symbolic/TensorElement.hpp"
+
+#include <algorithm>
+#include <optional>
+
+namespace lizard::itf {
+
+namespace {
+
+/**
+ * A way of writing a contraction as the product of a plain tensor element and a (scaled) other operand
+ */
+struct FusionOperand {
+	TensorElement shared;
+	TensorExpression other;
+};
+
+/**
+ * @returns All ways of splitting the given contraction into a shared and another operand
+ */
+auto getFusionOperands(const Contract &contraction) -> std::vector< FusionOperand > {
+	std::vector< FusionOperand > operands;
+
+	if (contraction.getLhs().getCardinality() == ExpressionCardinality::Nullary) {
+		TensorExpression other = contraction.getRhs();
+		other *= contraction.getFactor() * contraction.getLhs().getFactor();
+
+		operands.push_back({ contraction.getLhs().getResult(), std::move(other) });
+	}
+
+	if (contraction.getRhs().getCardinality() == ExpressionCardinality::Nullary) {
+		TensorExpression other = contraction.getLhs();
+		other *= contraction.getFactor() * contraction.getRhs().getFactor();
+
+		operands.push_back({ contraction.getRhs().getResult(), std::move(other) });
+	}
+
+	return operands;
+}
+
+/**
+ * @returns Whether the two given expressions can be summed up, which requires all involved elements to carry the same
+ * indices and symmetry
+ */
+auto canBeSummed(const TensorExpression &lhs, const TensorExpression &rhs) -> bool {
+	const TensorElement &reference = lhs.getResult();
+
+	std::vector< TensorElement > elements    = lhs.getElements();
+	std::vector< TensorElement > rhsElements = rhs.getElements();
+	elements.insert(elements.end(), rhsElements.begin(), rhsElements.end());
+
+	return std::all_of(elements.begin(), elements.end(), [&](const TensorElement &current) {
+		return current.getIndices().size() == reference.getIndices().size()
+			   && std::is_permutation(reference.getIndices().begin(), reference.getIndices().end(),
+									  current.getIndices().begin())
+			   && current.getBlock().getSlotSymmetry() == reference.getBlock().getSlotSymmetry();
+	});
+}
+
+/**
+ * @returns The contraction that is equivalent to performing both of the given contractions or an empty optional, if
+ * they can't be merged
+ */
+auto tryMerge(const Contract &first, const Contract &second) -> std::optional< Contract > {
+	if (!(first.getResult() == second.getResult())) {
+		return {};
+	}
+
+	for (FusionOperand &firstOperand : getFusionOperands(first)) {
+		for (FusionOperand &secondOperand : getFusionOperands(second)) {
+			if (!(firstOperand.shared == secondOperand.shared)
+				|| !canBeSummed(firstOperand.other, secondOperand.other)) {
+				continue;
+			}
+
+			firstOperand.other += secondOperand.other;
+
+			return Contract(first.getResult(), std::move(firstOperand.shared), std::move(firstOperand.other));
+		}
+	}
+
+	return {};
+}
+
+auto readsTensor(const Operation &operation, const Tensor &tensor) -> bool {
+	const std::vector< TensorElement > reads = getReadElements(operation);
+
+	return std::any_of(reads.begin(), reads.end(),
+					   [&](const TensorElement &current) { return current.getBlock().getTensor() == tensor; });
+}
+
+} // namespace
+
+auto fuseContractions(std::vector< std::unique_ptr< Operation > > &operations) -> std::size_t {
+	std::size_t fused = 0;
+
+	for (std::size_t j = 0; j < operations.size(); ++j) {
+		const auto *later = dynamic_cast< const Contract * >(operations[j].get());
+		if (later == nullptr) {
+			continue;
+		}
+
+		const Tensor &result = later->getResult().getBlock().getTensor();
+
+		// Tensors written by the operations between the currently considered earlier contraction and the later one
+		std::vector< Tensor > writtenInBetween;
+
+		for (std::size_t i = j; i-- > 0;) {
+			if (!operations[i]) {
+				continue;
+			}
+
+			const auto *earlier = dynamic_cast< const Contract * >(operations[i].get());
+
+			// Moving the earlier contraction to the position of the later one must not change what it reads
+			const bool canMove = earlier != nullptr
+								 && std::none_of(writtenInBetween.begin(), writtenInBetween.end(),
+												 [&](const Tensor &tensor) { return readsTensor(*earlier, tensor); });
+
+			if (canMove) {
+				if (std::optional< Contract > merged = tryMerge(*earlier, *later); merged.has_value()) {
+					operations[j] = std::make_unique< Contract >(std::move(merged.value()));
+					operations[i].reset();
+					later = static_cast< const Contract * >(operations[j].get());
+
+					fused++;
+					continue;
+				}
+			}
+
+			if (readsTensor(*operations[i], result)) {
+				// Contractions that happen before this point can't be moved past it anymore
+				break;
+			}
+
+			if (const TensorElement *written = getWrittenElement(*operations[i]); written != nullptr) {
+				writtenInBetween.push_back(written->getBlock().getTensor());
+			}
+		}
+	}
+
+	operations.erase(std::remove(operations.begin(), operations.end(), nullptr), operations.end());
+
+	return fused;
+}
+
+} // namespace lizard::itf
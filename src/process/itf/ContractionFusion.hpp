@@ -0,0 +1,29 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#pragma once
+
+#include "Operation.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace lizard::itf {
+
+/**
+ * Merges contractions that write to the same result and share one of their operands into a single contraction over
+ * the sum of the respective other operands, i.e. .R += A B1 and .R += c*A B2 become .R += A (B1 + c*B2). Only
+ * contractions whose other operands have the same indices are merged. The merged contraction takes the place of the
+ * later one, so merging is only performed if no operation in between reads the result or overwrites one of the
+ * operands of the earlier contraction.
+ *
+ * Note: This has to be applied before alloc and drop operations are inserted.
+ *
+ * @returns The number of contractions that have been merged into others (and thus removed)
+ */
+auto fuseContractions(std::vector< std::unique_ptr< Operation > > &operations) -> std::size_t;
+
+} // namespace lizard::itf
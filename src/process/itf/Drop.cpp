@@ -6,16 +6,15 @@
 #include "Drop.hpp"
 #include "TensorFormatter.hpp"
 
-#include <fmt/core.h>
-
 
 namespace lizard::itf {
 
 Drop::Drop(TensorElement element) : m_element(std::move(element)) {
 }
 
-auto Drop::stringify(const IndexSpaceManager &manager) const -> std::string {
-	return fmt::format("drop {}", TensorFormatter(m_element, manager));
+void Drop::formatTo(fmt::memory_buffer &buffer, const IndexSpaceManager &manager) const {
+	appendText(buffer, "drop ");
+	appendTensor(buffer, m_element, manager);
 }
 
 } // namespace lizard::itf
@@ -0,0 +1,114 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#include "Liveness.hpp"
+#include "Alloc.hpp"
+#include "Contract.hpp"
+#include "Drop.hpp"
+#include "Translator.hpp"
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+
+namespace lizard::itf {
+
+struct Lifetime {
+	TensorElement element;
+	std::size_t firstWrite;
+	std::size_t lastAccess;
+	bool hasBeenRead = false;
+};
+
+auto isIntermediate(const TensorElement &element) -> bool {
+	const std::string_view name = element.getBlock().getTensor().getName();
+
+	return name.size() > IntermediatePrefix.size() && name.substr(0, IntermediatePrefix.size()) == IntermediatePrefix;
+}
+
+auto getWrittenElement(const Operation &operation) -> const TensorElement * {
+	if (const auto *contraction = dynamic_cast< const Contract * >(&operation); contraction != nullptr) {
+		return &contraction->getResult();
+	}
+
+	return nullptr;
+}
+
+auto getReadElements(const Operation &operation) -> std::vector< TensorElement > {
+	std::vector< TensorElement > elements;
+
+	if (const auto *contraction = dynamic_cast< const Contract * >(&operation); contraction != nullptr) {
+		elements = contraction->getLhs().getElements();
+
+		std::vector< TensorElement > rhsElements = contraction->getRhs().getElements();
+		elements.insert(elements.end(), rhsElements.begin(), rhsElements.end());
+	}
+
+	return elements;
+}
+
+void insertLifetimeOperations(std::vector< std::unique_ptr< Operation > > &operations) {
+	std::vector< Lifetime > lifetimes;
+	std::unordered_map< std::string, std::size_t > lifetimeIndices;
+
+	for (std::size_t i = 0; i < operations.size(); ++i) {
+		for (const TensorElement &currentElement : getReadElements(*operations[i])) {
+			if (!isIntermediate(currentElement)) {
+				continue;
+			}
+
+			auto iter = lifetimeIndices.find(std::string(currentElement.getBlock().getTensor().getName()));
+			if (iter != lifetimeIndices.end()) {
+				lifetimes[iter->second].lastAccess  = i;
+				lifetimes[iter->second].hasBeenRead = true;
+			}
+		}
+
+		const TensorElement *result = getWrittenElement(*operations[i]);
+		if (result != nullptr && isIntermediate(*result)) {
+			auto [iter, inserted] =
+				lifetimeIndices.insert({ std::string(result->getBlock().getTensor().getName()), lifetimes.size() });
+			if (inserted || lifetimes[iter->second].hasBeenRead) {
+				// Writing to an intermediate that has already been read from, starts a new lifetime of the underlying
+				// storage (which happens when multiple intermediates share the same buffer)
+				iter->second = lifetimes.size();
+				lifetimes.push_back(Lifetime{ *result, i, i });
+			} else {
+				lifetimes[iter->second].lastAccess = i;
+			}
+		}
+	}
+
+	if (lifetimes.empty()) {
+		return;
+	}
+
+	std::vector< std::vector< std::size_t > > allocations(operations.size());
+	std::vector< std::vector< std::size_t > > drops(operations.size());
+	for (std::size_t i = 0; i < lifetimes.size(); ++i) {
+		allocations[lifetimes[i].firstWrite].push_back(i);
+		drops[lifetimes[i].lastAccess].push_back(i);
+	}
+
+	std::vector< std::unique_ptr< Operation > > scheduled;
+	scheduled.reserve(operations.size() + 2 * lifetimes.size());
+
+	for (std::size_t i = 0; i < operations.size(); ++i) {
+		for (std::size_t current : allocations[i]) {
+			scheduled.push_back(std::make_unique< Alloc >(lifetimes[current].element));
+		}
+
+		scheduled.push_back(std::move(operations[i]));
+
+		for (std::size_t current : drops[i]) {
+			scheduled.push_back(std::make_unique< Drop >(lifetimes[current].element));
+		}
+	}
+
+	operations = std::move(scheduled);
+}
+
+} // namespace lizard::itf
@@ -0,0 +1,39 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#pragma once
+
+#include "lizard/symbolic/TensorElement.hpp"
+
+#include "Operation.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace lizard::itf {
+
+/**
+ * @returns Whether the given element refers to one of the intermediates that are created during the translation
+ */
+[[nodiscard]] auto isIntermediate(const TensorElement &element) -> bool;
+
+/**
+ * @returns The tensor element that the given operation writes to or nullptr, if it doesn't write to any tensor
+ */
+[[nodiscard]] auto getWrittenElement(const Operation &operation) -> const TensorElement *;
+
+/**
+ * @returns All tensor elements that the given operation reads from
+ */
+[[nodiscard]] auto getReadElements(const Operation &operation) -> std::vector< TensorElement >;
+
+/**
+ * Determines the lifetime of every intermediate tensor (as produced by translate) used in the given instruction
+ * sequence and inserts alloc and drop operations such that each intermediate is allocated right before it is first
+ * written to and dropped right after it has been accessed for the last time.
+ */
+void insertLifetimeOperations(std::vector< std::unique_ptr< Operation > > &operations);
+
+} // namespace lizard::itf
@@ -6,16 +6,15 @@
 #include "Load.hpp"
 #include "TensorFormatter.hpp"
 
-#include <fmt/core.h>
-
 
 namespace lizard::itf {
 
 Load::Load(TensorElement element) : m_element(std::move(element)) {
 }
 
-auto Load::stringify(const IndexSpaceManager &manager) const -> std::string {
-	return fmt::format("load {}", TensorFormatter(m_element, manager));
+void Load::formatTo(fmt::memory_buffer &buffer, const IndexSpaceManager &manager) const {
+	appendText(buffer, "load ");
+	appendTensor(buffer, m_element, manager);
 }
 
 } // namespace lizard::itf
@@ -5,6 +5,8 @@
 
 #pragma once
 
+#include <fmt/format.h>
+
 #include <string>
 
 namespace lizard {
@@ -27,10 +29,20 @@ public:
 	auto operator=(const Operation &) -> Operation & = default;
 	auto operator=(Operation &&) -> Operation & = default;
 
+	/**
+	 * Appends the corresponding ITF code (in textual representation) to the given buffer
+	 */
+	virtual void formatTo(fmt::memory_buffer &buffer, const IndexSpaceManager &manager) const = 0;
+
 	/**
 	 * @returns The corresponding ITF code (in textual representation)
 	 */
-	[[nodiscard]] virtual auto stringify(const IndexSpaceManager &manager) const -> std::string = 0;
+	[[nodiscard]] auto stringify(const IndexSpaceManager &manager) const -> std::string {
+		fmt::memory_buffer buffer;
+		formatTo(buffer, manager);
+
+		return fmt::to_string(buffer);
+	}
 };
 
 } // namespace lizard::itf
@@ -0,0 +1,253 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#include "Scheduler.hpp"
+#include "Liveness.hpp"
+
+#include "lizard/symbolic/IndexSpaceData.hpp"
+#include "lizard/symbolic/IndexSpaceManager.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <numeric>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+
+namespace lizard::itf {
+
+namespace {
+
+/**
+ * Description of the tensors that are accessed by a single operation
+ */
+struct AccessPattern {
+	/**
+	 * The names of all tensors that are written to
+	 */
+	std::vector< std::string > written;
+	/**
+	 * The names of all tensors that are read from
+	 */
+	std::vector< std::string > read;
+	/**
+	 * The names of all intermediates that are accessed in any way (without duplicates)
+	 */
+	std::vector< std::string > intermediates;
+};
+
+/**
+ * Information about the tensors accessed by a sequence of operations
+ */
+struct AccessAnalysis {
+	std::vector< AccessPattern > patterns;
+	/**
+	 * The sizes of all intermediates
+	 */
+	std::unordered_map< std::string, double > sizes;
+};
+
+[[nodiscard]] auto getSize(const TensorElement &element, const IndexSpaceManager &manager) -> double {
+	double size = 1;
+	for (const Index &currentIndex : element.getIndices()) {
+		size *= static_cast< double >(manager.getData(currentIndex.getSpace()).getSize());
+	}
+
+	return size;
+}
+
+[[nodiscard]] auto analyzeAccesses(const std::vector< std::unique_ptr< Operation > > &operations,
+								   const IndexSpaceManager &manager) -> AccessAnalysis {
+	AccessAnalysis analysis;
+	analysis.patterns.reserve(operations.size());
+
+	auto registerIntermediate = [&](AccessPattern &pattern, const TensorElement &element) {
+		if (!isIntermediate(element)) {
+			return;
+		}
+
+		std::string name(element.getBlock().getTensor().getName());
+		if (std::find(pattern.intermediates.begin(), pattern.intermediates.end(), name)
+			== pattern.intermediates.end()) {
+			analysis.sizes[name] = getSize(element, manager);
+			pattern.intermediates.push_back(std::move(name));
+		}
+	};
+
+	for (const std::unique_ptr< Operation > &currentOperation : operations) {
+		AccessPattern pattern;
+
+		if (const TensorElement *written = getWrittenElement(*currentOperation); written != nullptr) {
+			pattern.written.emplace_back(written->getBlock().getTensor().getName());
+			registerIntermediate(pattern, *written);
+		}
+
+		for (const TensorElement &currentElement : getReadElements(*currentOperation)) {
+			pattern.read.emplace_back(currentElement.getBlock().getTensor().getName());
+			registerIntermediate(pattern, currentElement);
+		}
+
+		analysis.patterns.push_back(std::move(pattern));
+	}
+
+	return analysis;
+}
+
+/**
+ * @returns The peak memory occupied by intermediates when executing the operations in the given order
+ */
+[[nodiscard]] auto simulate(const AccessAnalysis &analysis, const std::vector< std::size_t > &order) -> double {
+	std::unordered_map< std::string, std::size_t > lastAccess;
+	for (std::size_t i = 0; i < order.size(); ++i) {
+		for (const std::string &currentName : analysis.patterns[order[i]].intermediates) {
+			lastAccess[currentName] = i;
+		}
+	}
+
+	std::unordered_set< std::string > allocated;
+	double live = 0;
+	double peak = 0;
+
+	for (std::size_t i = 0; i < order.size(); ++i) {
+		const AccessPattern &pattern = analysis.patterns[order[i]];
+
+		for (const std::string &currentName : pattern.intermediates) {
+			if (allocated.insert(currentName).second) {
+				live += analysis.sizes.at(currentName);
+			}
+		}
+
+		peak = std::max(peak, live);
+
+		for (const std::string &currentName : pattern.intermediates) {
+			if (lastAccess[currentName] == i) {
+				live -= analysis.sizes.at(currentName);
+			}
+		}
+	}
+
+	return peak;
+}
+
+[[nodiscard]] auto intersects(const std::vector< std::string > &lhs, const std::vector< std::string > &rhs) -> bool {
+	return std::any_of(lhs.begin(), lhs.end(),
+					   [&](const std::string &name) { return std::find(rhs.begin(), rhs.end(), name) != rhs.end(); });
+}
+
+} // namespace
+
+auto estimatePeakMemory(const std::vector< std::unique_ptr< Operation > > &operations,
+						const IndexSpaceManager &manager) -> double {
+	std::vector< std::size_t > order(operations.size());
+	std::iota(order.begin(), order.end(), 0);
+
+	return simulate(analyzeAccesses(operations, manager), order);
+}
+
+auto scheduleOperations(std::vector< std::unique_ptr< Operation > > &operations, const IndexSpaceManager &manager)
+	-> PeakMemoryEstimate {
+	const AccessAnalysis analysis = analyzeAccesses(operations, manager);
+	const std::size_t nOperations = operations.size();
+
+	std::vector< std::size_t > originalOrder(nOperations);
+	std::iota(originalOrder.begin(), originalOrder.end(), 0);
+
+	PeakMemoryEstimate estimate;
+	estimate.before = simulate(analysis, originalOrder);
+	estimate.after  = estimate.before;
+
+	// Build the dependency graph. Note that all operations accumulate into their result, so multiple writes to the
+	// same tensor may be reordered freely.
+	std::vector< std::vector< std::size_t > > successors(nOperations);
+	std::vector< std::size_t > predecessorCounts(nOperations, 0);
+	for (std::size_t j = 0; j < nOperations; ++j) {
+		for (std::size_t i = 0; i < j; ++i) {
+			const AccessPattern &first  = analysis.patterns[i];
+			const AccessPattern &second = analysis.patterns[j];
+
+			if (intersects(first.written, second.read) || intersects(first.read, second.written)) {
+				successors[i].push_back(j);
+				predecessorCounts[j]++;
+			}
+		}
+	}
+
+	std::unordered_map< std::string, std::size_t > remainingAccesses;
+	for (const AccessPattern &currentPattern : analysis.patterns) {
+		for (const std::string &currentName : currentPattern.intermediates) {
+			remainingAccesses[currentName]++;
+		}
+	}
+
+	std::unordered_set< std::string > allocated;
+	std::vector< std::size_t > ready;
+	for (std::size_t i = 0; i < nOperations; ++i) {
+		if (predecessorCounts[i] == 0) {
+			ready.push_back(i);
+		}
+	}
+
+	// Greedily pick the ready operation that increases the amount of occupied memory the least (or decreases it the
+	// most). Ties are resolved in favor of the original order.
+	std::vector< std::size_t > order;
+	order.reserve(nOperations);
+	while (!ready.empty()) {
+		auto best        = ready.end();
+		double bestDelta = 0;
+
+		for (auto iter = ready.begin(); iter != ready.end(); ++iter) {
+			double delta = 0;
+			for (const std::string &currentName : analysis.patterns[*iter].intermediates) {
+				if (allocated.find(currentName) == allocated.end()) {
+					delta += analysis.sizes.at(currentName);
+				}
+				if (remainingAccesses.at(currentName) == 1) {
+					delta -= analysis.sizes.at(currentName);
+				}
+			}
+
+			if (best == ready.end() || delta < bestDelta || (delta == bestDelta && *iter < *best)) {
+				best      = iter;
+				bestDelta = delta;
+			}
+		}
+
+		const std::size_t current = *best;
+		ready.erase(best);
+		order.push_back(current);
+
+		for (const std::string &currentName : analysis.patterns[current].intermediates) {
+			allocated.insert(currentName);
+			remainingAccesses.at(currentName)--;
+		}
+
+		for (std::size_t currentSuccessor : successors[current]) {
+			if (--predecessorCounts[currentSuccessor] == 0) {
+				ready.push_back(currentSuccessor);
+			}
+		}
+	}
+
+	assert(order.size() == nOperations); // NOLINT
+
+	const double scheduledPeak = simulate(analysis, order);
+	if (scheduledPeak >= estimate.before) {
+		return estimate;
+	}
+
+	std::vector< std::unique_ptr< Operation > > scheduled;
+	scheduled.reserve(nOperations);
+	for (std::size_t current : order) {
+		scheduled.push_back(std::move(operations[current]));
+	}
+
+	operations     = std::move(scheduled);
+	estimate.after = scheduledPeak;
+
+	return estimate;
+}
+
+} // namespace lizard::itf
@@ -0,0 +1,44 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#pragma once
+
+#include "Operation.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace lizard {
+class IndexSpaceManager;
+}
+
+namespace lizard::itf {
+
+/**
+ * Estimated peak memory (in number of tensor elements) occupied by intermediates before and after scheduling
+ */
+struct PeakMemoryEstimate {
+	double before = 0;
+	double after  = 0;
+};
+
+/**
+ * @returns The maximum number of elements of all intermediates that are alive at the same time when executing the
+ * given operations in order, assuming that every intermediate is allocated right before it is first written to and
+ * freed right after it has been accessed for the last time
+ */
+[[nodiscard]] auto estimatePeakMemory(const std::vector< std::unique_ptr< Operation > > &operations,
+									  const IndexSpaceManager &manager) -> double;
+
+/**
+ * Reorders the given operations such that the peak memory occupied by intermediates is reduced, while respecting all
+ * data dependencies between them. Operations are only reordered if this actually reduces the estimated peak memory.
+ *
+ * @returns The estimated peak memory before and after the reordering
+ */
+auto scheduleOperations(std::vector< std::unique_ptr< Operation > > &operations, const IndexSpaceManager &manager)
+	-> PeakMemoryEstimate;
+
+} // namespace lizard::itf
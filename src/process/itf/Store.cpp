@@ -6,16 +6,15 @@
 #include "Store.hpp"
 #include "TensorFormatter.hpp"
 
-#include <fmt/core.h>
-
 
 namespace lizard::itf {
 
 Store::Store(TensorElement element) : m_element(std::move(element)) {
 }
 
-auto Store::stringify(const IndexSpaceManager &manager) const -> std::string {
-	return fmt::format("store {}", TensorFormatter(m_element, manager));
+void Store::formatTo(fmt::memory_buffer &buffer, const IndexSpaceManager &manager) const {
+	appendText(buffer, "store ");
+	appendTensor(buffer, m_element, manager);
 }
 
 } // namespace lizard::itf
@@ -6,38 +6,22 @@
 #include "TensorExpression.hpp"
 #include "TensorFormatter.hpp"
 
-#include "lizard/format/FormatSupport.hpp"
-#include "lizard/format/details/SymbolicFormatter.hpp"
-
-#include <fmt/core.h>
-
 #include <algorithm>
 #include <cassert>
+#include <iterator>
+#include <tuple>
 #include <variant>
 
-namespace lizard {
-class ScaledTensorFormatter : public details::SymbolicFormatter< itf::TensorExpression::ScaledTensorElement > {
-public:
-	using details::SymbolicFormatter< itf::TensorExpression::ScaledTensorElement >::SymbolicFormatter;
-};
-} // namespace lizard
-
-template<> struct fmt::formatter< lizard::ScaledTensorFormatter > : fmt::formatter< std::string_view > {
-	template< typename FormatContext > auto format(const lizard::ScaledTensorFormatter &formatter, FormatContext &ctx) {
-		if (formatter.get().factor == 1) {
-			return fmt::formatter< std::string_view >::format(
-				fmt::format("{}", lizard::itf::TensorFormatter(formatter.get().tensor, formatter.getManager())), ctx);
-		}
+namespace lizard::itf {
 
-		return fmt::formatter< std::string_view >::format(
-			fmt::format("{}*{}", formatter.get().factor,
-						lizard::itf::TensorFormatter(formatter.get().tensor, formatter.getManager())),
-			ctx);
+void appendScaledTensor(fmt::memory_buffer &buffer, const TensorExpression::ScaledTensorElement &element,
+						const IndexSpaceManager &manager) {
+	if (element.factor != 1) {
+		appendFactor(buffer, element.factor);
+		buffer.push_back('*');
 	}
-};
-
-
-namespace lizard::itf {
+	appendTensor(buffer, element.tensor, manager);
+}
 
 TensorExpression::TensorExpression(TensorElement element, Fraction factor)
 	: Multiplyable(std::move(factor)), m_expression(std::move(element)) {
@@ -57,50 +41,105 @@ auto TensorExpression::getResult() const -> const TensorElement & {
 	}
 
 	const Addition &addition = std::get< Addition >(m_expression);
-	const TensorElement &lhs = addition.lhs.tensor;
-	const TensorElement &rhs = addition.rhs.tensor;
+	assert(!addition.terms.empty()); // NOLINT
+
+	const TensorElement &first = addition.terms.front().tensor;
 
 	// We are assuming that the added tensors generally have the same indices (potentially in a different order)
 	// and that their index symmetries are equivalent as well
+	for (const ScaledTensorElement &current : addition.terms) {
+		// NOLINTNEXTLINE
+		assert(first.getIndices().size() == current.tensor.getIndices().size()
+			   && std::is_permutation(first.getIndices().begin(), first.getIndices().end(),
+									  current.tensor.getIndices().begin()));
+		assert(first.getBlock().getSlotSymmetry() == current.tensor.getBlock().getSlotSymmetry()); // NOLINT
+		(void) current;
+	}
 
-	// NOLINTNEXTLINE
-	assert(lhs.getIndices().size() == rhs.getIndices().size()
-		   && std::is_permutation(lhs.getIndices().begin(), lhs.getIndices().end(), rhs.getIndices().begin()));
-	assert(lhs.getBlock().getSlotSymmetry() == rhs.getBlock().getSlotSymmetry()); // NOLINT
-	(void) rhs;
-
-	// Under these assumptions, the result tensor element can be chosen to look the same as either
+	// Under these assumptions, the result tensor element can be chosen to look the same as any
 	// of the individual elements
-	return lhs;
+	return first;
 }
 
-auto TensorExpression::stringify(const IndexSpaceManager &manager) const -> std::string {
+auto TensorExpression::getElements() const -> std::vector< TensorElement > {
 	if (std::holds_alternative< TensorElement >(m_expression)) {
-		if (getFactor() == 1) {
-			return fmt::format("{}", TensorFormatter(std::get< TensorElement >(m_expression), manager));
+		return { std::get< TensorElement >(m_expression) };
+	}
+
+	std::vector< TensorElement > elements;
+	for (const ScaledTensorElement &current : std::get< Addition >(m_expression).terms) {
+		elements.push_back(current.tensor);
+	}
+
+	return elements;
+}
+
+void replaceTensorIn(TensorElement &element, const Tensor &original, const Tensor &replacement) {
+	if (element.getBlock().getTensor() != original) {
+		return;
+	}
+
+	TensorBlock block = element.getBlock();
+	block.setTensor(replacement);
+	std::vector< Index > indices(element.getIndices().begin(), element.getIndices().end());
+
+	// The block's symmetry stays the same, so the indices are already in canonical order
+	element = std::get< 0 >(TensorElement::create(std::move(block), std::move(indices)));
+}
+
+void TensorExpression::replaceTensor(const Tensor &original, const Tensor &replacement) {
+	if (auto *element = std::get_if< TensorElement >(&m_expression); element != nullptr) {
+		replaceTensorIn(*element, original, replacement);
+	} else {
+		for (ScaledTensorElement &current : std::get< Addition >(m_expression).terms) {
+			replaceTensorIn(current.tensor, original, replacement);
 		}
+	}
+}
+
+void TensorExpression::formatTo(fmt::memory_buffer &buffer, const IndexSpaceManager &manager) const {
+	if (getFactor() != 1) {
+		appendFactor(buffer, getFactor());
+		buffer.push_back('*');
+	}
 
-		return fmt::format("{}*{}", getFactor(), TensorFormatter(std::get< TensorElement >(m_expression), manager));
+	if (std::holds_alternative< TensorElement >(m_expression)) {
+		appendTensor(buffer, std::get< TensorElement >(m_expression), manager);
+		return;
 	}
 
 	const Addition &addition = std::get< Addition >(m_expression);
 
-	if (getFactor() == 1) {
-		return fmt::format("({} + {})", ScaledTensorFormatter(addition.lhs, manager),
-						   ScaledTensorFormatter(addition.rhs, manager));
+	buffer.push_back('(');
+	for (std::size_t i = 0; i < addition.terms.size(); ++i) {
+		if (i > 0) {
+			appendText(buffer, " + ");
+		}
+		appendScaledTensor(buffer, addition.terms[i], manager);
 	}
-
-	return fmt::format("{}*({} + {})", getFactor(), ScaledTensorFormatter(addition.lhs, manager),
-					   ScaledTensorFormatter(addition.rhs, manager));
+	buffer.push_back(')');
 }
 
 
+auto TensorExpression::getTerms() const -> std::vector< ScaledTensorElement > {
+	if (std::holds_alternative< TensorElement >(m_expression)) {
+		return { ScaledTensorElement{ std::get< TensorElement >(m_expression), getFactor() } };
+	}
+
+	std::vector< ScaledTensorElement > terms = std::get< Addition >(m_expression).terms;
+	for (ScaledTensorElement &current : terms) {
+		current.factor *= getFactor();
+	}
+
+	return terms;
+}
+
 auto TensorExpression::operator+=(const TensorExpression &rhs) -> TensorExpression & {
-	assert(std::holds_alternative< TensorElement >(m_expression));     // NOLINT
-	assert(std::holds_alternative< TensorElement >(rhs.m_expression)); // NOLINT
+	std::vector< ScaledTensorElement > terms      = getTerms();
+	std::vector< ScaledTensorElement > additional = rhs.getTerms();
+	terms.insert(terms.end(), std::make_move_iterator(additional.begin()), std::make_move_iterator(additional.end()));
 
-	m_expression = Addition{ ScaledTensorElement{ std::move(std::get< TensorElement >(m_expression)), getFactor() },
-							 ScaledTensorElement{ std::get< TensorElement >(rhs.m_expression), rhs.getFactor() } };
+	m_expression = Addition{ std::move(terms) };
 
 	setFactor(1);
 
@@ -112,7 +151,7 @@ auto TensorExpression::operator+(const TensorExpression &rhs) -> TensorExpressio
 
 	copy += rhs;
 
-	return rhs;
+	return copy;
 }
 
 } // namespace lizard::itf
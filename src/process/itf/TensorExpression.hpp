@@ -12,6 +12,7 @@
 #include "Multiplyable.hpp"
 
 #include <variant>
+#include <vector>
 
 namespace lizard::itf {
 
@@ -21,6 +22,14 @@ namespace lizard::itf {
  */
 class TensorExpression : public Multiplyable {
 public:
+	struct ScaledTensorElement {
+		TensorElement tensor;
+		Fraction factor;
+	};
+	struct Addition {
+		std::vector< ScaledTensorElement > terms;
+	};
+
 	/**
 	 * Creates an expression in which the given element is contained and which is optionally
 	 * multiplied by the given scalar factor
@@ -28,7 +37,7 @@ public:
 	TensorExpression(TensorElement element, Fraction factor = 1);
 
 	/**
-	 * @returns The cardinality of this expression. Can only be nullary or binary
+	 * @returns The cardinality of this expression. Can only be nullary (single tensor) or binary (sum of tensors)
 	 */
 	[[nodiscard]] auto getCardinality() const -> ExpressionCardinality;
 
@@ -37,23 +46,37 @@ public:
 	 */
 	[[nodiscard]] auto getResult() const -> const TensorElement &;
 
-	[[nodiscard]] auto stringify(const IndexSpaceManager &manager) const -> std::string override;
+	/**
+	 * @returns All tensor elements that are referenced by this expression
+	 */
+	[[nodiscard]] auto getElements() const -> std::vector< TensorElement >;
 
-	auto operator+=(const TensorExpression &rhs) -> TensorExpression &;
-	[[nodiscard]] auto operator+(const TensorExpression &rhs) -> TensorExpression;
+	/**
+	 * Replaces all references to the given tensor by references to the replacement tensor
+	 */
+	void replaceTensor(const Tensor &original, const Tensor &replacement);
 
+	void formatTo(fmt::memory_buffer &buffer, const IndexSpaceManager &manager) const override;
 
-	struct ScaledTensorElement {
-		TensorElement tensor;
-		Fraction factor;
-	};
-	struct Addition {
-		ScaledTensorElement lhs;
-		ScaledTensorElement rhs;
-	};
+	/**
+	 * @returns The individual (scaled) tensor elements that are summed up in this expression. The expression's overall
+	 * factor is already absorbed into the returned factors.
+	 */
+	[[nodiscard]] auto getTerms() const -> std::vector< ScaledTensorElement >;
+
+	/**
+	 * Turns this expression into the sum of itself and the given expression
+	 */
+	auto operator+=(const TensorExpression &rhs) -> TensorExpression &;
+	[[nodiscard]] auto operator+(const TensorExpression &rhs) -> TensorExpression;
 
 private:
 	std::variant< TensorElement, Addition > m_expression;
 };
 
+/**
+ * Makes the given element refer to the replacement tensor, if it currently refers to the original tensor
+ */
+void replaceTensorIn(TensorElement &element, const Tensor &original, const Tensor &replacement);
+
 } // namespace lizard::itf
@@ -0,0 +1,82 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#include "TensorFormatter.hpp"
+
+#include "lizard/format/IndexFormatter.hpp"
+#include "lizard/symbolic/Index.hpp"
+#include "lizard/symbolic/IndexSpace.hpp"
+#include "lizard/symbolic/IndexSpaceData.hpp"
+#include "lizard/symbolic/IndexSpaceManager.hpp"
+#include "lizard/symbolic/Spin.hpp"
+#include "lizard/symbolic/Tensor.hpp"
+#include "lizard/symbolic/TensorBlock.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+
+namespace lizard::itf {
+
+void appendText(fmt::memory_buffer &buffer, std::string_view text) {
+	buffer.append(text.data(), text.data() + text.size());
+}
+
+void appendTensor(fmt::memory_buffer &buffer, const TensorElement &element, const IndexSpaceManager &manager) {
+	const TensorBlock::IndexSlots &slots      = element.getBlock().getIndexSlots();
+	const nonstd::span< const Index > indices = element.getIndices();
+
+	appendText(buffer, element.getBlock().getTensor().getName());
+
+	// Note: We only print spin information about tensor elements, if any of the spins is actually interesting
+	const bool includeSpin = std::any_of(slots.begin(), slots.end(), [](const IndexSpace &space) {
+		return space.getSpin() == Spin::Alpha || space.getSpin() == Spin::Beta;
+	});
+
+	if (includeSpin) {
+		// Since ITF doesn't allow underscores in tensor names, we have to resort to concatenating the
+		// tensor's name and its spin case by a different character
+		buffer.push_back('0');
+		for (const IndexSpace &current : slots) {
+			switch (current.getSpin()) {
+				case Spin::Alpha:
+					buffer.push_back('a');
+					break;
+				case Spin::Beta:
+					buffer.push_back('b');
+					break;
+				case Spin::None:
+					buffer.push_back('n');
+					break;
+				case Spin::Both:
+					throw std::runtime_error("Encountered indices in spin-orbit formalism during ITF export");
+					break;
+			}
+		}
+	}
+
+	if (!indices.empty()) {
+		buffer.push_back(':');
+		for (const Index &currentIndex : indices) {
+			buffer.push_back(manager.getData(currentIndex.getSpace()).getShortName());
+		}
+	}
+
+	buffer.push_back('[');
+	for (const Index &currentIndex : indices) {
+		fmt::format_to(std::back_inserter(buffer), "{}", IndexFormatter(currentIndex, manager));
+	}
+	buffer.push_back(']');
+}
+
+void appendFactor(fmt::memory_buffer &buffer, const Fraction &factor) {
+	fmt::format_to(std::back_inserter(buffer), "{}", factor.getNumerator());
+
+	if (factor.getDenominator() > 0 && factor.getDenominator() != 1) {
+		fmt::format_to(std::back_inserter(buffer), "/{}", factor.getDenominator());
+	}
+}
+
+} // namespace lizard::itf
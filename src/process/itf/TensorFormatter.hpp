@@ -5,15 +5,17 @@
 
 #pragma once
 
-#include "lizard/format/FormatSupport.hpp"
+#include "lizard/core/Fraction.hpp"
 #include "lizard/format/details/SymbolicFormatter.hpp"
-#include "lizard/symbolic/IndexSpace.hpp"
-#include "lizard/symbolic/Spin.hpp"
-#include "lizard/symbolic/Tensor.hpp"
-#include "lizard/symbolic/TensorBlock.hpp"
 #include "lizard/symbolic/TensorElement.hpp"
 
-#include <algorithm>
+#include <fmt/format.h>
+
+#include <string_view>
+
+namespace lizard {
+class IndexSpaceManager;
+}
 
 namespace lizard::itf {
 
@@ -21,61 +23,29 @@ struct TensorFormatter : details::SymbolicFormatter< TensorElement > {
 	using details::SymbolicFormatter< TensorElement >::SymbolicFormatter;
 };
 
-} // namespace lizard::itf
-
-
-template<> struct fmt::formatter< lizard::itf::TensorFormatter > : fmt::formatter< std::string_view > {
-	template< typename FormatContext > auto format(const lizard::itf::TensorFormatter &formatter, FormatContext &ctx) {
-		const lizard::TensorElement &element              = formatter.get();
-		const lizard::TensorBlock::IndexSlots &slots      = element.getBlock().getIndexSlots();
-		const nonstd::span< const lizard::Index > indices = element.getIndices();
-		const lizard::IndexSpaceManager &manager          = formatter.getManager();
-		std::string indexSpec;
-		std::string spaceSpec;
-		std::string spinSpec;
+/**
+ * Appends the given text to the given buffer
+ */
+void appendText(fmt::memory_buffer &buffer, std::string_view text);
 
-		// Note: We only print spin information about tensor elements, if any of the spins is actually interesting
-		const bool includeSpin =
-			std::find_if(slots.begin(), slots.end(),
-						 [](const lizard::IndexSpace &space) {
-							 return space.getSpin() == lizard::Spin::Alpha || space.getSpin() == lizard::Spin::Beta;
-						 })
-			!= slots.end();
+/**
+ * Appends the ITF representation of the given tensor element to the given buffer
+ */
+void appendTensor(fmt::memory_buffer &buffer, const TensorElement &element, const IndexSpaceManager &manager);
 
-		if (includeSpin) {
-			// Since ITF doesn't allow underscores in tensor names, we have to resort to concatenating the
-			// tensor's name and its spin case by a different character
-			spinSpec = "0";
-			for (const lizard::IndexSpace &current : slots) {
-				switch (current.getSpin()) {
-					case lizard::Spin::Alpha:
-						spinSpec += "a";
-						break;
-					case lizard::Spin::Beta:
-						spinSpec += "b";
-						break;
-					case lizard::Spin::None:
-						spinSpec += "n";
-						break;
-					case lizard::Spin::Both:
-						throw std::runtime_error("Encountered indices in spin-orbit formalism during ITF export");
-						break;
-				}
-			}
-		}
+/**
+ * Appends the ITF representation of the given factor to the given buffer
+ */
+void appendFactor(fmt::memory_buffer &buffer, const Fraction &factor);
 
-		for (const lizard::Index &currentIndex : indices) {
-			indexSpec += fmt::format("{}", lizard::IndexFormatter(currentIndex, manager));
+} // namespace lizard::itf
 
-			const lizard::IndexSpaceData &data = manager.getData(currentIndex.getSpace());
-			spaceSpec += data.getShortName();
-		}
 
-		if (!spaceSpec.empty()) {
-			spaceSpec = ":" + spaceSpec;
-		}
+template<> struct fmt::formatter< lizard::itf::TensorFormatter > : fmt::formatter< std::string_view > {
+	template< typename FormatContext > auto format(const lizard::itf::TensorFormatter &formatter, FormatContext &ctx) {
+		fmt::memory_buffer buffer;
+		lizard::itf::appendTensor(buffer, formatter.get(), formatter.getManager());
 
-		return fmt::formatter< std::string_view >::format(
-			fmt::format("{}{}{}[{}]", element.getBlock().getTensor(), spinSpec, spaceSpec, indexSpec), ctx);
+		return fmt::formatter< std::string_view >::format(std::string_view(buffer.data(), buffer.size()), ctx);
 	}
 };
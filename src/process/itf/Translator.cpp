@@ -7,6 +7,7 @@
 #include "Contract.hpp"
 #include "TensorExpression.hpp"
 
+#include "lizard/process/MappedTensorExprTree.hpp"
 #include "lizard/process/ProcessingException.hpp"
 #include "lizard/symbolic/Contraction.hpp"
 #include "lizard/symbolic/ExpressionOperator.hpp"
@@ -16,74 +17,107 @@
 
 #include <fmt/core.h>
 
+#include <algorithm>
+#include <cassert>
 #include <functional>
 #include <memory>
+#include <optional>
 #include <stack>
 #include <variant>
 
 
 namespace lizard::itf {
 
-void translateContraction(const ConstTensorExpr &root, const TensorElement &result,
-						  std::vector< std::unique_ptr< Operation > > &operations);
+TranslationContext::TranslationContext(std::size_t firstIntermediate)
+	: m_firstIntermediate(firstIntermediate), m_nextIntermediate(firstIntermediate), m_one(Tensor("One")) {
+}
+
+auto TranslationContext::createIntermediateName() -> std::string {
+	return fmt::format("{}{:06d}", IntermediatePrefix, m_nextIntermediate++);
+}
+
+auto TranslationContext::getIntermediateCount() const -> std::size_t {
+	return m_nextIntermediate - m_firstIntermediate;
+}
+
+auto TranslationContext::getOne() const -> const TensorElement & {
+	return m_one;
+}
+
+using ContractRef = std::reference_wrapper< Contract >;
+using Argument    = std::variant< Fraction, TensorExpression, ContractRef >;
+
+template< typename Expression >
+[[nodiscard]] auto translateTerm(const Expression &root, const TensorElement &result,
+								 std::vector< std::unique_ptr< Operation > > &operations, TranslationContext &context)
+	-> Argument;
+
+template< typename Tree > auto translate(const Tree &tree) -> std::vector< std::unique_ptr< Operation > > {
+	TranslationContext context;
+
+	return translate(tree, context);
+}
+
+template< typename Tree >
+auto translate(const Tree &tree, TranslationContext &context) -> std::vector< std::unique_ptr< Operation > > {
+	using Expression = decltype(tree.getRoot());
 
-auto translate(const NamedTensorExprTree &tree) -> std::vector< std::unique_ptr< Operation > > {
 	std::vector< std::unique_ptr< Operation > > operations;
 
-	std::stack< ConstTensorExpr > toVisit;
+	if (tree.isEmpty()) {
+		return operations;
+	}
+
+	// All terms that don't involve a contraction are summed up and added to the result in a single operation
+	std::optional< TensorExpression > linearTerms;
+
+	std::stack< Expression > toVisit;
 
 	toVisit.push(tree.getRoot());
 
 	while (!toVisit.empty()) {
-		ConstTensorExpr currentExpr = std::move(toVisit.top());
+		Expression currentExpr = std::move(toVisit.top());
 		toVisit.pop();
 
-		switch (currentExpr.getType()) {
-			case ExpressionType::Literal:
-				throw ProcessingException("Exporting additions with scalar constants to ITF is not supported");
-				break;
-			case ExpressionType::Variable: {
-				static TensorElement One(Tensor("One"));
-				operations.push_back(std::make_unique< Contract >(tree.getResult(), currentExpr.getVariable(), One));
-				break;
-			}
-			case ExpressionType::Operator:
-				switch (currentExpr.getOperator()) {
-					case ExpressionOperator::Plus:
-						toVisit.push(currentExpr.getRightArg());
-						toVisit.push(currentExpr.getLeftArg());
-						break;
-					case ExpressionOperator::Times:
-						translateContraction(currentExpr, tree.getResult(), operations);
-						break;
-				}
+		if (currentExpr.getType() == ExpressionType::Operator
+			&& currentExpr.getOperator() == ExpressionOperator::Plus) {
+			toVisit.push(currentExpr.getRightArg());
+			toVisit.push(currentExpr.getLeftArg());
+			continue;
+		}
 
-				break;
+		Argument term = translateTerm(currentExpr, tree.getResult(), operations, context);
+
+		if (std::holds_alternative< ContractRef >(term)) {
+			// The contraction is already writing into the result tensor
+			continue;
 		}
-	}
 
-	return operations;
-}
+		if (const Fraction *constant = std::get_if< Fraction >(&term); constant != nullptr) {
+			if (!tree.getResult().getIndices().empty()) {
+				throw ProcessingException("Can't export addition of a scalar constant to a non-scalar tensor to ITF");
+			}
 
-using ContractRef = std::reference_wrapper< Contract >;
-using Argument    = std::variant< Fraction, TensorExpression, ContractRef >;
+			// Scalar constants are represented as multiples of the scalar tensor One
+			term = TensorExpression(context.getOne(), *constant);
+		}
 
-[[nodiscard]] auto handleAddition(Argument lhs, Argument rhs) -> Argument {
-	if (std::holds_alternative< Fraction >(rhs)) {
-		throw ProcessingException("Can't export addition involving a scalar to ITF");
+		if (linearTerms.has_value()) {
+			linearTerms.value() += std::get< TensorExpression >(term);
+		} else {
+			linearTerms = std::get< TensorExpression >(std::move(term));
+		}
 	}
 
-	assert(std::get< TensorExpression >(lhs).getCardinality() == ExpressionCardinality::Nullary); // NOLINT
-	assert(std::get< TensorExpression >(rhs).getCardinality() == ExpressionCardinality::Nullary); // NOLINT
-	assert(!std::holds_alternative< ContractRef >(lhs));                                          // NOLINT
-	assert(!std::holds_alternative< ContractRef >(rhs));                                          // NOLINT
-
-	std::get< TensorExpression >(lhs) += std::get< TensorExpression >(rhs);
+	if (linearTerms.has_value()) {
+		operations.push_back(
+			std::make_unique< Contract >(tree.getResult(), std::move(linearTerms.value()), context.getOne()));
+	}
 
-	return lhs;
+	return operations;
 }
 
-[[nodiscard]] auto getContractionArg(const Argument &arg) -> TensorExpression {
+[[nodiscard]] auto toTensorExpression(const Argument &arg, TranslationContext &context) -> TensorExpression {
 	assert(!std::holds_alternative< Fraction >(arg)); // NOLINT
 
 	if (const TensorExpression *expr = std::get_if< TensorExpression >(&arg); expr != nullptr) {
@@ -92,18 +126,43 @@ using Argument    = std::variant< Fraction, TensorExpression, ContractRef >;
 
 	assert(std::holds_alternative< ContractRef >(arg)); // NOLINT
 
+	// The result of the contraction has to be stored in an intermediate that can then be used in other operations
 	Contract &contraction = std::get< ContractRef >(arg).get();
 
-	static std::size_t intermediateCounter = 1;
-
 	contraction.setResult(contract(contraction.getLhs().getResult(), contraction.getRhs().getResult(),
-								   fmt::format("STIN_{:06d}", intermediateCounter++)));
+								   context.createIntermediateName()));
 
 	return { contraction.getResult() };
 }
 
+[[nodiscard]] auto handleAddition(Argument lhs, Argument rhs, TranslationContext &context) -> Argument {
+	if (std::holds_alternative< Fraction >(rhs)) {
+		if (std::holds_alternative< Fraction >(lhs)) {
+			std::get< Fraction >(lhs) += std::get< Fraction >(rhs);
+
+			return lhs;
+		}
+
+		// Scalar constants are represented as multiples of the scalar tensor One
+		rhs = TensorExpression(context.getOne(), std::get< Fraction >(rhs));
+	}
+
+	TensorExpression sum = toTensorExpression(lhs, context);
+	sum += toTensorExpression(rhs, context);
+
+	const std::vector< TensorElement > elements = sum.getElements();
+	const auto isScalar = [](const TensorElement &element) { return element.getIndices().empty(); };
+	if (std::any_of(elements.begin(), elements.end(), isScalar)
+		&& !std::all_of(elements.begin(), elements.end(), isScalar)) {
+		throw ProcessingException("Can't export addition of a scalar to a non-scalar tensor to ITF");
+	}
+
+	return sum;
+}
+
 [[nodiscard]] auto handleMultiplication(Argument lhs, Argument rhs, const TensorElement &result,
-										std::vector< std::unique_ptr< Operation > > &operations) -> Argument {
+										std::vector< std::unique_ptr< Operation > > &operations,
+										TranslationContext &context) -> Argument {
 	if (std::holds_alternative< Fraction >(rhs)) {
 		// Multiplication with a scalar
 		if (std::holds_alternative< Fraction >(lhs)) {
@@ -122,7 +181,7 @@ using Argument    = std::variant< Fraction, TensorExpression, ContractRef >;
 	// Contraction
 
 	std::unique_ptr< Contract > contraction =
-		std::make_unique< Contract >(result, getContractionArg(lhs), getContractionArg(rhs));
+		std::make_unique< Contract >(result, toTensorExpression(lhs, context), toTensorExpression(rhs, context));
 
 	Argument arg = *contraction;
 	operations.push_back(std::move(contraction));
@@ -130,15 +189,16 @@ using Argument    = std::variant< Fraction, TensorExpression, ContractRef >;
 	return arg;
 }
 
-void translateContraction(const ConstTensorExpr &root, const TensorElement &result,
-						  std::vector< std::unique_ptr< Operation > > &operations) {
-	auto iter = root.cbegin< TreeTraversal::DepthFirst_PostOrder >();
-	auto end  = root.cend< TreeTraversal::DepthFirst_PostOrder >();
+template< typename Expression >
+auto translateTerm(const Expression &root, const TensorElement &result,
+				   std::vector< std::unique_ptr< Operation > > &operations, TranslationContext &context) -> Argument {
+	auto iter = root.template cbegin< TreeTraversal::DepthFirst_PostOrder >();
+	auto end  = root.template cend< TreeTraversal::DepthFirst_PostOrder >();
 
 	std::stack< Argument > arguments;
 
 	for (; iter != end; ++iter) {
-		ConstTensorExpr current = *iter;
+		Expression current = *iter;
 
 		switch (current.getType()) {
 			case ExpressionType::Literal:
@@ -166,22 +226,27 @@ void translateContraction(const ConstTensorExpr &root, const TensorElement &resu
 
 		switch (current.getOperator()) {
 			case ExpressionOperator::Plus:
-				arguments.push(handleAddition(std::move(lhs), std::move(rhs)));
+				arguments.push(handleAddition(std::move(lhs), std::move(rhs), context));
 				break;
 			case ExpressionOperator::Times:
-				arguments.push(handleMultiplication(std::move(lhs), std::move(rhs), result, operations));
+				arguments.push(handleMultiplication(std::move(lhs), std::move(rhs), result, operations, context));
 				break;
 		}
 	}
 
-	while (!arguments.empty() && std::holds_alternative< ContractRef >(arguments.top())) {
-		arguments.pop();
-	}
-
-	if (!arguments.empty()) {
+	if (arguments.size() != 1) {
 		throw ProcessingException(
 			"Encountered left-over (unprocessed) arguments during translation of contraction to ITF");
 	}
+
+	return std::move(arguments.top());
 }
 
+template auto translate(const NamedTensorExprTree &tree) -> std::vector< std::unique_ptr< Operation > >;
+template auto translate(const NamedTensorExprTree &tree, TranslationContext &context)
+	-> std::vector< std::unique_ptr< Operation > >;
+template auto translate(const MappedTensorExprTree &tree) -> std::vector< std::unique_ptr< Operation > >;
+template auto translate(const MappedTensorExprTree &tree, TranslationContext &context)
+	-> std::vector< std::unique_ptr< Operation > >;
+
 } // namespace lizard::itf
@@ -3,20 +3,75 @@
 // can be found in the LICENSE file at the root of the lizard source
 // tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
 
+#pragma once
+
+#include "lizard/symbolic/TensorElement.hpp"
 #include "lizard/symbolic/TensorExpressions.hpp"
 
 #include "Operation.hpp"
 
+#include <cstddef>
 #include <memory>
+#include <string>
+#include <string_view>
 #include <vector>
 
 namespace lizard::itf {
 
+/**
+ * Prefix of the names of the intermediate tensors that are created during the translation to ITF
+ */
+constexpr const std::string_view IntermediatePrefix = "STIN_";
+
+/**
+ * State that is shared between the translations of multiple expression trees into ITF. Intermediates created within
+ * the same context are numbered consecutively, so the produced names only depend on the sequence of translations
+ * performed with a given context. Different contexts are independent of each other, which allows for translating
+ * expressions concurrently (using one context per thread).
+ */
+class TranslationContext {
+public:
+	/**
+	 * @param firstIntermediate The number of the first intermediate created within this context
+	 */
+	explicit TranslationContext(std::size_t firstIntermediate = 1);
+
+	/**
+	 * @returns A new, unique name for an intermediate tensor
+	 */
+	[[nodiscard]] auto createIntermediateName() -> std::string;
+
+	/**
+	 * @returns The number of intermediates created within this context so far
+	 */
+	[[nodiscard]] auto getIntermediateCount() const -> std::size_t;
+
+	/**
+	 * @returns The scalar tensor element with value 1, which is used to express plain (scaled) copies of tensors
+	 */
+	[[nodiscard]] auto getOne() const -> const TensorElement &;
+
+private:
+	std::size_t m_firstIntermediate;
+	std::size_t m_nextIntermediate;
+	TensorElement m_one;
+};
+
 /**
  * Takes the given expression tree and translates it into a sequence of ITF instructions.
  * The produced instruction sequence will only map the operations already contained in the
  * tree - in particular load, store, etc. operations are not generated by this method.
+ *
+ * This is implemented for NamedTensorExprTree and MappedTensorExprTree.
+ */
+template< typename Tree >
+[[nodiscard]] auto translate(const Tree &tree, TranslationContext &context)
+	-> std::vector< std::unique_ptr< Operation > >;
+
+/**
+ * Translates the given expression tree using a fresh TranslationContext
  */
-[[nodiscard]] auto translate(const NamedTensorExprTree &tree) -> std::vector< std::unique_ptr< Operation > >;
+template< typename Tree >
+[[nodiscard]] auto translate(const Tree &tree) -> std::vector< std::unique_ptr< Operation > >;
 
 } // namespace lizard::itf
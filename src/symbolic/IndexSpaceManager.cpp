@@ -81,4 +81,15 @@ auto IndexSpaceManager::createFromLabel(char label) const -> IndexSpace {
 	throw InvalidIndexSpaceException("No index space known for label '" + toString(label) + "'");
 }
 
+auto IndexSpaceManager::getRegisteredSpaces() const -> std::vector< IndexSpace > {
+	std::vector< IndexSpace > spaces;
+	spaces.reserve(m_spaces.size());
+
+	for (const Pair &current : m_spaces) {
+		spaces.push_back(current.space);
+	}
+
+	return spaces;
+}
+
 } // namespace lizard
@@ -10,12 +10,21 @@
 
 #include <cassert>
 #include <iostream>
+#include <memory>
+#include <utility>
 
 namespace lizard {
 
-TensorBlock::TensorBlock(Tensor tensor, IndexSlots indexSlots, SlotSymmetry symmetry)
-	: m_tensor(std::move(tensor)), m_symmetry(std::move(symmetry)), m_slots(std::move(indexSlots)) {
-	assert(perm::computeCanonicalizationPermutation(m_slots, m_symmetry)->isIdentity()); // NOLINT
+TensorBlock::TensorBlock(Tensor tensor, IndexSlots indexSlots, SlotSymmetry symmetry) : m_tensor(std::move(tensor)) {
+	if (indexSlots.empty()) {
+		// All scalars share the same (empty) data
+		static const std::shared_ptr< const Data > scalarData = std::make_shared< const Data >();
+		m_data                                                = scalarData;
+	} else {
+		m_data = std::make_shared< const Data >(Data{ std::move(symmetry), std::move(indexSlots) });
+	}
+
+	assert(perm::computeCanonicalizationPermutation(m_data->slots, m_data->symmetry)->isIdentity()); // NOLINT
 }
 
 TensorBlock::TensorBlock(Tensor tensor) : TensorBlock(std::move(tensor), {}, {}) {
@@ -29,7 +38,7 @@ auto TensorBlock::create(Tensor tensor, IndexSlots indexSlots, SlotSymmetry symm
 }
 
 auto TensorBlock::dimension() const -> std::size_t {
-	return m_slots.size();
+	return m_data->slots.size();
 }
 
 auto TensorBlock::getTensor() const -> const Tensor & {
@@ -45,11 +54,11 @@ void TensorBlock::setTensor(Tensor tensor) {
 }
 
 auto TensorBlock::getSlotSymmetry() const -> const SlotSymmetry & {
-	return m_symmetry;
+	return m_data->symmetry;
 }
 
 auto TensorBlock::getIndexSlots() const -> const IndexSlots & {
-	return m_slots;
+	return m_data->slots;
 }
 
 auto operator==(const TensorBlock &lhs, const TensorBlock &rhs) -> bool {
@@ -17,7 +17,7 @@ namespace lizard {
 
 TensorElement::TensorElement(TensorBlock block, std::vector< Index > indices)
 	: m_block(std::move(block)), m_indices(std::move(indices)) {
-	assert(perm::computeCanonicalizationPermutation(indices, m_block.getSlotSymmetry())->isIdentity()); // NOLINT
+	assert(perm::computeCanonicalizationPermutation(m_indices, m_block.getSlotSymmetry())->isIdentity()); // NOLINT
 }
 
 TensorElement::TensorElement(Tensor tensor) : TensorElement(TensorBlock{ std::move(tensor), {}, {} }, {}) {
@@ -61,6 +61,17 @@ auto TensorElement::create(Tensor tensor, std::vector< Index > indices, TensorBl
 	return { TensorElement(std::move(block), std::move(indices)), sign };
 }
 
+auto TensorElement::fromCanonical(TensorBlock block, std::vector< Index > indices) -> TensorElement {
+	assert(block.dimension() == indices.size()); // NOLINT
+#ifndef NDEBUG
+	for (std::size_t i = 0; i < indices.size(); ++i) {
+		assert(block.getIndexSlots()[i] == indices[i].getSpace()); // NOLINT
+	}
+#endif
+
+	return { std::move(block), std::move(indices) };
+}
+
 auto TensorElement::getBlock() const -> const TensorBlock & {
 	return m_block;
 }
@@ -99,7 +110,7 @@ auto operator<<(std::ostream &stream, const TensorElement &element) -> std::ostr
 
 } // namespace lizard
 
-auto std::hash< lizard::TensorElement >::operator()(const lizard::TensorElement &element) -> std::size_t {
+auto std::hash< lizard::TensorElement >::operator()(const lizard::TensorElement &element) const -> std::size_t {
 	std::size_t hash = std::hash< lizard::TensorBlock >{}(element.getBlock());
 
 	// NOLINTNEXTLINE
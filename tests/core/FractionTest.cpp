@@ -67,6 +67,24 @@ TEST(ConversionTest, divide) {
 	ASSERT_EQ(4 / Fraction(1, 2), Fraction(8));
 }
 
+TEST(ConversionTest, add) {
+	ASSERT_EQ(Fraction(1, 2) + Fraction(1, 3), Fraction(5, 6));
+	ASSERT_EQ(Fraction(3, 4) + Fraction(1, 4), Fraction(1));
+	ASSERT_EQ(Fraction(1, 6) + Fraction(-1, 6), Fraction(0));
+
+	ASSERT_EQ(Fraction(1, 2) + 1, Fraction(3, 2));
+	ASSERT_EQ(2 + Fraction(1, 3), Fraction(7, 3));
+}
+
+TEST(ConversionTest, subtract) {
+	ASSERT_EQ(Fraction(1, 2) - Fraction(1, 3), Fraction(1, 6));
+	ASSERT_EQ(Fraction(1, 4) - Fraction(3, 4), Fraction(-1, 2));
+	ASSERT_EQ(-Fraction(2, 3), Fraction(-2, 3));
+
+	ASSERT_EQ(Fraction(1, 2) - 1, Fraction(-1, 2));
+	ASSERT_EQ(1 - Fraction(1, 3), Fraction(2, 3));
+}
+
 
 ////////////////////////////////////////////////////////////////////////////////////////////
 ///////////////////////////// TEST SUITE INSTANTIATIONS ////////////////////////////////////
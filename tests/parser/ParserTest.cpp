@@ -3,20 +3,28 @@
 // can be found in the LICENSE file at the root of the lizard source
 // tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
 
+#include "lizard/parser/GeCCoContraction.hpp"
 #include "lizard/parser/GeCCoExportParser.hpp"
 #include "lizard/parser/ParseException.hpp"
 #include "lizard/parser/TensorSymmetryParser.hpp"
+#include "lizard/parser/TensorSymmetrySpecification.hpp"
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
 #include <string_view>
+#include <utility>
+#include <vector>
 
 namespace lizard::test::parser {
 
-template< typename Parser, bool shouldError > void parseFilesIn(std::string_view inputFilePath) {
-	Parser parser;
-
+template< typename Parser, bool shouldError >
+void parseFilesIn(std::string_view inputFilePath, Parser parser = Parser()) {
 	for (const std::filesystem::directory_entry &currentEntry :
 		 std::filesystem::recursive_directory_iterator(inputFilePath)) {
 		if (!currentEntry.is_regular_file() && !currentEntry.is_symlink()) {
@@ -37,6 +45,46 @@ template< typename Parser, bool shouldError > void parseFilesIn(std::string_view
 	}
 }
 
+auto sameIndices(const std::vector<::lizard::parser::GeCCoIndexBlock > &lhs,
+				 const std::vector<::lizard::parser::GeCCoIndexBlock > &rhs) -> bool {
+	return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+					  [](const ::lizard::parser::GeCCoIndexBlock &left,
+						 const ::lizard::parser::GeCCoIndexBlock &right) {
+						  return left.creators == right.creators && left.annihilators == right.annihilators;
+					  });
+}
+
+auto sameTensor(const ::lizard::parser::GeCCoTensor &lhs, const ::lizard::parser::GeCCoTensor &rhs) -> bool {
+	return lhs.name == rhs.name && lhs.transposed == rhs.transposed && sameIndices(lhs.indices, rhs.indices);
+}
+
+auto sameArcs(const std::vector<::lizard::parser::GeCCoArc > &lhs, const std::vector<::lizard::parser::GeCCoArc > &rhs)
+	-> bool {
+	return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+					  [](const ::lizard::parser::GeCCoArc &left, const ::lizard::parser::GeCCoArc &right) {
+						  return left.from == right.from && left.to == right.to
+								 && sameIndices(left.indices, right.indices);
+					  });
+}
+
+auto sameString(const ::lizard::parser::GeCCoIndexString &lhs, const ::lizard::parser::GeCCoIndexString &rhs) -> bool {
+	return lhs.vertices == rhs.vertices && lhs.types == rhs.types && lhs.spaces == rhs.spaces
+		   && lhs.resultFlags == rhs.resultFlags && lhs.arcs == rhs.arcs && lhs.ids == rhs.ids;
+}
+
+auto sameContraction(const ::lizard::parser::GeCCoContraction &lhs, const ::lizard::parser::GeCCoContraction &rhs)
+	-> bool {
+	return lhs.index == rhs.index && sameTensor(lhs.result, rhs.result) && lhs.externalFactor == rhs.externalFactor
+		   && lhs.sign == rhs.sign && lhs.contractionFactor == rhs.contractionFactor
+		   && lhs.vertexCount == rhs.vertexCount && lhs.operatorCount == rhs.operatorCount
+		   && lhs.superVertex == rhs.superVertex && lhs.arcCount == rhs.arcCount
+		   && lhs.externalArcCount == rhs.externalArcCount
+		   && std::equal(lhs.vertices.begin(), lhs.vertices.end(), rhs.vertices.begin(), rhs.vertices.end(), sameTensor)
+		   && sameArcs(lhs.arcs, rhs.arcs) && sameArcs(lhs.externalArcs, rhs.externalArcs)
+		   && sameString(lhs.contractionString, rhs.contractionString)
+		   && sameString(lhs.resultString, rhs.resultString);
+}
+
 TEST(Parser, gecco_export_parse_valid) {
 	parseFilesIn<::lizard::parser::GeCCoExportParser, false >(TEST_FILE_DIR "/parser_input/GeCCoExport/valid");
 }
@@ -45,6 +93,159 @@ TEST(Parser, gecco_export_parse_invalid) {
 	parseFilesIn<::lizard::parser::GeCCoExportParser, true >(TEST_FILE_DIR "/parser_input/GeCCoExport/invalid");
 }
 
+TEST(Parser, gecco_export_contractions) {
+	std::vector<::lizard::parser::GeCCoContraction > contractions;
+
+	::lizard::parser::GeCCoExportParser parser;
+	parser.parse(std::filesystem::path(TEST_FILE_DIR "/parser_input/GeCCoExport/valid/CCSD_EN.EXPORT"),
+				 [&](const ::lizard::parser::GeCCoContraction &contraction) {
+					 contractions.push_back(contraction);
+				 });
+
+	ASSERT_EQ(contractions.size(), 4);
+
+	const ::lizard::parser::GeCCoContraction &contraction = contractions[1];
+	ASSERT_EQ(contraction.index, 2);
+	ASSERT_EQ(contraction.result.name, "ECCD");
+	ASSERT_FALSE(contraction.result.transposed);
+	ASSERT_EQ(contraction.result.indices.size(), 1);
+	ASSERT_TRUE(contraction.result.indices[0].creators.empty());
+	ASSERT_DOUBLE_EQ(contraction.externalFactor, 1.0);
+	ASSERT_EQ(contraction.sign, 1);
+	ASSERT_DOUBLE_EQ(contraction.contractionFactor, 0.25);
+	ASSERT_EQ(contraction.vertexCount, 2);
+	ASSERT_EQ(contraction.operatorCount, 2);
+	ASSERT_EQ(contraction.superVertex, (std::vector< int >{ 1, 2 }));
+	ASSERT_EQ(contraction.arcCount, 1);
+	ASSERT_EQ(contraction.externalArcCount, 0);
+	ASSERT_EQ(contraction.vertices.size(), 2);
+	ASSERT_EQ(contraction.vertices[0].name, "H");
+	ASSERT_EQ(contraction.vertices[0].indices[0].creators, "HH");
+	ASSERT_EQ(contraction.vertices[0].indices[0].annihilators, "PP");
+	ASSERT_EQ(contraction.vertices[1].name, "T2");
+	ASSERT_EQ(contraction.arcs.size(), 1);
+	ASSERT_EQ(contraction.arcs[0].from, 1);
+	ASSERT_EQ(contraction.arcs[0].to, 2);
+	ASSERT_TRUE(contraction.externalArcs.empty());
+	ASSERT_EQ(contraction.contractionString.vertices, (std::vector< int >{ 1, 1, 1, 1, 2, 2, 2, 2 }));
+	ASSERT_EQ(contraction.contractionString.ids, (std::vector< int >{ 1, 2, 2, 1, 1, 2, 2, 1 }));
+	ASSERT_EQ(contraction.contractionString.resultFlags, std::vector< bool >(8, false));
+	ASSERT_TRUE(contraction.resultString.vertices.empty());
+}
+
+TEST(Parser, gecco_export_error_location) {
+	std::stringstream input;
+	input << "[CONTR] #        1\n"
+		  << "  /RESULT/\n"
+		  << "        ECCD  F [,]\n"
+		  << "  /FACTOR/         1.00000000000000   1   bla\n";
+
+	try {
+		::lizard::parser::GeCCoExportParser().parse(input, "test.EXPORT");
+		FAIL() << "Parsing of invalid input succeeded without errors";
+	} catch (const ::lizard::parser::ParseException &e) {
+		ASSERT_EQ(std::string_view(e.what()).rfind("test.EXPORT:4:", 0), 0) << e.what();
+	}
+}
+
+TEST(Parser, gecco_export_chunks) {
+	const std::filesystem::path path(TEST_FILE_DIR "/parser_input/GeCCoExport/valid/CCSD_RES2.EXPORT");
+
+	std::vector<::lizard::parser::GeCCoContraction > expected;
+	::lizard::parser::GeCCoExportParser().parse(
+		path, [&](const ::lizard::parser::GeCCoContraction &contraction) { expected.push_back(contraction); });
+
+	std::ifstream stream(path);
+	const std::string content((std::istreambuf_iterator< char >(stream)), std::istreambuf_iterator< char >());
+
+	const std::vector<::lizard::parser::GeCCoExportParser::Chunk > chunks =
+		::lizard::parser::GeCCoExportParser::splitIntoChunks(content, 5);
+
+	ASSERT_EQ(chunks.size(), (expected.size() + 4) / 5);
+	ASSERT_EQ(chunks[0].firstLine, 1);
+
+	std::vector<::lizard::parser::GeCCoContraction > contractions;
+	for (const ::lizard::parser::GeCCoExportParser::Chunk &currentChunk : chunks) {
+		::lizard::parser::GeCCoExportParser::parseChunk(
+			currentChunk,
+			[&](const ::lizard::parser::GeCCoContraction &contraction) { contractions.push_back(contraction); });
+	}
+
+	ASSERT_EQ(contractions.size(), expected.size());
+	for (std::size_t i = 0; i < contractions.size(); ++i) {
+		ASSERT_EQ(contractions[i].index, expected[i].index);
+		ASSERT_EQ(contractions[i].result.name, expected[i].result.name);
+		ASSERT_EQ(contractions[i].contractionString.ids, expected[i].contractionString.ids);
+	}
+
+	// Errors within a chunk have to be reported with their location in the original input
+	const std::string invalid = "[CONTR] #        1\n"
+								"  /RESULT/\n"
+								"        ECCD  F [,]\n"
+								"  /FACTOR/         1.00000000000000   1   bla\n"
+								"[END]\n";
+	try {
+		for (const ::lizard::parser::GeCCoExportParser::Chunk &currentChunk :
+			 ::lizard::parser::GeCCoExportParser::splitIntoChunks(invalid, 5, "test.EXPORT")) {
+			::lizard::parser::GeCCoExportParser::parseChunk(
+				currentChunk, [](const ::lizard::parser::GeCCoContraction &) {}, "test.EXPORT");
+		}
+		FAIL() << "Parsing of invalid input succeeded without errors";
+	} catch (const ::lizard::parser::ParseException &e) {
+		ASSERT_EQ(std::string_view(e.what()).rfind("test.EXPORT:4:", 0), 0) << e.what();
+	}
+
+	ASSERT_THROW((void) ::lizard::parser::GeCCoExportParser::splitIntoChunks("[CONTR] #        1\n", 5),
+				 ::lizard::parser::ParseException);
+}
+
+TEST(Parser, gecco_export_fast_backend) {
+	using Backend = ::lizard::parser::GeCCoExportParser::Backend;
+
+	::lizard::parser::GeCCoExportParser antlrParser(Backend::ANTLR);
+	::lizard::parser::GeCCoExportParser fastParser(Backend::Fast);
+	ASSERT_EQ(fastParser.getBackend(), Backend::Fast);
+
+	// Both backends have to produce identical contractions
+	for (const std::filesystem::directory_entry &currentEntry :
+		 std::filesystem::directory_iterator(TEST_FILE_DIR "/parser_input/GeCCoExport/valid")) {
+		std::vector<::lizard::parser::GeCCoContraction > expected;
+		antlrParser.parse(currentEntry.path(), [&](const ::lizard::parser::GeCCoContraction &contraction) {
+			expected.push_back(contraction);
+		});
+
+		std::vector<::lizard::parser::GeCCoContraction > contractions;
+		fastParser.parse(currentEntry.path(), [&](const ::lizard::parser::GeCCoContraction &contraction) {
+			contractions.push_back(contraction);
+		});
+
+		ASSERT_EQ(contractions.size(), expected.size()) << currentEntry.path();
+		for (std::size_t i = 0; i < contractions.size(); ++i) {
+			ASSERT_TRUE(sameContraction(contractions[i], expected[i]))
+				<< "Contraction #" << expected[i].index << " in " << currentEntry.path();
+		}
+	}
+
+	parseFilesIn<::lizard::parser::GeCCoExportParser, true >(TEST_FILE_DIR "/parser_input/GeCCoExport/invalid",
+															 fastParser);
+
+	const std::string invalid = "[CONTR] #        1\n"
+								"  /RESULT/\n"
+								"        ECCD  F [,]\n"
+								"  /FACTOR/         1.00000000000000   1   bla\n"
+								"[END]\n";
+	try {
+		for (const ::lizard::parser::GeCCoExportParser::Chunk &currentChunk :
+			 ::lizard::parser::GeCCoExportParser::splitIntoChunks(invalid, 5, "test.EXPORT")) {
+			::lizard::parser::GeCCoExportParser::parseChunk(
+				currentChunk, [](const ::lizard::parser::GeCCoContraction &) {}, "test.EXPORT", Backend::Fast);
+		}
+		FAIL() << "Parsing of invalid input succeeded without errors";
+	} catch (const ::lizard::parser::ParseException &e) {
+		ASSERT_EQ(std::string_view(e.what()).rfind("test.EXPORT:4:", 0), 0) << e.what();
+	}
+}
+
 TEST(Parser, tensor_symmetry_parse_valid) {
 	parseFilesIn<::lizard::parser::TensorSymmetryParser, false >(TEST_FILE_DIR "/parser_input/TensorSymmetry/valid");
 }
@@ -53,4 +254,51 @@ TEST(Parser, tensor_symmetry_parse_invalid) {
 	parseFilesIn<::lizard::parser::TensorSymmetryParser, true >(TEST_FILE_DIR "/parser_input/TensorSymmetry/invalid");
 }
 
+TEST(Parser, tensor_symmetry_contents) {
+	using ::lizard::parser::SlotExchange;
+
+	const ::lizard::parser::TensorSymmetrySpecification specification = ::lizard::parser::TensorSymmetryParser().parse(
+		std::filesystem::path(TEST_FILE_DIR "/parser_input/TensorSymmetry/valid/example.symmetry"));
+
+	ASSERT_EQ(specification.indexSpaces.size(), 1);
+	ASSERT_EQ(specification.indexSpaces[0].name, "MY_SPACE");
+	ASSERT_EQ(specification.indexSpaces[0].choices, (std::vector< std::string >{ "P", "Q" }));
+
+	ASSERT_EQ(specification.symmetries.size(), 3);
+
+	const auto sameExchange = [](const SlotExchange &lhs, const SlotExchange &rhs) {
+		return lhs.first == rhs.first && lhs.second == rhs.second;
+	};
+
+	const ::lizard::parser::TensorSymmetryDefinition &first = specification.symmetries[0];
+	ASSERT_EQ(first.tensorName, "T2");
+	ASSERT_EQ(first.creatorSpaces, (std::vector< std::string >{ "MY_SPACE", "P", "Q" }));
+	ASSERT_EQ(first.annihilatorSpaces, (std::vector< std::string >{ "A", "B" }));
+	ASSERT_EQ(first.exchanges.size(), 2);
+	ASSERT_TRUE(sameExchange(first.exchanges[0], SlotExchange{ 1, 2 }));
+	ASSERT_TRUE(sameExchange(first.exchanges[1], SlotExchange{ 3, 4 }));
+	ASSERT_EQ(first.factor, 1);
+
+	ASSERT_EQ(specification.symmetries[1].tensorName, "E");
+	ASSERT_EQ(specification.symmetries[1].factor, -1);
+	ASSERT_EQ(specification.symmetries[2].tensorName, "MY_TENSOR");
+	ASSERT_EQ(specification.symmetries[2].creatorSpaces, (std::vector< std::string >{ "A" }));
+	ASSERT_EQ(specification.symmetries[2].annihilatorSpaces, (std::vector< std::string >{ "B" }));
+	ASSERT_EQ(specification.symmetries[2].factor, 1);
+}
+
+TEST(Parser, tensor_symmetry_error_location) {
+	// Syntactically valid, but slot 3 doesn't exist
+	std::stringstream input;
+	input << "E[A;B]: 1,2 -> -1;\n"
+		  << "F[A;B]: 1,3 -> -1;\n";
+
+	try {
+		::lizard::parser::TensorSymmetryParser().parse(input, "test.symmetry");
+		FAIL() << "Parsing of invalid input succeeded without errors";
+	} catch (const ::lizard::parser::ParseException &e) {
+		ASSERT_EQ(std::string_view(e.what()).rfind("test.symmetry:2:10:", 0), 0) << e.what();
+	}
+}
+
 } // namespace lizard::test::parser
@@ -0,0 +1,110 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#include "PrettyPrint.hpp"
+#include "Utils.hpp"
+
+#include "lizard/process/BinaryArchive.hpp"
+#include "lizard/process/BinaryExport.hpp"
+#include "lizard/process/ImportException.hpp"
+#include "lizard/symbolic/TensorExpressions.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+
+using namespace lizard;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////// TEST FIXTURES //////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////
+
+auto createArchiveTestExpressions() -> std::vector< NamedTensorExprTree > {
+	std::vector< NamedTensorExprTree > expressions;
+	expressions.push_back(test::createTree< NamedTensorExprTree >("E[] = H[i+,j+,a-,b-](||||) * T[a+,b+,i-,j-](||||)"));
+	expressions.push_back(test::createTree< NamedTensorExprTree >("R[a+,i-](||) = F[a+,i-](||) + F[a+,b-](||) * "
+																  "T[b+,i-](||)"));
+	expressions.push_back(test::createTree< NamedTensorExprTree >("R[a+,b+,i-,j-](||||) = H[a+,b+,c-,d-](||||) * "
+																  "T[c+,d+,i-,j-](||||)"));
+
+	return expressions;
+}
+
+class BinaryArchiveTest : public ::testing::Test {
+protected:
+	void SetUp() override {
+		m_path = std::filesystem::temp_directory_path() / "lizard_binary_archive_test.lzb";
+
+		std::ofstream stream(m_path, std::ios::binary | std::ios::trunc);
+		BinaryExport::write(createArchiveTestExpressions(), test::getIndexSpaceManager(), stream);
+	}
+
+	void TearDown() override { std::filesystem::remove(m_path); }
+
+	std::filesystem::path m_path;
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////// TEST CASES ////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST_F(BinaryArchiveTest, results) {
+	const std::vector< NamedTensorExprTree > expressions = createArchiveTestExpressions();
+
+	BinaryArchive archive(m_path, test::getIndexSpaceManager());
+
+	ASSERT_EQ(archive.size(), expressions.size());
+
+	for (std::size_t i = 0; i < expressions.size(); ++i) {
+		ASSERT_EQ(archive.getResults()[i], expressions[i].getResult());
+		ASSERT_TRUE(archive.contains(expressions[i].getResult()));
+
+		// Opening the archive doesn't decode any of the trees
+		ASSERT_FALSE(archive.isLoaded(i));
+	}
+
+	ASSERT_FALSE(archive.contains(test::createTensorElement("R[a+,b+,i-,k-](||||)")));
+}
+
+TEST_F(BinaryArchiveTest, lazy_access) {
+	const std::vector< NamedTensorExprTree > expressions = createArchiveTestExpressions();
+
+	BinaryArchive archive(m_path, test::getIndexSpaceManager());
+
+	const NamedTensorExprTree &doubles = archive.get(expressions[2].getResult());
+	ASSERT_EQ(doubles, expressions[2]);
+
+	// Only the requested tree has been decoded
+	ASSERT_FALSE(archive.isLoaded(0));
+	ASSERT_FALSE(archive.isLoaded(1));
+	ASSERT_TRUE(archive.isLoaded(2));
+
+	// Accessing a tree again doesn't decode it anew
+	ASSERT_EQ(&archive.get(2), &doubles);
+
+	ASSERT_EQ(archive.get(0), expressions[0]);
+	ASSERT_TRUE(archive.isLoaded(0));
+
+	ASSERT_THROW((void) archive.get(test::createTensorElement("R[a+,b+,i-,k-](||||)")), ImportException);
+	ASSERT_THROW((void) archive.get(expressions.size()), ImportException);
+}
+
+TEST_F(BinaryArchiveTest, invalid_file) {
+	ASSERT_THROW(BinaryArchive(m_path.string() + ".missing", test::getIndexSpaceManager()), ImportException);
+
+	{
+		std::ofstream stream(m_path, std::ios::binary | std::ios::app);
+		stream << "trailing";
+	}
+
+	ASSERT_THROW(BinaryArchive(m_path, test::getIndexSpaceManager()), ImportException);
+}
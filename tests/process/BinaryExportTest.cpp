@@ -0,0 +1,221 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#include "PrettyPrint.hpp"
+#include "Utils.hpp"
+
+#include "lizard/core/Fraction.hpp"
+#include "lizard/process/BinaryExport.hpp"
+#include "lizard/process/BinaryImport.hpp"
+#include "lizard/process/ImportException.hpp"
+#include "lizard/symbolic/IndexSpaceManager.hpp"
+#include "lizard/symbolic/TensorExpressions.hpp"
+#include "lizard/symbolic/TreeNode.hpp"
+
+#include <gtest/gtest.h>
+
+#include <spdlog/logger.h>
+#include <spdlog/sinks/null_sink.h>
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+using namespace lizard;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////// TEST FIXTURES //////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////
+
+auto createBinaryTestExpressions() -> std::vector< NamedTensorExprTree > {
+	std::vector< NamedTensorExprTree > expressions;
+	expressions.push_back(test::createTree< NamedTensorExprTree >("R[a+,b+,i-,j-](||||) = H[a+,b+,c-,d-](||||) * "
+																  "T[c+,d+,i-,j-](||||) + 2 * F[a+,c-](||) * "
+																  "T[c+,b+,i-,j-](||||)"));
+	expressions.push_back(
+		test::createTree< NamedTensorExprTree >("E[] = -1 * H[i+,j+,a-,b-](||||) * T[a+,b+,i-,j-](||||)"));
+	expressions.push_back(test::createTree< NamedTensorExprTree >("O[a+,P-](||) = B[a+,Q-](||) * C[Q+,P-](||)"));
+
+	// Non-integer literal
+	NamedTensorExprTree halved(test::createTensorElement("Z[i+,j-](||)"));
+	halved.add(TreeNode(Fraction(1, 2)));
+	halved.add(test::createTensorElement("F[i+,j-](||)"));
+	halved.add(TreeNode(ExpressionOperator::Times));
+	expressions.push_back(std::move(halved));
+
+	// Result without any expression
+	expressions.emplace_back(test::createTensorElement("Y[i+,j-](||)"));
+
+	return expressions;
+}
+
+auto exportToBinary(const std::vector< NamedTensorExprTree > &expressions) -> std::string {
+	std::ostringstream stream;
+	BinaryExport::write(expressions, test::getIndexSpaceManager(), stream);
+
+	return stream.str();
+}
+
+void assertSameExpressions(const std::vector< NamedTensorExprTree > &actual,
+						   const std::vector< NamedTensorExprTree > &expected) {
+	ASSERT_EQ(actual.size(), expected.size());
+
+	for (std::size_t i = 0; i < actual.size(); ++i) {
+		ASSERT_EQ(actual[i].getResult(), expected[i].getResult());
+		ASSERT_EQ(actual[i].isEmpty(), expected[i].isEmpty());
+
+		if (expected[i].isEmpty()) {
+			// Empty trees can't be compared (or iterated)
+			continue;
+		}
+
+		ASSERT_EQ(actual[i], expected[i]);
+
+		for (auto actualIter = actual[i].begin(), expectedIter = expected[i].begin(); actualIter != actual[i].end();
+			 ++actualIter, ++expectedIter) {
+			if (actualIter->getType() == ExpressionType::Variable) {
+				ASSERT_EQ(actualIter->getVariable().getBlock().getSlotSymmetry(),
+						  expectedIter->getVariable().getBlock().getSlotSymmetry());
+			}
+		}
+	}
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////// TEST CASES ////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(BinaryExport, round_trip) {
+	const std::vector< NamedTensorExprTree > expressions = createBinaryTestExpressions();
+
+	const std::string data = exportToBinary(expressions);
+
+	assertSameExpressions(BinaryImport::read(data, test::getIndexSpaceManager()), expressions);
+
+	// Exporting the imported expressions has to reproduce the same data
+	ASSERT_EQ(exportToBinary(BinaryImport::read(data, test::getIndexSpaceManager())), data);
+}
+
+TEST(BinaryExport, header) {
+	const std::string data = exportToBinary(createBinaryTestExpressions());
+
+	ASSERT_GE(data.size(), 8);
+	ASSERT_EQ(data.substr(0, 4), "LZBX");
+	// The version is stored as little-endian
+	ASSERT_EQ(static_cast< unsigned char >(data[4]), BinaryExport::FormatVersion & 0xFFU);
+	ASSERT_EQ(static_cast< unsigned char >(data[5]), BinaryExport::FormatVersion >> 8U);
+}
+
+TEST(BinaryExport, write_to_file) {
+	const std::filesystem::path path = std::filesystem::temp_directory_path() / "lizard_binary_export_test.lzb";
+	const std::vector< NamedTensorExprTree > expressions = createBinaryTestExpressions();
+
+	auto logger = std::make_shared< spdlog::logger >("binary_test", std::make_shared< spdlog::sinks::null_sink_mt >());
+
+	BinaryExport exporter(path);
+	exporter.setLogger(logger);
+	exporter.exportExpressions(expressions, test::getIndexSpaceManager());
+
+	BinaryImport importer(path);
+	importer.setLogger(logger);
+	assertSameExpressions(importer.importExpressions(test::getIndexSpaceManager()), expressions);
+
+	std::filesystem::remove(path);
+
+	ASSERT_THROW((void) importer.importExpressions(test::getIndexSpaceManager()), ImportException);
+}
+
+TEST(BinaryImport, selected_results) {
+	const std::vector< NamedTensorExprTree > expressions = createBinaryTestExpressions();
+	const std::string data                               = exportToBinary(expressions);
+
+	// The selected trees are returned in the order in which they are stored
+	const std::vector< std::string > selection = { "Z", "E" };
+	assertSameExpressions(BinaryImport::read(data, test::getIndexSpaceManager(), "<memory>", selection),
+						  { expressions[1], expressions[3] });
+
+	const std::vector< std::string > unknownSelection = { "E", "X" };
+	ASSERT_THROW((void) BinaryImport::read(data, test::getIndexSpaceManager(), "<memory>", unknownSelection),
+				 ImportException);
+}
+
+TEST(BinaryImport, corrupted_data) {
+	const std::string data = exportToBinary(createBinaryTestExpressions());
+
+	// Every truncation has to be detected
+	for (std::size_t i = 0; i < data.size(); ++i) {
+		ASSERT_THROW((void) BinaryImport::read(data.substr(0, i), test::getIndexSpaceManager()), ImportException)
+			<< "Truncated to " << i << " bytes";
+	}
+
+	std::string wrongVersion = data;
+	wrongVersion[4]++;
+	ASSERT_THROW((void) BinaryImport::read(wrongVersion, test::getIndexSpaceManager()), ImportException);
+
+	std::string wrongMagic = data;
+	wrongMagic[0] = 'X';
+	ASSERT_THROW((void) BinaryImport::read(wrongMagic, test::getIndexSpaceManager()), ImportException);
+
+	ASSERT_THROW((void) BinaryImport::read(data + '\0', test::getIndexSpaceManager()), ImportException);
+}
+
+TEST(BinaryImport, non_canonical_element) {
+	const std::string data = exportToBinary({ test::createTree< NamedTensorExprTree >(
+		"R[i+,j+,a-,b-](||||) = H[i+,j+,c-,d-](||||) * T[c+,d+,a-,b-](||||)") });
+
+	// The encoded creators of R and H, which are stored in canonical order
+	const TensorElement result = test::createTensorElement("R[i+,j+,a-,b-](||||)");
+	std::string creators;
+	for (const Index &current : result.getIndices().first(2)) {
+		creators.push_back(static_cast< char >(current.getID()));
+		creators.push_back(static_cast< char >(current.getType()));
+	}
+
+	std::string swapped = creators.substr(2) + creators.substr(0, 2);
+
+	// Elements inside of the trees are stored before the results
+	const std::size_t elementPosition = data.find(creators);
+	const std::size_t resultPosition  = data.rfind(creators);
+	ASSERT_NE(elementPosition, std::string::npos);
+	ASSERT_NE(elementPosition, resultPosition);
+
+	for (std::size_t position : { elementPosition, resultPosition }) {
+		std::string corrupted = data;
+		corrupted.replace(position, swapped.size(), swapped);
+
+		ASSERT_THROW((void) BinaryImport::read(corrupted, test::getIndexSpaceManager()), ImportException)
+			<< "Swapped indices at " << position;
+	}
+}
+
+TEST(BinaryImport, incompatible_index_spaces) {
+	const std::string data = exportToBinary(createBinaryTestExpressions());
+
+	// "ext" is unknown
+	IndexSpaceManager missingSpace;
+	missingSpace.registerSpace(IndexSpace(0, Spin::Both),
+							   IndexSpaceData("occ", 'o', 16, Spin::Both, { 'i', 'j', 'k', 'l', 'm', 'n' }));
+	missingSpace.registerSpace(IndexSpace(1, Spin::Both),
+							   IndexSpaceData("virt", 'v', 256, Spin::Both, { 'a', 'b', 'c', 'd', 'e', 'f' }));
+
+	ASSERT_THROW((void) BinaryImport::read(data, missingSpace), ImportException);
+
+	// "occ" and "virt" use swapped IDs
+	IndexSpaceManager swappedSpaces;
+	swappedSpaces.registerSpace(IndexSpace(1, Spin::Both),
+								IndexSpaceData("occ", 'o', 16, Spin::Both, { 'i', 'j', 'k', 'l', 'm', 'n' }));
+	swappedSpaces.registerSpace(IndexSpace(0, Spin::Both),
+								IndexSpaceData("virt", 'v', 256, Spin::Both, { 'a', 'b', 'c', 'd', 'e', 'f' }));
+	swappedSpaces.registerSpace(IndexSpace(2, Spin::None),
+								IndexSpaceData("ext", 'e', 256, Spin::None, { 'P', 'Q', 'R', 'S', 'T', 'U' }));
+
+	ASSERT_THROW((void) BinaryImport::read(data, swappedSpaces), ImportException);
+}
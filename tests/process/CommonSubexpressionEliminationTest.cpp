@@ -0,0 +1,118 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#include "PrettyPrint.hpp"
+#include "Utils.hpp"
+
+#include "lizard/process/CommonSubexpressionElimination.hpp"
+#include "lizard/symbolic/TensorExpressions.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <spdlog/logger.h>
+#include <spdlog/sinks/null_sink.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+
+using namespace lizard;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////// TEST FIXTURES //////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////
+
+class CommonSubexpressionEliminationTest : public ::testing::Test {
+protected:
+	void SetUp() override {
+		m_cse.setLogger(
+			std::make_shared< spdlog::logger >("cse_test", std::make_shared< spdlog::sinks::null_sink_mt >()));
+	}
+
+	static auto createIntermediate(const std::string &name, std::string_view indexSpec) -> TensorElement {
+		auto [element, sign] = TensorElement::create(Tensor(name), test::createIndexSequence(indexSpec), {});
+		(void) sign;
+		return element;
+	}
+
+	CommonSubexpressionElimination m_cse;
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////// TEST CASES ////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST_F(CommonSubexpressionEliminationTest, nothing_shared) {
+	const std::vector< NamedTensorExprTree > input = {
+		test::createTree< NamedTensorExprTree >("R[a+,i-] = F[a+,b-] * (H[b+,j-] * T[j+,i-])"),
+		test::createTree< NamedTensorExprTree >("S[a+,i-] = G[a+,b-] * (H[b+,j-] * F[j+,i-])"),
+	};
+
+	std::vector< NamedTensorExprTree > actual = input;
+	m_cse.process(actual, test::getIndexSpaceManager());
+
+	ASSERT_THAT(actual, ::testing::ElementsAreArray(input));
+}
+
+TEST_F(CommonSubexpressionEliminationTest, shared_contraction) {
+	std::vector< NamedTensorExprTree > expressions = {
+		test::createTree< NamedTensorExprTree >("R[a+,i-] = F[a+,b-] * (H[b+,j-] * T[j+,i-])"),
+		test::createTree< NamedTensorExprTree >("S[a+,i-] = 2 * G[a+,c-] * (H[c+,k-] * T[k+,i-]) + F[a+,i-]"),
+	};
+
+	m_cse.process(expressions, test::getIndexSpaceManager());
+
+	ASSERT_EQ(expressions.size(), 3);
+
+	const TensorElement intermediate = createIntermediate("INTER_0001", "[a+,j-]");
+	ASSERT_EQ(expressions[0].getResult(), intermediate);
+	ASSERT_EQ(expressions[0], test::createTree< TensorExprTree >("H[a+,i-] * T[i+,j-]"));
+
+	TensorExprTree expectedR;
+	expectedR.add(test::createTensorElement("F[a+,b-]"));
+	expectedR.add(createIntermediate("INTER_0001", "[b+,i-]"));
+	expectedR.add(TreeNode(ExpressionOperator::Times));
+
+	ASSERT_EQ(expressions[1].getResult(), test::createTensorElement("R[a+,i-]"));
+	ASSERT_EQ(expressions[1], expectedR);
+
+	TensorExprTree expectedS;
+	expectedS.add(TreeNode(2));
+	expectedS.add(test::createTensorElement("G[a+,c-]"));
+	expectedS.add(createIntermediate("INTER_0001", "[c+,i-]"));
+	expectedS.add(TreeNode(ExpressionOperator::Times));
+	expectedS.add(TreeNode(ExpressionOperator::Times));
+	expectedS.add(test::createTensorElement("F[a+,i-]"));
+	expectedS.add(TreeNode(ExpressionOperator::Plus));
+
+	ASSERT_EQ(expressions[2].getResult(), test::createTensorElement("S[a+,i-]"));
+	ASSERT_EQ(expressions[2], expectedS);
+}
+
+TEST_F(CommonSubexpressionEliminationTest, nested_intermediates) {
+	std::vector< NamedTensorExprTree > expressions = {
+		test::createTree< NamedTensorExprTree >("R[a+,i-] = X[a+,i-] * (F[j+,b-] * (H[b+,k-] * T[k+,j-]))"),
+		test::createTree< NamedTensorExprTree >("S[a+,i-] = Y[a+,i-] * (F[l+,c-] * (H[c+,m-] * T[m+,l-]))"),
+	};
+
+	m_cse.process(expressions, test::getIndexSpaceManager());
+
+	// One intermediate for H*T and a second one for F*INTER_0001
+	ASSERT_EQ(expressions.size(), 4);
+	ASSERT_EQ(expressions[0].getResult().getBlock().getTensor().getName(), "INTER_0001");
+	ASSERT_EQ(expressions[1].getResult().getBlock().getTensor().getName(), "INTER_0002");
+	ASSERT_TRUE(expressions[1].getResult().getIndices().empty());
+
+	TensorExprTree expectedR;
+	expectedR.add(test::createTensorElement("X[a+,i-]"));
+	expectedR.add(createIntermediate("INTER_0002", "[]"));
+	expectedR.add(TreeNode(ExpressionOperator::Times));
+
+	ASSERT_EQ(expressions[2], expectedR);
+}
@@ -0,0 +1,112 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#include "Utils.hpp"
+
+#include "lizard/process/CostModel.hpp"
+#include "lizard/symbolic/TensorExpressions.hpp"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <tuple>
+#include <vector>
+
+
+using namespace lizard;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////// TEST FIXTURES //////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////
+
+struct CostModelTest : ::testing::TestWithParam< std::tuple< std::string, double, double, std::string > > {
+	using Params = std::tuple< std::string, double, double, std::string >;
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////// TEST CASES ////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST_P(CostModelTest, estimate) {
+	const std::string &treeSpec        = std::get< 0 >(GetParam());
+	const double expectedFlops         = std::get< 1 >(GetParam());
+	const double expectedPeak          = std::get< 2 >(GetParam());
+	const std::string &expectedScaling = std::get< 3 >(GetParam());
+
+	const CostModel model(test::getIndexSpaceManager());
+
+	const ExpressionCost cost = model.estimate(test::createTree< NamedTensorExprTree >(treeSpec));
+
+	ASSERT_EQ(cost.flops, expectedFlops);
+	ASSERT_EQ(cost.peakIntermediateSize, expectedPeak);
+	ASSERT_EQ(cost.scaling.toString(test::getIndexSpaceManager()), expectedScaling);
+}
+
+TEST(CostModel, report) {
+	const CostModel model(test::getIndexSpaceManager());
+
+	const std::vector< NamedTensorExprTree > expressions = {
+		test::createTree< NamedTensorExprTree >("R[a+,i-] = H[a+,j-] * T[j+,i-] + F[a+,i-]"),
+		test::createTree< NamedTensorExprTree >("E[] = H[i+,j+,a-,b-] * T[a+,b+,i-,j-]"),
+	};
+
+	const CostReport report = model.estimate(expressions);
+
+	ASSERT_EQ(report.expressions.size(), 2);
+	ASSERT_EQ(report.expressions[0].flops, 256 * 16 * 16 + 256 * 16);
+	ASSERT_EQ(report.expressions[1].flops, 16 * 16 * 256 * 256);
+
+	ASSERT_EQ(report.total.flops, report.expressions[0].flops + report.expressions[1].flops);
+	ASSERT_EQ(report.total.peakIntermediateSize, 256 * 16);
+	ASSERT_EQ(report.total.dominantFlops, 16 * 16 * 256 * 256);
+	ASSERT_EQ(report.total.scaling, report.expressions[1].scaling);
+
+	const IndexSpace occ  = test::createIndexSequence("[i+]")[0].getSpace();
+	const IndexSpace virt = test::createIndexSequence("[a+]")[0].getSpace();
+	ASSERT_EQ(report.total.scaling.getExponent(occ), 2);
+	ASSERT_EQ(report.total.scaling.getExponent(virt), 2);
+	ASSERT_EQ(report.total.scaling.getTotalExponent(), 4);
+}
+
+TEST(CostModel, operation) {
+	const CostModel model(test::getIndexSpaceManager());
+
+	const ExpressionCost cost = model.estimateOperation(test::createIndexSequence("[a+,i-,j-]"));
+
+	ASSERT_EQ(cost.flops, 256 * 16 * 16);
+	ASSERT_EQ(cost.dominantFlops, cost.flops);
+	ASSERT_EQ(cost.peakIntermediateSize, 0);
+	ASSERT_EQ(cost.scaling.toString(test::getIndexSpaceManager()), "o^2 v");
+
+	ExpressionCost cheaper = cost;
+	cheaper.flops /= 2;
+	ASSERT_TRUE(cheaper < cost);
+	ASSERT_FALSE(cost < cheaper);
+
+	// Equal flop counts are decided by the size of the largest intermediate
+	ExpressionCost larger       = cost;
+	larger.peakIntermediateSize = 16;
+	ASSERT_TRUE(cost < larger);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+///////////////////////////// TEST SUITE INSTANTIATIONS ////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////
+
+// Note: occupied indices have a size of 16 and virtual ones a size of 256
+INSTANTIATE_TEST_SUITE_P(
+	CostModel, CostModelTest,
+	::testing::Values(CostModelTest::Params{ "R[a+,i-] = F[a+,i-]", 0, 0, "1" },
+					  CostModelTest::Params{ "R[a+,i-] = H[a+,j-] * T[j+,i-]", 256 * 16 * 16, 0, "o^2 v" },
+					  CostModelTest::Params{ "R[a+,i-] = H[a+,j-] * T[j+,i-] + F[a+,i-]",
+											 256 * 16 * 16 + 256 * 16, 256 * 16, "o^2 v" },
+					  // Products are evaluated in the order given by the tree: A * (B * C)
+					  CostModelTest::Params{ "R[i+,j-] = A[i+,a-] * B[a+,k-] * C[k+,j-]", 2 * 256 * 16 * 16,
+											 256 * 16, "o^2 v" },
+					  CostModelTest::Params{ "R[a+,b+,i-,j-] = H[a+,b+,c-,d-] * T[c+,d+,i-,j-]",
+											 256.0 * 256 * 256 * 256 * 16 * 16, 0, "o^2 v^4" }));
@@ -0,0 +1,186 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#include "PrettyPrint.hpp"
+#include "Term.hpp"
+#include "Utils.hpp"
+
+#include "lizard/process/DensityFitting.hpp"
+#include "lizard/process/ProcessingException.hpp"
+#include "lizard/process/SkeletonQuantityMapper.hpp"
+#include "lizard/process/SpinIntegration.hpp"
+#include "lizard/symbolic/TensorExpressions.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <spdlog/logger.h>
+#include <spdlog/sinks/null_sink.h>
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+
+using namespace lizard;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////// TEST FIXTURES //////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////
+
+class DensityFittingTest : public ::testing::Test {
+protected:
+	void SetUp() override {
+		m_fitting.setLogger(std::make_shared< spdlog::logger >("density_fitting_test",
+															   std::make_shared< spdlog::sinks::null_sink_mt >()));
+	}
+
+	DensityFitting m_fitting{ "ext" };
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////// TEST CASES ////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST_F(DensityFittingTest, no_integrals) {
+	const NamedTensorExprTree input = test::createTree< NamedTensorExprTree >("R[a+,i-] = H[a+,j-] * T[j+,i-]");
+
+	std::vector< NamedTensorExprTree > expressions = { input };
+	m_fitting.process(expressions, test::getIndexSpaceManager());
+
+	ASSERT_EQ(expressions.size(), 1);
+	ASSERT_EQ(expressions[0], input);
+}
+
+TEST_F(DensityFittingTest, single_integral) {
+	std::vector< NamedTensorExprTree > expressions = {
+		test::createTree< NamedTensorExprTree >("R[a+,b+,i-,j-] = 2 * H[a+,b+,c-,d-] * T[c+,d+,i-,j-]")
+	};
+	m_fitting.process(expressions, test::getIndexSpaceManager());
+
+	const TensorElement amplitude = test::createTensorElement("T[c+,d+,i-,j-]");
+
+	const std::vector< Term > expectedTerms = {
+		Term{ 2,
+			  { test::createTensorElement("B[P,a+,c-]"), test::createTensorElement("B[P,b+,d-]"), amplitude },
+			  {} },
+		Term{ -2,
+			  { test::createTensorElement("B[P,a+,d-]"), test::createTensorElement("B[P,b+,c-]"), amplitude },
+			  {} },
+	};
+
+	ASSERT_EQ(expressions.size(), 1);
+	ASSERT_EQ(expressions[0], buildSum(expectedTerms));
+}
+
+TEST_F(DensityFittingTest, multiple_integrals) {
+	std::vector< NamedTensorExprTree > expressions = {
+		test::createTree< NamedTensorExprTree >("E[] = H[i+,j+,a-,b-] * H[a+,b+,i-,j-]")
+	};
+	m_fitting.process(expressions, test::getIndexSpaceManager());
+
+	ASSERT_EQ(expressions.size(), 1);
+
+	const std::vector< Term > terms = splitIntoTerms(expressions[0].getRoot());
+	ASSERT_EQ(terms.size(), 4);
+
+	// Every integral has to be fitted with its own auxiliary index
+	const TensorElement firstFactor  = test::createTensorElement("B[P,i+,a-]");
+	const TensorElement secondFactor = test::createTensorElement("B[Q,a+,i-]");
+	for (const Term &currentTerm : terms) {
+		ASSERT_EQ(currentTerm.factors.size(), 4);
+		ASSERT_EQ(currentTerm.factors[0].getIndices()[0], firstFactor.getIndices()[0]);
+		ASSERT_EQ(currentTerm.factors[2].getIndices()[0], secondFactor.getIndices()[0]);
+	}
+
+	ASSERT_EQ(terms[0].prefactor, 1);
+	ASSERT_EQ(terms[1].prefactor, -1);
+	ASSERT_EQ(terms[2].prefactor, -1);
+	ASSERT_EQ(terms[3].prefactor, 1);
+}
+
+TEST_F(DensityFittingTest, factor_symmetry) {
+	std::vector< NamedTensorExprTree > expressions = {
+		test::createTree< NamedTensorExprTree >("R[a+,b+,i-,j-] = H[a+,b+,c-,d-] * T[c+,d+,i-,j-]")
+	};
+	m_fitting.process(expressions, test::getIndexSpaceManager());
+
+	// (ac|P) = (ca|P)
+	const std::vector< Term > terms = splitIntoTerms(expressions[0].getRoot());
+	ASSERT_EQ(terms.size(), 2);
+	ASSERT_EQ(terms[0].factors[0].getBlock().getSlotSymmetry(),
+			  test::createTensorElement("B[P,a+,c-]").getBlock().getSlotSymmetry());
+	ASSERT_EQ(terms[0].factors[0], test::createTensorElement("B[P,c-,a+]"));
+}
+
+TEST_F(DensityFittingTest, spin_integration) {
+	std::vector< NamedTensorExprTree > expressions = {
+		test::createTree< NamedTensorExprTree >("E[] = H[i+,j+,a-,b-](||||) * T[a+,b+,i-,j-](||||)")
+	};
+	m_fitting.process(expressions, test::getIndexSpaceManager());
+
+	const auto nullLogger =
+		std::make_shared< spdlog::logger >("density_fitting_test", std::make_shared< spdlog::sinks::null_sink_mt >());
+
+	SpinIntegration integration;
+	integration.setLogger(nullLogger);
+	integration.process(expressions, test::getIndexSpaceManager());
+
+	SkeletonQuantityMapper mapper;
+	mapper.setLogger(nullLogger);
+	mapper.process(expressions, test::getIndexSpaceManager());
+
+	ASSERT_EQ(expressions.size(), 1);
+
+	std::size_t factorCount = 0;
+	for (const ConstTensorExpr &currentExpr : expressions[0]) {
+		if (currentExpr.getType() != ExpressionType::Variable
+			|| currentExpr.getVariable().getBlock().getTensor().getName() != "B") {
+			continue;
+		}
+
+		const TensorElement &factor = currentExpr.getVariable();
+		factorCount++;
+
+		// The auxiliary index stays spin-free and the factor ends up as a spin-free skeleton quantity that retains its
+		// symmetry
+		ASSERT_EQ(factor.getIndices()[0].getType(), IndexType::External);
+		for (const IndexSpace &currentSlot : factor.getBlock().getIndexSlots()) {
+			ASSERT_EQ(currentSlot.getSpin(), Spin::None);
+		}
+		ASSERT_EQ(factor.getBlock().getSlotSymmetry(),
+				  test::createTensorElement("B[P,i+,a-]").getBlock().getSlotSymmetry());
+	}
+
+	ASSERT_GT(factorCount, 0);
+}
+
+TEST(DensityFitting, unknown_auxiliary_space) {
+	DensityFitting fitting("aux");
+
+	std::vector< NamedTensorExprTree > expressions = {
+		test::createTree< NamedTensorExprTree >("E[] = H[i+,j+,a-,b-] * T[a+,b+,i-,j-]")
+	};
+
+	try {
+		fitting.process(expressions, test::getIndexSpaceManager());
+		FAIL() << "Expected a ProcessingException";
+	} catch (const ProcessingException &e) {
+		// The message has to name the missing space
+		ASSERT_THAT(e.what(), ::testing::HasSubstr("'aux'"));
+	}
+}
+
+TEST(DensityFitting, spin_orbital_auxiliary_space) {
+	DensityFitting fitting("occ");
+
+	std::vector< NamedTensorExprTree > expressions = {
+		test::createTree< NamedTensorExprTree >("E[] = H[i+,j+,a-,b-] * T[a+,b+,i-,j-]")
+	};
+
+	ASSERT_THROW(fitting.process(expressions, test::getIndexSpaceManager()), ProcessingException);
+}
@@ -0,0 +1,171 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#include "PrettyPrint.hpp"
+#include "Utils.hpp"
+
+#include "lizard/process/ExpressionCache.hpp"
+#include "lizard/process/ImportStrategy.hpp"
+#include "lizard/process/OptimizationStrategy.hpp"
+#include "lizard/process/ProcessingStep.hpp"
+#include "lizard/process/Processor.hpp"
+#include "lizard/symbolic/TensorExpressions.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <spdlog/logger.h>
+#include <spdlog/sinks/null_sink.h>
+
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+using namespace lizard;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////// TEST FIXTURES //////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////
+
+class ExpressionCacheTest : public ::testing::Test {
+protected:
+	void SetUp() override {
+		m_directory = std::filesystem::temp_directory_path()
+					  / ("lizard_cache_" + std::string(::testing::UnitTest::GetInstance()->current_test_info()->name()));
+		std::filesystem::remove_all(m_directory);
+	}
+
+	void TearDown() override { std::filesystem::remove_all(m_directory); }
+
+	std::filesystem::path m_directory;
+};
+
+/**
+ * Import strategy that always imports the same expression and counts how often it has been invoked
+ */
+class CountingImport : public ImportStrategy {
+public:
+	CountingImport(std::size_t &counter) : m_counter(&counter) {}
+
+	[[nodiscard]] auto getName() const -> std::string final { return "CountingImport"; }
+
+	[[nodiscard]] auto importExpressions(const IndexSpaceManager &manager) const
+		-> std::vector< NamedTensorExprTree > final {
+		(void) manager;
+		(*m_counter)++;
+		return { test::createTree< NamedTensorExprTree >("R[a+,i-] = H[a+,j-] * T[j+,i-]") };
+	}
+
+private:
+	std::size_t *m_counter;
+};
+
+/**
+ * Optimization strategy that doesn't change the expressions but counts how often it has been invoked
+ */
+class CountingStrategy : public OptimizationStrategy {
+public:
+	CountingStrategy(std::size_t &counter, std::string parameters = {})
+		: m_counter(&counter), m_parameters(std::move(parameters)) {}
+
+	[[nodiscard]] auto getName() const -> std::string final { return "CountingStrategy"; }
+
+	[[nodiscard]] auto getParameters() const -> std::string final { return m_parameters; }
+
+	void process(std::vector< NamedTensorExprTree > &expressions, const IndexSpaceManager &manager) final {
+		(void) expressions;
+		(void) manager;
+		(*m_counter)++;
+	}
+
+private:
+	std::size_t *m_counter;
+	std::string m_parameters;
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////// TEST CASES ////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST_F(ExpressionCacheTest, keys) {
+	std::size_t counter = 0;
+	const std::vector< NamedTensorExprTree > input = {
+		test::createTree< NamedTensorExprTree >("R[a+,i-] = H[a+,j-] * T[j+,i-] + 2 * F[a+,i-]")
+	};
+	const std::vector< NamedTensorExprTree > otherInput = {
+		test::createTree< NamedTensorExprTree >("R[a+,i-] = H[a+,j-] * T[j+,i-] + 3 * F[a+,i-]")
+	};
+
+	const std::string key = ExpressionCache::computeKey(input, CountingStrategy(counter), test::getIndexSpaceManager());
+
+	ASSERT_EQ(key, ExpressionCache::computeKey(input, CountingStrategy(counter), test::getIndexSpaceManager()));
+	ASSERT_NE(key, ExpressionCache::computeKey(otherInput, CountingStrategy(counter), test::getIndexSpaceManager()));
+	ASSERT_NE(key,
+			  ExpressionCache::computeKey(input, CountingStrategy(counter, "other"), test::getIndexSpaceManager()));
+	ASSERT_NE(key, ExpressionCache::computeKey({}, CountingStrategy(counter), test::getIndexSpaceManager()));
+}
+
+TEST_F(ExpressionCacheTest, store_and_load) {
+	ExpressionCache cache(m_directory);
+
+	const std::vector< NamedTensorExprTree > expressions = {
+		test::createTree< NamedTensorExprTree >("R[a+,i-] = H[a+,j-] * T[j+,i-] + 2 * F[a+,i-]"),
+		test::createTree< NamedTensorExprTree >("E[] = H[i+,j+,a-,b-] * T[a+,b+,i-,j-]"),
+	};
+
+	ASSERT_FALSE(cache.contains("abc"));
+	ASSERT_FALSE(cache.load("abc", test::getIndexSpaceManager()).has_value());
+
+	cache.store("abc", expressions, test::getIndexSpaceManager());
+
+	ASSERT_TRUE(cache.contains("abc"));
+	std::optional< std::vector< NamedTensorExprTree > > loaded = cache.load("abc", test::getIndexSpaceManager());
+	ASSERT_TRUE(loaded.has_value());
+	ASSERT_THAT(loaded.value(), ::testing::ElementsAreArray(expressions));
+	for (std::size_t i = 0; i < expressions.size(); ++i) {
+		ASSERT_EQ(loaded.value()[i].getResult(), expressions[i].getResult());
+	}
+}
+
+TEST_F(ExpressionCacheTest, processor_skips_cached_steps) {
+	auto logger = std::make_shared< spdlog::logger >("cache_test", std::make_shared< spdlog::sinks::null_sink_mt >());
+
+	std::size_t importCounter = 0;
+	std::size_t counter       = 0;
+
+	auto runPipeline = [&](const std::string &parameters) {
+		Processor processor(test::getIndexSpaceManager(), logger);
+		processor.setCache(ExpressionCache(m_directory));
+
+		processor.enqueue(ProcessingStep(
+			std::make_unique< CountingImport >(importCounter),
+			ReporterConfig(spdlog::level::off, std::filesystem::temp_directory_path() / "lizard_cache_test.log")));
+		processor.enqueue(ProcessingStep(
+			std::make_unique< CountingStrategy >(counter, parameters),
+			ReporterConfig(spdlog::level::off, std::filesystem::temp_directory_path() / "lizard_cache_test.log")));
+
+		processor.run();
+	};
+
+	runPipeline("");
+	ASSERT_EQ(importCounter, 1);
+	ASSERT_EQ(counter, 1);
+
+	// Identical pipeline -> the results should be taken from the cache
+	runPipeline("");
+	ASSERT_EQ(importCounter, 1);
+	ASSERT_EQ(counter, 1);
+
+	// Changed parameters of the last step -> only the last step needs to be recomputed
+	runPipeline("changed");
+	ASSERT_EQ(importCounter, 1);
+	ASSERT_EQ(counter, 2);
+
+	std::filesystem::remove(std::filesystem::temp_directory_path() / "lizard_cache_test.log");
+}
@@ -0,0 +1,105 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#include "PrettyPrint.hpp"
+#include "Utils.hpp"
+
+#include "lizard/process/Factorization.hpp"
+#include "lizard/process/TermCollection.hpp"
+#include "lizard/symbolic/TensorExpressions.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <spdlog/logger.h>
+#include <spdlog/sinks/null_sink.h>
+
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+
+using namespace lizard;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////// TEST FIXTURES //////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////
+
+struct FactorizationTest : ::testing::TestWithParam< std::tuple< std::string, std::string > > {
+	using Params = std::tuple< std::string, std::string >;
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////// TEST CASES ////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST_P(FactorizationTest, process) {
+	const std::string &inputTreeSpec    = std::get< 0 >(GetParam());
+	const std::string &expectedTreeSpec = std::get< 1 >(GetParam());
+
+	std::vector< NamedTensorExprTree > actual         = { test::createTree< NamedTensorExprTree >(inputTreeSpec) };
+	const std::vector< NamedTensorExprTree > expected = { test::createTree< NamedTensorExprTree >(expectedTreeSpec) };
+
+	Factorization factorization;
+	factorization.setLogger(
+		std::make_shared< spdlog::logger >("factorization_test", std::make_shared< spdlog::sinks::null_sink_mt >()));
+	factorization.process(actual, test::getIndexSpaceManager());
+
+	ASSERT_EQ(actual.size(), 1);
+	ASSERT_EQ(actual[0], expected[0]);
+}
+
+TEST(Factorization, after_term_collection) {
+	std::vector< NamedTensorExprTree > actual = { test::createTree< NamedTensorExprTree >(
+		"R[a+,i-] = H[a+,j-] * T[j+,i-] + -1 * H[a+,k-] * T[k+,i-]") };
+	const std::vector< NamedTensorExprTree > expected = { test::createTree< NamedTensorExprTree >("R[a+,i-] = 0") };
+
+	const std::shared_ptr< spdlog::logger > logger =
+		std::make_shared< spdlog::logger >("factorization_test", std::make_shared< spdlog::sinks::null_sink_mt >());
+
+	// All terms cancel, which leaves a tree consisting of a single literal
+	TermCollection collection;
+	collection.setLogger(logger);
+	collection.process(actual, test::getIndexSpaceManager());
+
+	Factorization factorization;
+	factorization.setLogger(logger);
+	factorization.process(actual, test::getIndexSpaceManager());
+
+	ASSERT_EQ(actual, expected);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+///////////////////////////// TEST SUITE INSTANTIATIONS ////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////
+
+// Note: occupied indices have a size of 16 and virtual ones a size of 256
+INSTANTIATE_TEST_SUITE_P(
+	Factorization, FactorizationTest,
+	::testing::Values(
+		FactorizationTest::Params{ "R[a+,i-] = H[a+,j-] * T[j+,i-] + F[a+,i-]",
+								   "R[a+,i-] = H[a+,j-] * T[j+,i-] + F[a+,i-]" },
+		FactorizationTest::Params{ "R[a+,i-] = A[a+,b-] * B[b+,j-] * C[j+,i-] + A[a+,b-] * B[b+,j-] * D[j+,i-]",
+								   "R[a+,i-] = A[a+,b-] * B[b+,j-] * (C[j+,i-] + D[j+,i-])" },
+		// Common factors are found irrespective of the naming of contracted indices
+		FactorizationTest::Params{ "R[a+,i-] = A[a+,b-] * B[b+,j-] * C[j+,i-] + 2 * A[a+,c-] * B[c+,k-] * D[k+,i-]",
+								   "R[a+,i-] = A[a+,b-] * B[b+,j-] * (C[j+,i-] + 2 * D[j+,i-])" },
+		FactorizationTest::Params{
+			"R[a+,i-] = A[a+,b-] * B[b+,j-] * C[j+,i-] + A[a+,b-] * B[b+,j-] * D[j+,i-] "
+			"+ A[a+,b-] * B[b+,j-] * E[j+,i-]",
+			"R[a+,i-] = A[a+,b-] * B[b+,j-] * (C[j+,i-] + D[j+,i-] + E[j+,i-])" },
+		FactorizationTest::Params{ "R[a+,i-] = A[a+,j-] * C[j+,i-] + B[a+,k-] * C[k+,i-]",
+								   "R[a+,i-] = C[j+,i-] * (A[a+,j-] + B[a+,j-])" },
+		// Terms without any tensor factors
+		FactorizationTest::Params{ "R[a+,i-] = 0", "R[a+,i-] = 0" },
+		FactorizationTest::Params{ "R[] = 2 + H[i+,j+,a-,b-] * T[a+,b+,i-,j-] + H[i+,j+,a-,b-] * T[a+,b+,i-,j-]",
+								   "R[] = 2 + H[i+,j+,a-,b-] * T[a+,b+,i-,j-] + H[i+,j+,a-,b-] * T[a+,b+,i-,j-]" },
+		// Factoring out A would force the evaluation of C * D with a cost that equals the savings
+		FactorizationTest::Params{ "R[i+,j-] = A[i+,a-] * B[a+,j-] + A[i+,a-] * C[a+,k-] * D[k+,j-]",
+								   "R[i+,j-] = A[i+,a-] * B[a+,j-] + A[i+,a-] * C[a+,k-] * D[k+,j-]" }));
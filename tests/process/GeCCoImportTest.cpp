@@ -0,0 +1,302 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#include "GeCCoTreeBuilder.hpp"
+#include "PrettyPrint.hpp"
+#include "Utils.hpp"
+
+#include "lizard/parser/GeCCoContraction.hpp"
+#include "lizard/parser/TensorSymmetrySpecification.hpp"
+#include "lizard/process/GeCCoImport.hpp"
+#include "lizard/process/ImportException.hpp"
+#include "lizard/process/TensorSymmetryRegistry.hpp"
+#include "lizard/symbolic/TensorExpressions.hpp"
+#include "lizard/symbolic/TreeNode.hpp"
+
+#include <gtest/gtest.h>
+
+#include <spdlog/logger.h>
+#include <spdlog/sinks/null_sink.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+using namespace lizard;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////// TEST FIXTURES //////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////
+
+const std::vector< std::string > testSpaceNames = { "occ", "virt" };
+
+/**
+ * Creates the contraction Z[PP,HH] += F[P,P] D[PP,HH] (cmp. CCSD_RES2.EXPORT, contraction #5)
+ */
+auto createDoublesContraction() -> parser::GeCCoContraction {
+	parser::GeCCoContraction contraction;
+	contraction.index         = 5;
+	contraction.result        = parser::GeCCoTensor{ "Z", false, { { "PP", "HH" } } };
+	contraction.vertexCount   = 2;
+	contraction.operatorCount = 2;
+	contraction.superVertex   = { 1, 2 };
+	contraction.arcCount      = 1;
+	contraction.vertices      = {
+		parser::GeCCoTensor{ "F", false, { { "P", "P" } } },
+		parser::GeCCoTensor{ "D", false, { { "PP", "HH" } } },
+	};
+
+	contraction.contractionString.vertices    = { 1, 1, 2, 2, 2, 2 };
+	contraction.contractionString.types       = { 1, 2, 1, 1, 2, 2 };
+	contraction.contractionString.spaces      = { 2, 2, 2, 2, 1, 1 };
+	contraction.contractionString.resultFlags = { true, false, true, false, true, true };
+	contraction.contractionString.arcs        = { 1, 1, 1, 1, 1, 1 };
+	contraction.contractionString.ids         = { 2, 3, 1, 3, 2, 1 };
+
+	contraction.resultString.vertices = { 1, 1, 1, 1 };
+	contraction.resultString.types    = { 1, 1, 2, 2 };
+	contraction.resultString.spaces   = { 2, 2, 1, 1 };
+	contraction.resultString.arcs     = { 1, 1, 1, 1 };
+	contraction.resultString.ids      = { 1, 2, 2, 1 };
+
+	return contraction;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////// TEST CASES ////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(GeCCoImport, single_contraction) {
+	GeCCoTreeBuilder builder(test::getIndexSpaceManager(), testSpaceNames);
+	builder.add(createDoublesContraction());
+
+	const std::vector< NamedTensorExprTree > trees = builder.release();
+
+	ASSERT_EQ(trees.size(), 1);
+	ASSERT_EQ(trees[0],
+			  test::createTree< NamedTensorExprTree >("Z[a+,b+,i-,j-](||||) = F[b+,c-](||) * D[a+,c+,i-,j-](||||)"));
+}
+
+TEST(GeCCoImport, group_by_result) {
+	GeCCoTreeBuilder builder(test::getIndexSpaceManager(), testSpaceNames);
+
+	parser::GeCCoContraction contraction = createDoublesContraction();
+	builder.add(contraction);
+
+	// Same contraction but with differently numbered external indices and a prefactor
+	contraction.externalFactor        = 2;
+	contraction.contractionString.ids = { 1, 3, 2, 3, 1, 2 };
+	contraction.resultString.ids      = { 2, 1, 1, 2 };
+	builder.add(contraction);
+
+	parser::GeCCoContraction other = createDoublesContraction();
+	other.result.name = "Y";
+	builder.add(other);
+
+	const std::vector< NamedTensorExprTree > trees = builder.release();
+
+	ASSERT_EQ(builder.getContractionCount(), 3);
+	ASSERT_EQ(trees.size(), 2);
+	// The parser used for creating trees is right-associative, so we have to assemble the (left-associative) sum
+	// manually
+	NamedTensorExprTree expected =
+		test::createTree< NamedTensorExprTree >("Z[a+,b+,i-,j-](||||) = F[b+,c-](||) * D[a+,c+,i-,j-](||||)");
+	expected.add(TreeNode(2));
+	expected.add(test::createTensorElement("F[b+,c-](||)"));
+	expected.add(test::createTensorElement("D[a+,c+,i-,j-](||||)"));
+	expected.add(TreeNode(ExpressionOperator::Times));
+	expected.add(TreeNode(ExpressionOperator::Times));
+	expected.add(TreeNode(ExpressionOperator::Plus));
+
+	ASSERT_EQ(trees[0], expected);
+	ASSERT_EQ(trees[1],
+			  test::createTree< NamedTensorExprTree >("Y[a+,b+,i-,j-](||||) = F[b+,c-](||) * D[a+,c+,i-,j-](||||)"));
+}
+
+TEST(GeCCoImport, super_vertex) {
+	// G is split across vertices 1 and 4 (cmp. icMRCC_ENERGY.EXPORT, contraction #5)
+	parser::GeCCoContraction contraction;
+	contraction.result        = parser::GeCCoTensor{ "E", false, { { "", "" } } };
+	contraction.vertexCount   = 4;
+	contraction.operatorCount = 3;
+	contraction.superVertex   = { 1, 2, 3, 1 };
+	contraction.vertices      = {
+		parser::GeCCoTensor{ "G", false, { { "", "V" } } },
+		parser::GeCCoTensor{ "W", false, { { "HV", "VV" } } },
+		parser::GeCCoTensor{ "B", false, { { "V", "H" } } },
+		parser::GeCCoTensor{ "G", false, { { "V", "" } } },
+	};
+
+	contraction.contractionString.vertices    = { 1, 2, 2, 2, 2, 3, 3, 4 };
+	contraction.contractionString.types       = { 2, 1, 1, 2, 2, 1, 2, 1 };
+	contraction.contractionString.spaces      = { 2, 1, 2, 2, 2, 2, 1, 2 };
+	contraction.contractionString.resultFlags = std::vector< bool >(8, false);
+	contraction.contractionString.arcs        = { 1, 2, 1, 3, 2, 2, 2, 3 };
+	contraction.contractionString.ids         = { 1, 1, 1, 3, 2, 2, 1, 3 };
+
+	GeCCoTreeBuilder builder(test::getIndexSpaceManager(), testSpaceNames);
+	builder.add(contraction);
+
+	const std::vector< NamedTensorExprTree > trees = builder.release();
+
+	ASSERT_EQ(trees.size(), 1);
+	ASSERT_EQ(trees[0], test::createTree< NamedTensorExprTree >(
+							"E[] = G[b+,a-](||) * W[i+,a+,b-,c-](||||) * B[c+,i-](||)"));
+}
+
+TEST(GeCCoImport, symmetries) {
+	parser::TensorSymmetrySpecification specification;
+	for (const char *currentName : { "R", "T" }) {
+		specification.symmetries.push_back(
+			parser::TensorSymmetryDefinition{ currentName, { "virt", "virt" }, { "occ", "occ" }, { { 1, 2 } }, -1 });
+		specification.symmetries.push_back(
+			parser::TensorSymmetryDefinition{ currentName, { "virt", "virt" }, { "occ", "occ" }, { { 3, 4 } }, -1 });
+	}
+
+	const TensorSymmetryRegistry registry(specification, test::getIndexSpaceManager());
+
+	// The creators of T appear in non-canonical order, which has to be compensated for by the prefactor
+	parser::GeCCoContraction contraction = createDoublesContraction();
+	contraction.result.name                   = "R";
+	contraction.vertices[1].name              = "T";
+	contraction.contractionString.ids         = { 2, 3, 3, 1, 2, 1 };
+	contraction.contractionString.resultFlags = { true, false, false, true, true, true };
+
+	GeCCoTreeBuilder builder(test::getIndexSpaceManager(), testSpaceNames, &registry);
+	builder.add(contraction);
+
+	const std::vector< NamedTensorExprTree > trees = builder.release();
+
+	ASSERT_EQ(trees.size(), 1);
+	ASSERT_EQ(trees[0], test::createTree< NamedTensorExprTree >(
+							"R[a+,b+,i-,j-](||||) = -1 * F[b+,c-](||) * T[a+,c+,i-,j-](||||)"));
+}
+
+TEST(GeCCoImport, errors) {
+	GeCCoTreeBuilder builder(test::getIndexSpaceManager(), { "occ" });
+
+	// Space 2 (particle) is not configured
+	ASSERT_THROW(builder.add(createDoublesContraction()), ImportException);
+
+	GeCCoTreeBuilder otherBuilder(test::getIndexSpaceManager(), { "occ", "nonexistent" });
+	ASSERT_THROW(otherBuilder.add(createDoublesContraction()), ImportException);
+
+	parser::GeCCoContraction contraction = createDoublesContraction();
+	contraction.contractionString.ids.pop_back();
+	GeCCoTreeBuilder validBuilder(test::getIndexSpaceManager(), testSpaceNames);
+	ASSERT_THROW(validBuilder.add(contraction), ImportException);
+}
+
+TEST(GeCCoImport, merge) {
+	parser::GeCCoContraction contraction = createDoublesContraction();
+	parser::GeCCoContraction other       = createDoublesContraction();
+	other.result.name                    = "Y";
+
+	GeCCoTreeBuilder first(test::getIndexSpaceManager(), testSpaceNames);
+	first.add(contraction);
+
+	GeCCoTreeBuilder second(test::getIndexSpaceManager(), testSpaceNames);
+	second.add(other);
+	second.add(contraction);
+	second.add(contraction);
+
+	first.merge(std::move(second));
+
+	const std::vector< NamedTensorExprTree > trees = first.release();
+
+	ASSERT_EQ(first.getContractionCount(), 4);
+	ASSERT_EQ(trees.size(), 2);
+	ASSERT_EQ(trees[0].getResult().getBlock().getTensor().getName(), "Z");
+	ASSERT_EQ(trees[1], test::createTree< NamedTensorExprTree >(
+							"Y[a+,b+,i-,j-](||||) = F[b+,c-](||) * D[a+,c+,i-,j-](||||)"));
+
+	// Z = t1 + (t2 + t3)
+	ASSERT_EQ(trees[0].size(), 3 * 3 + 2);
+	ASSERT_EQ(trees[0].getRoot().getOperator(), ExpressionOperator::Plus);
+	ASSERT_EQ(trees[0].getRoot().getRightArg().getOperator(), ExpressionOperator::Plus);
+}
+
+TEST(GeCCoImport, import_file) {
+	GeCCoImport importer(std::filesystem::path(TEST_FILE_DIR) / "parser_input" / "GeCCoExport" / "valid"
+							 / "CCSD_RES2.EXPORT",
+						 testSpaceNames);
+	importer.setLogger(std::make_shared< spdlog::logger >("gecco_import_test",
+														   std::make_shared< spdlog::sinks::null_sink_mt >()));
+
+	const std::vector< NamedTensorExprTree > trees = importer.importExpressions(test::getIndexSpaceManager());
+
+	ASSERT_EQ(trees.size(), 1);
+	ASSERT_EQ(trees[0].getResult().getBlock().getTensor().getName(), "O2");
+	ASSERT_EQ(trees[0].getResult().getIndices().size(), 4);
+}
+
+TEST(GeCCoImport, parallel_import) {
+	// This file contains more than one chunk of contractions and multiple results (different blocks of O2g)
+	const std::filesystem::path path =
+		std::filesystem::path(TEST_FILE_DIR) / "parser_input" / "GeCCoExport" / "valid" / "icMRCC_RES2.EXPORT";
+	auto logger =
+		std::make_shared< spdlog::logger >("gecco_import_test", std::make_shared< spdlog::sinks::null_sink_mt >());
+
+	GeCCoImport sequentialImporter(path, { "occ", "virt", "ext" }, 1);
+	sequentialImporter.setLogger(logger);
+	GeCCoImport parallelImporter(path, { "occ", "virt", "ext" }, 4);
+	parallelImporter.setLogger(logger);
+
+	const std::vector< NamedTensorExprTree > trees = sequentialImporter.importExpressions(test::getIndexSpaceManager());
+
+	ASSERT_EQ(trees.size(), 7);
+	// The result must not depend on the number of threads used for parsing
+	ASSERT_EQ(parallelImporter.importExpressions(test::getIndexSpaceManager()), trees);
+
+	GeCCoImport fastImporter(path, { "occ", "virt", "ext" }, 4, parser::GeCCoExportParser::Backend::Fast);
+	fastImporter.setLogger(logger);
+	ASSERT_EQ(fastImporter.importExpressions(test::getIndexSpaceManager()), trees);
+}
+
+TEST(GeCCoImport, import_invalid_file) {
+	GeCCoImport importer(std::filesystem::path(TEST_FILE_DIR) / "parser_input" / "GeCCoExport" / "invalid"
+							 / "icMRCC_ENERGY.EXPORT",
+						 testSpaceNames);
+	importer.setLogger(std::make_shared< spdlog::logger >("gecco_import_test",
+														   std::make_shared< spdlog::sinks::null_sink_mt >()));
+
+	ASSERT_THROW((void) importer.importExpressions(test::getIndexSpaceManager()), ImportException);
+}
+
+TEST(GeCCoImport, parameters_depend_on_content) {
+	const std::filesystem::path original = std::filesystem::temp_directory_path() / "lizard_gecco_import_test.EXPORT";
+	const std::filesystem::path copy     = std::filesystem::temp_directory_path() / "lizard_gecco_import_copy.EXPORT";
+
+	const auto writeFile = [](const std::filesystem::path &path, const std::string &content) {
+		std::ofstream stream(path, std::ios::trunc);
+		stream << content;
+	};
+
+	writeFile(original, "first");
+	writeFile(copy, "first");
+
+	const std::string parameters = GeCCoImport(original, testSpaceNames).getParameters();
+
+	// Neither the location nor the modification time of the file matter
+	ASSERT_EQ(GeCCoImport(copy, testSpaceNames).getParameters(), parameters);
+
+	std::filesystem::last_write_time(original, std::filesystem::last_write_time(original) + std::chrono::hours(1));
+	ASSERT_EQ(GeCCoImport(original, testSpaceNames).getParameters(), parameters);
+
+	// Changing the contents invalidates cached imports, even if the modification time stays the same
+	const std::filesystem::file_time_type modificationTime = std::filesystem::last_write_time(original);
+	writeFile(original, "other");
+	std::filesystem::last_write_time(original, modificationTime);
+	ASSERT_NE(GeCCoImport(original, testSpaceNames).getParameters(), parameters);
+
+	std::filesystem::remove(original);
+	std::filesystem::remove(copy);
+}
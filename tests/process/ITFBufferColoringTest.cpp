@@ -0,0 +1,74 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#include "Utils.hpp"
+#include "itf/BufferColoring.hpp"
+#include "itf/Liveness.hpp"
+#include "itf/Translator.hpp"
+
+#include "lizard/symbolic/TensorExpressions.hpp"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+
+using namespace lizard;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////// TEST CASES ////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(ITFBufferColoring, disjoint_lifetimes) {
+	std::vector< std::unique_ptr< itf::Operation > > operations =
+		itf::translate(test::createTree< NamedTensorExprTree >(
+			"R[i+,j-] = A[i+,a-] * B[a+,k-] * C[k+,j-] + D[i+,a-] * E[a+,k-] * F[k+,j-]"));
+
+	const itf::ColoringResult result = itf::colorIntermediates(operations);
+
+	ASSERT_EQ(result.intermediates, 2);
+	ASSERT_EQ(result.buffers, 1);
+
+	itf::insertLifetimeOperations(operations);
+
+	std::vector< std::string > code;
+	for (const std::unique_ptr< itf::Operation > &currentOperation : operations) {
+		code.push_back(currentOperation->stringify(test::getIndexSpaceManager()));
+	}
+
+	// The shared buffer has to be dropped and allocated again in between, such that its contents are reset
+	ASSERT_EQ(code.size(), 8);
+	ASSERT_EQ(code[0].rfind("alloc STIN_", 0), 0);
+	ASSERT_EQ(code[3].rfind("drop STIN_", 0), 0);
+	ASSERT_EQ(code[4].rfind("alloc STIN_", 0), 0);
+	ASSERT_EQ(code[7].rfind("drop STIN_", 0), 0);
+	ASSERT_EQ(code[0], code[4]);
+	ASSERT_EQ(code[3], code[7]);
+	ASSERT_EQ(code[1].substr(0, code[1].find(' ')), code[5].substr(0, code[5].find(' ')));
+}
+
+TEST(ITFBufferColoring, different_shapes) {
+	std::vector< std::unique_ptr< itf::Operation > > operations =
+		itf::translate(test::createTree< NamedTensorExprTree >(
+			"R[i+,j-] = A[i+,a-] * B[a+,k-] * C[k+,j-] + D[i+,k-] * E[k+,a-] * F[a+,j-]"));
+
+	const itf::ColoringResult result = itf::colorIntermediates(operations);
+
+	ASSERT_EQ(result.intermediates, 2);
+	ASSERT_EQ(result.buffers, 2);
+}
+
+TEST(ITFBufferColoring, overlapping_lifetimes) {
+	std::vector< std::unique_ptr< itf::Operation > > operations = itf::translate(
+		test::createTree< NamedTensorExprTree >("R[i+,j-] = (A[i+,a-] * B[a+,j-]) * (C[j+,b-] * D[b+,j-])"));
+
+	const itf::ColoringResult result = itf::colorIntermediates(operations);
+
+	ASSERT_EQ(result.intermediates, 2);
+	ASSERT_EQ(result.buffers, 2);
+}
@@ -0,0 +1,104 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#include "Utils.hpp"
+#include "itf/Contract.hpp"
+#include "itf/ContractionFusion.hpp"
+#include "itf/Translator.hpp"
+
+#include "lizard/symbolic/TensorExpressions.hpp"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+
+using namespace lizard;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////// TEST FIXTURES //////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////
+
+auto toCode(const std::vector< std::unique_ptr< itf::Operation > > &operations) -> std::vector< std::string > {
+	std::vector< std::string > code;
+	for (const std::unique_ptr< itf::Operation > &currentOperation : operations) {
+		code.push_back(currentOperation->stringify(test::getIndexSpaceManager()));
+	}
+
+	return code;
+}
+
+auto fuse(const std::string &treeSpec, std::size_t expectedFusions) -> std::vector< std::string > {
+	std::vector< std::unique_ptr< itf::Operation > > operations =
+		itf::translate(test::createTree< NamedTensorExprTree >(treeSpec));
+
+	EXPECT_EQ(itf::fuseContractions(operations), expectedFusions);
+
+	return toCode(operations);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////// TEST CASES ////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(ITFContractionFusion, shared_lhs) {
+	const std::vector< std::string > code =
+		fuse("R[i+,j-] = A[i+,a-] * B[a+,j-] + A[i+,a-] * C[a+,j-] + 2 * A[i+,a-] * D[a+,j-]", 2);
+
+	ASSERT_EQ(code, std::vector< std::string >{ ".R:oo[ij] += A:ov[ia] (B:vo[aj] + C:vo[aj] + 2*D:vo[aj])" });
+}
+
+TEST(ITFContractionFusion, shared_rhs) {
+	const std::vector< std::string > code = fuse("R[i+,j-] = A[i+,a-] * B[a+,j-] + C[i+,a-] * B[a+,j-]", 1);
+
+	ASSERT_EQ(code, std::vector< std::string >{ ".R:oo[ij] += B:vo[aj] (A:ov[ia] + C:ov[ia])" });
+}
+
+TEST(ITFContractionFusion, different_indices) {
+	// The other operands don't carry the same indices and therefore can't be summed up
+	const std::vector< std::string > code = fuse("R[i+,j-] = A[i+,a-] * B[a+,j-] + A[i+,b-] * C[b+,j-]", 0);
+
+	ASSERT_EQ(code.size(), 2);
+}
+
+TEST(ITFContractionFusion, dependencies) {
+	const TensorElement a = test::createTensorElement("A[i+,a-]");
+	const TensorElement b = test::createTensorElement("B[a+,j-]");
+	const TensorElement c = test::createTensorElement("C[a+,j-]");
+	const TensorElement x = test::createTensorElement("X[i+,j-]");
+	const TensorElement y = test::createTensorElement("Y[i+,j-]");
+	const TensorElement one(Tensor("One"));
+
+	std::vector< std::unique_ptr< itf::Operation > > operations;
+	operations.push_back(std::make_unique< itf::Contract >(x, a, b));
+	// Reads X in between -> X += A C can't be moved before this
+	operations.push_back(std::make_unique< itf::Contract >(y, x, one));
+	operations.push_back(std::make_unique< itf::Contract >(x, a, c));
+
+	ASSERT_EQ(itf::fuseContractions(operations), 0);
+	ASSERT_EQ(operations.size(), 3);
+
+	operations.clear();
+	operations.push_back(std::make_unique< itf::Contract >(x, a, b));
+	// Overwrites B in between -> X += A B can't be moved after this
+	operations.push_back(std::make_unique< itf::Contract >(b, c, one));
+	operations.push_back(std::make_unique< itf::Contract >(x, a, c));
+
+	ASSERT_EQ(itf::fuseContractions(operations), 0);
+	ASSERT_EQ(operations.size(), 3);
+
+	operations.clear();
+	operations.push_back(std::make_unique< itf::Contract >(x, a, b));
+	operations.push_back(std::make_unique< itf::Contract >(y, a, b));
+	operations.push_back(std::make_unique< itf::Contract >(x, a, c));
+
+	ASSERT_EQ(itf::fuseContractions(operations), 1);
+	ASSERT_EQ(toCode(operations), (std::vector< std::string >{ ".Y:oo[ij] += A:ov[ia] B:vo[aj]",
+																   ".X:oo[ij] += A:ov[ia] (B:vo[aj] + C:vo[aj])" }));
+}
@@ -0,0 +1,194 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#include "GeCCoTreeBuilder.hpp"
+#include "Utils.hpp"
+
+#include "lizard/parser/GeCCoContraction.hpp"
+#include "lizard/process/BinaryExport.hpp"
+#include "lizard/process/ITFExport.hpp"
+#include "lizard/process/MappedTensorExprTree.hpp"
+#include "lizard/symbolic/TensorExpressions.hpp"
+
+#include <gtest/gtest.h>
+
+#include <spdlog/logger.h>
+#include <spdlog/sinks/null_sink.h>
+
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+using namespace lizard;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////// TEST FIXTURES //////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////
+
+auto createExpressions() -> std::vector< NamedTensorExprTree > {
+	std::vector< NamedTensorExprTree > expressions;
+	for (int i = 0; i < 20; ++i) {
+		expressions.push_back(test::createTree< NamedTensorExprTree >(
+			"R" + std::to_string(i) + "[i+,j-] = A[i+,a-] * B[a+,k-] * C[k+,j-] + D[i+,k-] * C[k+,j-]"));
+	}
+
+	return expressions;
+}
+
+/**
+ * Creates the contraction Z[P,H] += F^+[P,P] D[P,H], in which F enters transposed
+ */
+auto createTransposedContraction() -> parser::GeCCoContraction {
+	parser::GeCCoContraction contraction;
+	contraction.index         = 1;
+	contraction.result        = parser::GeCCoTensor{ "Z", false, { { "P", "H" } } };
+	contraction.vertexCount   = 2;
+	contraction.operatorCount = 2;
+	contraction.superVertex   = { 1, 2 };
+	contraction.arcCount      = 1;
+	contraction.vertices      = {
+		parser::GeCCoTensor{ "F", true, { { "P", "P" } } },
+		parser::GeCCoTensor{ "D", false, { { "P", "H" } } },
+	};
+
+	contraction.contractionString.vertices    = { 1, 1, 2, 2 };
+	contraction.contractionString.types       = { 1, 2, 1, 2 };
+	contraction.contractionString.spaces      = { 2, 2, 2, 1 };
+	contraction.contractionString.resultFlags = { true, false, false, true };
+	contraction.contractionString.arcs        = { 1, 1, 1, 1 };
+	contraction.contractionString.ids         = { 1, 2, 2, 1 };
+
+	contraction.resultString.vertices = { 1, 1 };
+	contraction.resultString.types    = { 1, 2 };
+	contraction.resultString.spaces   = { 2, 1 };
+	contraction.resultString.arcs     = { 1, 1 };
+	contraction.resultString.ids      = { 1, 1 };
+
+	return contraction;
+}
+
+auto exportToString(ITFExport &exporter, const std::vector< NamedTensorExprTree > &expressions) -> std::string {
+	exporter.setLogger(
+		std::make_shared< spdlog::logger >("itf_test", std::make_shared< spdlog::sinks::null_sink_mt >()));
+
+	std::ostringstream stream;
+	exporter.write(expressions, test::getIndexSpaceManager(), stream);
+
+	return stream.str();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////// TEST CASES ////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(ITFExport, parallel_output_matches_sequential) {
+	const std::vector< NamedTensorExprTree > expressions = createExpressions();
+
+	ITFExport sequential("unused.itf", 1);
+	ITFExport parallel("unused.itf", 4);
+
+	const std::string expected = exportToString(sequential, expressions);
+
+	ASSERT_EQ(parallel.getThreadCount(), 4);
+	ASSERT_EQ(exportToString(parallel, expressions), expected);
+
+	// Code blocks have to appear in the order of the input expressions
+	std::size_t position = 0;
+	for (int i = 0; i < 20; ++i) {
+		const std::size_t blockStart = expected.find("----code(\"R" + std::to_string(i) + "\")\n");
+		ASSERT_NE(blockStart, std::string::npos);
+		ASSERT_GE(blockStart, position);
+		position = blockStart;
+	}
+}
+
+TEST(ITFExport, unique_intermediates) {
+	const std::vector< NamedTensorExprTree > expressions = createExpressions();
+
+	ITFExport exporter("unused.itf", 3);
+	const std::string output = exportToString(exporter, expressions);
+
+	// Intermediates of different code blocks must not share a name
+	const std::size_t firstBlock = output.find("STIN_000001");
+	ASSERT_NE(firstBlock, std::string::npos);
+	ASSERT_LT(output.find("----code(\"R0\")"), firstBlock);
+	ASSERT_LT(firstBlock, output.find("----code(\"R1\")"));
+	ASSERT_EQ(output.find("STIN_000001", output.find("----code(\"R1\")")), std::string::npos);
+}
+
+TEST(ITFExport, write_to_file) {
+	const std::filesystem::path path = std::filesystem::temp_directory_path() / "lizard_itf_export_test.itf";
+	const std::vector< NamedTensorExprTree > expressions = createExpressions();
+
+	ITFExport exporter(path, 2);
+	const std::string expected = exportToString(exporter, expressions);
+
+	exporter.exportExpressions(expressions, test::getIndexSpaceManager());
+
+	std::ifstream stream(path);
+	std::stringstream content;
+	content << stream.rdbuf();
+
+	ASSERT_EQ(content.str(), expected);
+
+	std::filesystem::remove(path);
+}
+
+TEST(ITFExport, mapped_trees) {
+	const std::filesystem::path path = std::filesystem::temp_directory_path() / "lizard_itf_export_test.lzb";
+	const std::vector< NamedTensorExprTree > expressions = createExpressions();
+
+	{
+		std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+		BinaryExport::write(expressions, test::getIndexSpaceManager(), stream);
+	}
+
+	std::vector< MappedTensorExprTree > mapped;
+	for (std::size_t i = 0; i < expressions.size(); ++i) {
+		mapped.emplace_back(path, test::getIndexSpaceManager(), i);
+	}
+
+	ITFExport exporter("unused.itf", 3);
+	const std::string expected = exportToString(exporter, expressions);
+
+	// Translating the mapped trees directly yields the same code as translating the materialized ones
+	std::ostringstream stream;
+	exporter.write(mapped, test::getIndexSpaceManager(), stream);
+
+	ASSERT_EQ(stream.str(), expected);
+
+	mapped.clear();
+	std::filesystem::remove(path);
+}
+
+TEST(ITFExport, transposed_operator) {
+	GeCCoTreeBuilder builder(test::getIndexSpaceManager(), { "occ", "virt" });
+	builder.add(createTransposedContraction());
+
+	const std::vector< NamedTensorExprTree > expressions = builder.release();
+	ASSERT_EQ(expressions.size(), 1);
+
+	ITFExport exporter("unused.itf", 1);
+	const std::string output = exportToString(exporter, expressions);
+
+	// The transposed operator is a tensor of its own, whose name has to be a valid ITF identifier
+	const std::size_t position = output.find("FT:vv[");
+	ASSERT_NE(position, std::string::npos) << output;
+	ASSERT_EQ(output.find("F:vv["), std::string::npos) << output;
+
+	const std::size_t nameStart = output.rfind(' ', position) + 1;
+	ASSERT_TRUE(std::all_of(output.begin() + static_cast< std::ptrdiff_t >(nameStart),
+							output.begin() + static_cast< std::ptrdiff_t >(position + 2),
+							[](char c) { return std::isalnum(static_cast< unsigned char >(c)) != 0; }))
+		<< output;
+}
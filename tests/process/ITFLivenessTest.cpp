@@ -0,0 +1,85 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#include "Utils.hpp"
+#include "itf/Liveness.hpp"
+#include "itf/Translator.hpp"
+
+#include "lizard/symbolic/TensorExpressions.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+using namespace lizard;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////// TEST FIXTURES //////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @returns The ITF code for the given expression, with the names of all intermediates replaced by their order of
+ * appearance (X1, X2, ...) as these names are not deterministic
+ */
+auto translateWithLifetimes(const std::string &treeSpec) -> std::vector< std::string > {
+	std::vector< std::unique_ptr< itf::Operation > > operations =
+		itf::translate(test::createTree< NamedTensorExprTree >(treeSpec));
+
+	itf::insertLifetimeOperations(operations);
+
+	std::vector< std::string > intermediates;
+	std::vector< std::string > code;
+	for (const std::unique_ptr< itf::Operation > &currentOperation : operations) {
+		std::string line = currentOperation->stringify(test::getIndexSpaceManager());
+
+		std::size_t position = 0;
+		while ((position = line.find(itf::IntermediatePrefix, position)) != std::string::npos) {
+			const std::size_t end   = line.find(':', position);
+			const std::string name  = line.substr(position, end - position);
+			auto iter               = std::find(intermediates.begin(), intermediates.end(), name);
+			const std::size_t index = static_cast< std::size_t >(iter - intermediates.begin()) + 1;
+			if (iter == intermediates.end()) {
+				intermediates.push_back(name);
+			}
+
+			line.replace(position, name.size(), "X" + std::to_string(index));
+		}
+
+		code.push_back(std::move(line));
+	}
+
+	return code;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////// TEST CASES ////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(ITFLiveness, no_intermediates) {
+	const std::vector< std::string > code = translateWithLifetimes("R[a+,i-] = H[a+,j-] * T[j+,i-]");
+
+	ASSERT_EQ(code.size(), 1);
+}
+
+TEST(ITFLiveness, intermediates) {
+	const std::vector< std::string > code =
+		translateWithLifetimes("R[i+,j-] = A[i+,a-] * B[a+,k-] * C[k+,j-] + D[i+,a-] * E[a+,k-] * F[k+,j-]");
+
+	ASSERT_EQ(code.size(), 8);
+	ASSERT_EQ(code[0].rfind("alloc X1:", 0), 0);
+	ASSERT_EQ(code[1].rfind(".X1:", 0), 0);
+	ASSERT_EQ(code[2].rfind(".R:", 0), 0);
+	ASSERT_EQ(code[3].rfind("drop X1:", 0), 0);
+	ASSERT_EQ(code[4].rfind("alloc X2:", 0), 0);
+	ASSERT_EQ(code[5].rfind(".X2:", 0), 0);
+	ASSERT_EQ(code[6].rfind(".R:", 0), 0);
+	ASSERT_EQ(code[7].rfind("drop X2:", 0), 0);
+}
@@ -0,0 +1,56 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#include "Utils.hpp"
+#include "itf/Scheduler.hpp"
+#include "itf/Translator.hpp"
+
+#include "lizard/symbolic/TensorExpressions.hpp"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+
+using namespace lizard;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////// TEST CASES ////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////
+
+// Note: occupied indices have a size of 16 and virtual ones a size of 256
+
+TEST(ITFScheduler, keeps_optimal_order) {
+	std::vector< std::unique_ptr< itf::Operation > > operations = itf::translate(
+		test::createTree< NamedTensorExprTree >("R[i+,j-] = A[i+,a-] * B[a+,k-] * C[k+,j-] + D[i+,j-] * E[j+,k-]"));
+
+	const itf::Operation *first = operations.front().get();
+
+	const itf::PeakMemoryEstimate estimate = itf::scheduleOperations(operations, test::getIndexSpaceManager());
+
+	ASSERT_EQ(estimate.before, 256 * 16);
+	ASSERT_EQ(estimate.after, estimate.before);
+	ASSERT_EQ(operations.front().get(), first);
+}
+
+TEST(ITFScheduler, reduces_peak_memory) {
+	// Evaluating the product in the order given by the tree, keeps the large A * B intermediate alive while the other
+	// (small) intermediates are computed
+	std::vector< std::unique_ptr< itf::Operation > > operations =
+		itf::translate(test::createTree< NamedTensorExprTree >(
+			"R[a+,c-] = (A[a+,b-] * B[b+,c-]) * ((C[i+,j-] * D[j+,k-]) * (E[k+,l-] * F[l+,i-]))"));
+
+	ASSERT_EQ(operations.size(), 5);
+	ASSERT_EQ(itf::estimatePeakMemory(operations, test::getIndexSpaceManager()), 256 * 256 + 2 * 16 * 16 + 1);
+
+	const itf::PeakMemoryEstimate estimate = itf::scheduleOperations(operations, test::getIndexSpaceManager());
+
+	ASSERT_EQ(estimate.before, 256 * 256 + 2 * 16 * 16 + 1);
+	ASSERT_EQ(estimate.after, 256 * 256 + 1);
+	ASSERT_EQ(operations.size(), 5);
+	ASSERT_EQ(itf::estimatePeakMemory(operations, test::getIndexSpaceManager()), estimate.after);
+}
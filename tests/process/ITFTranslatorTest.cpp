@@ -0,0 +1,116 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#include "Utils.hpp"
+#include "itf/Translator.hpp"
+
+#include "lizard/process/ProcessingException.hpp"
+#include "lizard/symbolic/TensorExpressions.hpp"
+
+#include <gtest/gtest.h>
+
+#include <fmt/format.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+
+using namespace lizard;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////// TEST FIXTURES //////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////
+
+auto stringify(const std::vector< std::unique_ptr< itf::Operation > > &operations) -> std::vector< std::string > {
+	std::vector< std::string > code;
+	for (const std::unique_ptr< itf::Operation > &currentOperation : operations) {
+		code.push_back(currentOperation->stringify(test::getIndexSpaceManager()));
+	}
+
+	return code;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////// TEST CASES ////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(ITFTranslator, reproducible_names) {
+	const NamedTensorExprTree tree =
+		test::createTree< NamedTensorExprTree >("R[i+,j-] = A[i+,a-] * B[a+,k-] * C[k+,j-] + F[i+,j-]");
+
+	const std::vector< std::string > first  = stringify(itf::translate(tree));
+	const std::vector< std::string > second = stringify(itf::translate(tree));
+
+	ASSERT_EQ(first, second);
+	ASSERT_EQ(first.size(), 3);
+	ASSERT_EQ(first[0].rfind(".STIN_000001:", 0), 0);
+	ASSERT_EQ(first[2], ".R:oo[ij] += F:oo[ij] One[]");
+}
+
+TEST(ITFTranslator, shared_context) {
+	const NamedTensorExprTree tree =
+		test::createTree< NamedTensorExprTree >("R[i+,j-] = A[i+,a-] * B[a+,k-] * C[k+,j-]");
+
+	itf::TranslationContext context(5);
+
+	const std::vector< std::string > first  = stringify(itf::translate(tree, context));
+	const std::vector< std::string > second = stringify(itf::translate(tree, context));
+
+	ASSERT_EQ(context.getIntermediateCount(), 2);
+	ASSERT_EQ(first[0].rfind(".STIN_000005:", 0), 0);
+	ASSERT_EQ(second[0].rfind(".STIN_000006:", 0), 0);
+}
+
+TEST(ITFTranslator, format_to_buffer) {
+	const NamedTensorExprTree tree = test::createTree< NamedTensorExprTree >("R[i+,j-] = 2 * A[i+,a-] * B[a+,j-]");
+
+	const std::vector< std::unique_ptr< itf::Operation > > operations = itf::translate(tree);
+	ASSERT_EQ(operations.size(), 1);
+
+	fmt::memory_buffer buffer;
+	operations[0]->formatTo(buffer, test::getIndexSpaceManager());
+	buffer.push_back('\n');
+	operations[0]->formatTo(buffer, test::getIndexSpaceManager());
+
+	const std::string expected = ".R:oo[ij] += 2*A:ov[ia] B:vo[aj]";
+
+	ASSERT_EQ(operations[0]->stringify(test::getIndexSpaceManager()), expected);
+	ASSERT_EQ(fmt::to_string(buffer), expected + "\n" + expected);
+}
+
+TEST(ITFTranslator, linear_combination) {
+	const NamedTensorExprTree tree = test::createTree< NamedTensorExprTree >(
+		"R[i+,j-] = A[i+,j-] + 2 * B[i+,j-] + C[i+,a-] * D[a+,j-] + F[j+,i-]");
+
+	// All terms without a contraction are added to the result in a single operation
+	const std::vector< std::string > expected = {
+		".R:oo[ij] += C:ov[ia] D:vo[aj]",
+		".R:oo[ij] += (A:oo[ij] + 2*B:oo[ij] + F:oo[ji]) One[]",
+	};
+
+	ASSERT_EQ(stringify(itf::translate(tree)), expected);
+}
+
+TEST(ITFTranslator, scalar_constants) {
+	const NamedTensorExprTree tree =
+		test::createTree< NamedTensorExprTree >("E[] = 2 + F[i+,a-] * T[a+,i-] + (S[] + 3) * T[a+,i-] * F[i+,a-]");
+
+	const std::vector< std::string > expected = {
+		".E[] += F:ov[ia] T:vo[ai]",
+		".STIN_000001[] += T:vo[ai] F:ov[ia]",
+		".E[] += (S[] + 3*One[]) STIN_000001[]",
+		".E[] += 2*One[] One[]",
+	};
+
+	ASSERT_EQ(stringify(itf::translate(tree)), expected);
+
+	const NamedTensorExprTree nonScalar =
+		test::createTree< NamedTensorExprTree >("R[i+,j-] = (S[] + 3) * F[i+,j-] + (F[i+,a-] + 1) * T[a+,j-]");
+
+	ASSERT_THROW(static_cast< void >(itf::translate(nonScalar)), ProcessingException);
+}
@@ -0,0 +1,256 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#include "PrettyPrint.hpp"
+#include "Utils.hpp"
+
+#include "lizard/process/BinaryExport.hpp"
+#include "lizard/process/MappedTensorExprTree.hpp"
+#include "lizard/symbolic/ExpressionException.hpp"
+#include "lizard/symbolic/TensorElement.hpp"
+#include "lizard/symbolic/TensorExpressions.hpp"
+#include "lizard/symbolic/TreeNode.hpp"
+#include "lizard/symbolic/TreeTraversal.hpp"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+
+using namespace lizard;
+
+////////////////////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////// TEST FIXTURES //////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////
+
+class MappedTensorExprTreeTest : public ::testing::TestWithParam< TreeTraversal > {
+protected:
+	void SetUp() override {
+		m_path = std::filesystem::temp_directory_path()
+				 / ("lizard_mapped_tree_" + std::to_string(static_cast< int >(GetParam())) + ".lzb");
+
+		const std::vector< NamedTensorExprTree > expressions = { createTree(), NamedTensorExprTree(m_result) };
+
+		std::ofstream stream(m_path, std::ios::binary | std::ios::trunc);
+		BinaryExport::write(expressions, test::getIndexSpaceManager(), stream);
+	}
+
+	void TearDown() override { std::filesystem::remove(m_path); }
+
+	/**
+	 * Creates the tree representing R[ab,ij] = 1/2 H[ab,ij] + (-2) * T[ab,ij] * O[]
+	 */
+	auto createTree() const -> NamedTensorExprTree {
+		NamedTensorExprTree tree(m_result);
+		tree.add(TreeNode(Fraction(1, 2)));
+		tree.add(test::createTensorElement("H[a+,b+,i-,j-](||||)"));
+		tree.add(TreeNode(ExpressionOperator::Times));
+		tree.add(TreeNode(-2));
+		tree.add(test::createTensorElement("T[a+,b+,i-,j-](||||)"));
+		tree.add(TreeNode(ExpressionOperator::Times));
+		tree.add(TensorElement(Tensor("O")));
+		tree.add(TreeNode(ExpressionOperator::Times));
+		tree.add(TreeNode(ExpressionOperator::Plus));
+
+		return tree;
+	}
+
+	TensorElement m_result = test::createTensorElement("R[a+,b+,i-,j-](||||)");
+	std::filesystem::path m_path;
+	NamedTensorExprTree m_tree = createTree();
+};
+
+
+/**
+ * Writes the given data to the given path, opens it as a MappedTensorExprTree and visits all of its nodes and elements
+ *
+ * @returns Whether the data has been rejected as corrupted
+ */
+auto isRejected(const std::filesystem::path &path, const std::string &data) -> bool {
+	{
+		std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+		stream << data;
+	}
+
+	try {
+		const MappedTensorExprTree mapped(path, test::getIndexSpaceManager());
+
+		for (const MappedTensorExpr &current : mapped) {
+			if (current.getType() == ExpressionType::Variable) {
+				(void) current.getVariable();
+			}
+		}
+
+		(void) mapped.materialize();
+	} catch (const ExpressionException &) {
+		return true;
+	}
+
+	return false;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////// TEST CASES ////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////
+
+template< TreeTraversal order >
+void compareIteration(const NamedTensorExprTree &tree, const MappedTensorExprTree &mapped) {
+	auto treeIter   = tree.begin< order >();
+	auto mappedIter = mapped.begin< order >();
+
+	for (; treeIter != tree.end< order >() && mappedIter != mapped.end< order >(); ++treeIter, ++mappedIter) {
+		ASSERT_EQ(treeIter->getType(), mappedIter->getType());
+		ASSERT_EQ(treeIter->isRoot(), mappedIter->isRoot());
+		ASSERT_EQ(treeIter->size(), mappedIter->size());
+
+		switch (treeIter->getType()) {
+			case ExpressionType::Literal:
+				ASSERT_EQ(treeIter->getLiteral(), mappedIter->getLiteral());
+				break;
+			case ExpressionType::Variable:
+				ASSERT_EQ(treeIter->getVariable(), mappedIter->getVariable());
+				break;
+			case ExpressionType::Operator:
+				ASSERT_EQ(treeIter->getOperator(), mappedIter->getOperator());
+				break;
+		}
+	}
+
+	ASSERT_EQ(treeIter, tree.end< order >());
+	ASSERT_EQ(mappedIter, mapped.end< order >());
+}
+
+TEST_P(MappedTensorExprTreeTest, iteration) {
+	const MappedTensorExprTree mapped(m_path, test::getIndexSpaceManager());
+
+	ASSERT_EQ(mapped.getResult(), m_result);
+	ASSERT_EQ(mapped.size(), m_tree.size());
+	ASSERT_EQ(mapped.variableCount(), 3);
+
+	switch (GetParam()) {
+		case TreeTraversal::DepthFirst_PreOrder:
+			compareIteration< TreeTraversal::DepthFirst_PreOrder >(m_tree, mapped);
+			break;
+		case TreeTraversal::DepthFirst_InOrder:
+			compareIteration< TreeTraversal::DepthFirst_InOrder >(m_tree, mapped);
+			break;
+		case TreeTraversal::DepthFirst_PostOrder:
+			compareIteration< TreeTraversal::DepthFirst_PostOrder >(m_tree, mapped);
+			break;
+	}
+}
+
+TEST_P(MappedTensorExprTreeTest, subexpressions) {
+	const MappedTensorExprTree mapped(m_path, test::getIndexSpaceManager());
+
+	MappedTensorExpr root = mapped.getRoot();
+	ASSERT_TRUE(root.isRoot());
+	ASSERT_EQ(root.getOperator(), ExpressionOperator::Plus);
+
+	MappedTensorExpr rhs = root.getRightArg();
+	ASSERT_FALSE(rhs.isRoot());
+	ASSERT_TRUE(rhs.getParent().isSame(root));
+	ASSERT_EQ(rhs.size(), 5);
+	ASSERT_EQ(rhs.getRightArg().getVariable(), TensorElement(Tensor("O")));
+
+	// Iterating a sub-expression must not leave the sub-tree
+	std::size_t visited = 0;
+	for (const MappedTensorExpr &current : rhs) {
+		ASSERT_FALSE(current.getType() == ExpressionType::Operator
+					 && current.getOperator() == ExpressionOperator::Plus);
+		visited++;
+	}
+	ASSERT_EQ(visited, 5);
+}
+
+TEST_P(MappedTensorExprTreeTest, materialize) {
+	const MappedTensorExprTree mapped(m_path, test::getIndexSpaceManager());
+
+	const NamedTensorExprTree materialized = mapped.materialize();
+	ASSERT_EQ(materialized, m_tree);
+	ASSERT_EQ(materialized.getResult(), m_tree.getResult());
+}
+
+TEST_P(MappedTensorExprTreeTest, empty_tree) {
+	const MappedTensorExprTree mapped(m_path, test::getIndexSpaceManager(), 1);
+
+	ASSERT_EQ(mapped.getResult(), m_result);
+	ASSERT_TRUE(mapped.isEmpty());
+	ASSERT_EQ(mapped.size(), 0);
+	ASSERT_EQ(mapped.begin(), mapped.end());
+	ASSERT_TRUE(mapped.materialize().isEmpty());
+
+	ASSERT_THROW(MappedTensorExprTree(m_path, test::getIndexSpaceManager(), 2), ExpressionException);
+}
+
+TEST_P(MappedTensorExprTreeTest, corrupted_file) {
+	std::string data;
+	{
+		std::ifstream stream(m_path, std::ios::binary);
+		data.assign(std::istreambuf_iterator< char >(stream), std::istreambuf_iterator< char >());
+	}
+
+	// Every truncation has to be detected
+	for (std::size_t i = 0; i < data.size(); ++i) {
+		ASSERT_TRUE(isRejected(m_path, data.substr(0, i))) << "Truncated to " << i << " bytes";
+	}
+
+	// Any other corruption has to be detected or must leave a tree that can be navigated safely
+	for (std::size_t i = 0; i < data.size(); ++i) {
+		std::string corrupted = data;
+		corrupted[i]          = static_cast< char >(~corrupted[i]);
+
+		(void) isRejected(m_path, corrupted);
+	}
+
+	// The root is the only node without parent
+	const std::size_t rootParent = data.find(std::string(4, '\xFF'));
+	ASSERT_NE(rootParent, std::string::npos);
+	const std::size_t root = rootParent - 4;
+
+	std::string invalidType = data;
+	invalidType[root]       = 7;
+	ASSERT_TRUE(isRejected(m_path, invalidType));
+
+	std::string invalidOperator = data;
+	invalidOperator[root + 1]   = 7;
+	ASSERT_TRUE(isRejected(m_path, invalidOperator));
+
+	std::string invalidParent = data;
+	invalidParent[rootParent] = 0;
+	ASSERT_TRUE(isRejected(m_path, invalidParent));
+
+	// Make the root its own left child
+	std::string cyclicTree = data;
+	cyclicTree[root + 8]   = static_cast< char >(m_tree.size() - 1);
+	ASSERT_TRUE(isRejected(m_path, cyclicTree));
+
+	std::string invalidChild = data;
+	invalidChild[root + 15]  = 1;
+	ASSERT_TRUE(isRejected(m_path, invalidChild));
+}
+
+TEST(MappedTensorExprTree, invalid_files) {
+	const std::filesystem::path path = std::filesystem::temp_directory_path() / "lizard_mapped_tree_invalid.bin";
+
+	{
+		std::ofstream stream(path, std::ios::binary);
+		stream << "This is not a valid mapped expression tree file, but it is long enough to contain a header";
+	}
+
+	ASSERT_THROW((MappedTensorExprTree{ path, test::getIndexSpaceManager() }), ExpressionException);
+
+	std::filesystem::remove(path);
+}
+
+
+INSTANTIATE_TEST_SUITE_P(MappedTensorExprTree, MappedTensorExprTreeTest,
+						 ::testing::Values(TreeTraversal::DepthFirst_PreOrder, TreeTraversal::DepthFirst_InOrder,
+										   TreeTraversal::DepthFirst_PostOrder));
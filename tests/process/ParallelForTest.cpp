@@ -0,0 +1,64 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#include "ParallelFor.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+using namespace lizard;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////// TEST CASES ////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(ParallelFor, visits_every_position) {
+	std::vector< std::atomic< int > > visits(100);
+
+	const std::size_t threadCount = parallelFor(visits.size(), 4, [&](std::size_t i) { visits[i]++; });
+
+	ASSERT_GE(threadCount, 1);
+	ASSERT_LE(threadCount, 4);
+	for (const std::atomic< int > &current : visits) {
+		ASSERT_EQ(current, 1);
+	}
+
+	// Never more threads than positions
+	ASSERT_EQ(parallelFor(1, 4, [](std::size_t) {}), 1);
+	ASSERT_EQ(parallelFor(0, 4, [](std::size_t) {}), 1);
+}
+
+TEST(ParallelFor, rethrows_first_error) {
+	std::atomic< std::size_t > visited(0);
+
+	try {
+		parallelFor(50, 4, [&](std::size_t i) {
+			visited++;
+
+			if (i == 17 || i == 31) {
+				throw std::runtime_error(std::to_string(i));
+			}
+		});
+
+		FAIL() << "Expected an exception";
+	} catch (const std::runtime_error &error) {
+		ASSERT_EQ(std::string(error.what()), "17");
+	}
+
+	// A failure doesn't stop the remaining positions from being processed
+	ASSERT_EQ(visited, 50);
+}
+
+TEST(ParallelFor, thread_count) {
+	ASSERT_EQ(resolveThreadCount(3), 3);
+	ASSERT_GE(resolveThreadCount(0), 1);
+}
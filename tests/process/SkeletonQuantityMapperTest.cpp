@@ -12,8 +12,17 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <libperm/Cycle.hpp>
+#include <libperm/ExplicitPermutation.hpp>
+#include <libperm/PrimitivePermutationGroup.hpp>
+
+#include <spdlog/logger.h>
+#include <spdlog/sinks/null_sink.h>
+
+#include <memory>
 #include <string>
 #include <tuple>
+#include <utility>
 #include <vector>
 
 
@@ -51,6 +60,45 @@ TEST_P(SkeletonMapperTest, process) {
 	ASSERT_EQ(actual[0], expected[0]);
 }
 
+TEST(SkeletonQuantityMapper, non_fitting_factor_symmetry) {
+	// The skeleton quantity of a (hermitian) one-electron tensor only has the particle symmetry of skeleton quantities,
+	// regardless of the symmetry of the spin-integrated element
+	perm::PrimitivePermutationGroup hermiticity;
+	hermiticity.addGenerator(perm::ExplicitPermutation(perm::Cycle({ 0, 1 })));
+
+	const TensorElement element = std::get< 0 >(TensorElement::create(
+		Tensor("F"), test::createIndexSequence("[i+,j-](//)"), std::move(hermiticity)));
+
+	NamedTensorExprTree input(test::createTensorElement("R[]"));
+	input.add(element);
+
+	std::vector< NamedTensorExprTree > actual = { input };
+
+	SkeletonQuantityMapper mapper;
+	mapper.process(actual, test::getIndexSpaceManager());
+
+	ASSERT_EQ(actual.size(), 1);
+	ASSERT_EQ(actual[0], test::createTree< NamedTensorExprTree >("R[] = F[i+,j-]", true));
+}
+
+TEST(SkeletonQuantityMapper, external_indices) {
+	// Only density-fitting factors are mapped if they contain external indices
+	const std::vector< NamedTensorExprTree > input = {
+		test::createTree< NamedTensorExprTree >(R"(R[] = A[P,i+,j+,a-,b-](./\/\) * B[P,a+,i-](.//))")
+	};
+	std::vector< NamedTensorExprTree > actual = input;
+
+	SkeletonQuantityMapper mapper;
+	mapper.setLogger(std::make_shared< spdlog::logger >("skeleton_mapper_test",
+														std::make_shared< spdlog::sinks::null_sink_mt >()));
+	mapper.process(actual, test::getIndexSpaceManager());
+
+	ASSERT_EQ(actual.size(), 1);
+	ASSERT_EQ(actual[0].getRoot().getLeftArg().getVariable(), input[0].getRoot().getLeftArg().getVariable());
+	ASSERT_EQ(actual[0].getRoot().getRightArg().getVariable(),
+			  test::createTensorElement("B[P,a+,i-]", nullptr, true));
+}
+
 
 ////////////////////////////////////////////////////////////////////////////////////////////
 ///////////////////////////// TEST SUITE INSTANTIATIONS ////////////////////////////////////
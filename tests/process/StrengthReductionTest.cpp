@@ -0,0 +1,81 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#include "PrettyPrint.hpp"
+#include "Utils.hpp"
+
+#include "lizard/process/StrengthReduction.hpp"
+#include "lizard/symbolic/TensorExpressions.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <spdlog/logger.h>
+#include <spdlog/sinks/null_sink.h>
+
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+
+using namespace lizard;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////// TEST FIXTURES //////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////
+
+struct StrengthReductionTest : ::testing::TestWithParam< std::tuple< std::size_t, std::string, std::string > > {
+	using Params = std::tuple< std::size_t, std::string, std::string >;
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////// TEST CASES ////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST_P(StrengthReductionTest, process) {
+	const std::size_t exhaustiveSearchLimit = std::get< 0 >(GetParam());
+	const std::string &inputTreeSpec        = std::get< 1 >(GetParam());
+	const std::string &expectedTreeSpec     = std::get< 2 >(GetParam());
+
+	std::vector< NamedTensorExprTree > actual         = { test::createTree< NamedTensorExprTree >(inputTreeSpec) };
+	const std::vector< NamedTensorExprTree > expected = { test::createTree< NamedTensorExprTree >(expectedTreeSpec) };
+
+	StrengthReduction reduction(exhaustiveSearchLimit);
+	reduction.setLogger(std::make_shared< spdlog::logger >("strength_reduction_test",
+														   std::make_shared< spdlog::sinks::null_sink_mt >()));
+	reduction.process(actual, test::getIndexSpaceManager());
+
+	ASSERT_EQ(actual.size(), 1);
+	ASSERT_EQ(actual[0], expected[0]);
+}
+
+TEST(StrengthReduction, search_limit) {
+	ASSERT_EQ(StrengthReduction(4).getParameters(), "exhaustiveSearchLimit=4");
+	ASSERT_EQ(StrengthReduction(64).getParameters(), "exhaustiveSearchLimit=16");
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+///////////////////////////// TEST SUITE INSTANTIATIONS ////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////
+
+// Note: occupied indices have a size of 16 and virtual ones a size of 256
+INSTANTIATE_TEST_SUITE_P(
+	StrengthReduction, StrengthReductionTest,
+	::testing::Values(
+		StrengthReductionTest::Params{ 8, "R[a+,i-] = H[a+,j-] * T[j+,i-] + F[a+,i-]",
+									   "R[a+,i-] = H[a+,j-] * T[j+,i-] + F[a+,i-]" },
+		// Summing over the virtual index first avoids the creation of an intermediate carrying a virtual index
+		StrengthReductionTest::Params{ 8, "R[i+,j-] = A[i+,a-] * B[a+,k-] * C[k+,j-]",
+									   "R[i+,j-] = (A[i+,a-] * B[a+,k-]) * C[k+,j-]" },
+		StrengthReductionTest::Params{ 8, "R[i+,j-] = (A[i+,k-] * B[k+,a-]) * C[a+,j-]",
+									   "R[i+,j-] = A[i+,k-] * (B[k+,a-] * C[a+,j-])" },
+		StrengthReductionTest::Params{ 8, "R[i+,j-] = 2 * X[i+,a-] * Y[a+,k-] * Z[k+,b-] * W[b+,j-] + F[i+,j-]",
+									   "R[i+,j-] = 2 * ((X[i+,a-] * Y[a+,k-]) * (Z[k+,b-] * W[b+,j-])) + F[i+,j-]" },
+		StrengthReductionTest::Params{ 2, "R[i+,j-] = 2 * X[i+,a-] * Y[a+,k-] * Z[k+,b-] * W[b+,j-] + F[i+,j-]",
+									   "R[i+,j-] = 2 * ((X[i+,a-] * Y[a+,k-]) * (Z[k+,b-] * W[b+,j-])) + F[i+,j-]" }));
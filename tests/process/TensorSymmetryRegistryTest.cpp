@@ -0,0 +1,136 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#include "PrettyPrint.hpp"
+#include "Utils.hpp"
+
+#include "lizard/parser/TensorSymmetrySpecification.hpp"
+#include "lizard/process/ImportException.hpp"
+#include "lizard/process/TensorSymmetryRegistry.hpp"
+#include "lizard/symbolic/TensorElement.hpp"
+
+#include <libperm/Cycle.hpp>
+#include <libperm/ExplicitPermutation.hpp>
+#include <libperm/SpecialGroups.hpp>
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <string>
+#include <tuple>
+#include <vector>
+
+
+using namespace lizard;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////// TEST FIXTURES //////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Creates the specification of an antisymmetric doubles amplitude (X) and of an integral (V) whose slots may belong
+ * to any space, but which is symmetric under the simultaneous exchange of both creators and both annihilators
+ */
+auto createSpecification() -> parser::TensorSymmetrySpecification {
+	parser::TensorSymmetrySpecification specification;
+	specification.indexSpaces = { parser::IndexSpaceDefinition{ "ANY", { "occ", "virt" } } };
+	specification.symmetries  = {
+		parser::TensorSymmetryDefinition{ "X", { "virt", "virt" }, { "occ", "occ" }, { { 1, 2 } }, -1 },
+		parser::TensorSymmetryDefinition{ "X", { "virt", "virt" }, { "occ", "occ" }, { { 3, 4 } }, -1 },
+		parser::TensorSymmetryDefinition{ "V", { "ANY", "ANY" }, { "ANY", "ANY" }, { { 1, 2 }, { 3, 4 } }, 1 },
+	};
+
+	return specification;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////// TEST CASES ////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(TensorSymmetryRegistry, antisymmetric_block) {
+	const TensorSymmetryRegistry registry(createSpecification(), test::getIndexSpaceManager());
+
+	const std::vector< std::string > indexSpecs = { "[a+,b+,i-,j-](||||)", "[b+,a+,i-,j-](||||)",
+													"[a+,b+,j-,i-](||||)", "[b+,a+,j-,i-](||||)" };
+
+	for (const std::string &currentSpec : indexSpecs) {
+		const std::vector< Index > indices = test::createIndexSequence(currentSpec);
+
+		auto [element, sign] = registry.createElement(Tensor("X"), indices);
+		auto [expected, expectedSign] =
+			TensorElement::create(Tensor("X"), indices, perm::antisymmetricRanges({ { 0, 1 }, { 2, 3 } }));
+
+		ASSERT_EQ(element, expected) << currentSpec;
+		ASSERT_EQ(sign, expectedSign) << currentSpec;
+		ASSERT_EQ(element.getBlock().getSlotSymmetry(), expected.getBlock().getSlotSymmetry()) << currentSpec;
+	}
+}
+
+TEST(TensorSymmetryRegistry, expanded_block) {
+	const TensorSymmetryRegistry registry(createSpecification(), test::getIndexSpaceManager());
+
+	// One block for X and 2^4 blocks for V
+	ASSERT_EQ(registry.size(), 17);
+
+	// The slots (virt, occ; occ, virt) are brought into canonical order by exchanging the creators and annihilators
+	const std::vector< Index > indices = test::createIndexSequence("[a+,i+,j-,b-](||||)");
+
+	TensorBlock::SlotSymmetry symmetry;
+	symmetry.addGenerator(perm::ExplicitPermutation(perm::Cycle({ { 0, 1 }, { 2, 3 } })));
+
+	auto [element, sign] = registry.createElement(Tensor("V"), indices);
+	auto [expected, expectedSign] = TensorElement::create(Tensor("V"), indices, symmetry);
+
+	ASSERT_EQ(element, expected);
+	ASSERT_EQ(sign, expectedSign);
+	ASSERT_EQ(element.getBlock().getIndexSlots(), expected.getBlock().getIndexSlots());
+}
+
+TEST(TensorSymmetryRegistry, unknown_block) {
+	const TensorSymmetryRegistry registry(createSpecification(), test::getIndexSpaceManager());
+
+	// Blocks are only found if tensor name, creator count and slots all match
+	const TensorBlock::IndexSlots slots = { IndexSpace(1, Spin::Both), IndexSpace(1, Spin::Both),
+											IndexSpace(0, Spin::Both), IndexSpace(0, Spin::Both) };
+	ASSERT_NE(registry.find("X", 2, slots), nullptr);
+	ASSERT_EQ(registry.find("X", 1, slots), nullptr);
+	ASSERT_EQ(registry.find("Y", 2, slots), nullptr);
+
+	const std::vector< Index > indices = test::createIndexSequence("[b+,a+,i-,j-](||||)");
+
+	auto [element, sign] = registry.createElement(Tensor("Y"), indices);
+
+	ASSERT_EQ(element, std::get< 0 >(TensorElement::create(Tensor("Y"), indices, TensorBlock::SlotSymmetry{})));
+	ASSERT_EQ(sign, 1);
+	ASSERT_EQ(element.getBlock().getSlotSymmetry(), TensorBlock::SlotSymmetry{});
+}
+
+TEST(TensorSymmetryRegistry, unknown_space) {
+	parser::TensorSymmetrySpecification specification = createSpecification();
+	specification.symmetries[0].creatorSpaces[0] = "unknown";
+
+	ASSERT_THROW(TensorSymmetryRegistry(specification, test::getIndexSpaceManager()), ImportException);
+}
+
+TEST(TensorSymmetryRegistry, from_file) {
+	const TensorSymmetryRegistry registry =
+		TensorSymmetryRegistry::fromFile(std::filesystem::path(TEST_FILE_DIR) / "parser_input" / "TensorSymmetry"
+											 / "valid" / "ccsd.symmetry",
+										 test::getIndexSpaceManager());
+
+	const std::vector< Index > indices = test::createIndexSequence("[b+,a+,i-,j-](||||)");
+
+	auto [element, sign] = registry.createElement(Tensor("T"), indices);
+
+	ASSERT_EQ(element, test::createTensorElement("T[a+,b+,i-,j-](||||)"));
+	ASSERT_EQ(sign, -1);
+
+	ASSERT_THROW(TensorSymmetryRegistry::fromFile(std::filesystem::path(TEST_FILE_DIR) / "parser_input"
+														 / "TensorSymmetry" / "invalid" / "invalid1.symmetry",
+													 test::getIndexSpaceManager()),
+				 ImportException);
+}
@@ -0,0 +1,83 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#include "PrettyPrint.hpp"
+#include "Utils.hpp"
+
+#include "lizard/process/TermCollection.hpp"
+#include "lizard/symbolic/TensorExpressions.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <spdlog/logger.h>
+#include <spdlog/sinks/null_sink.h>
+
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+
+using namespace lizard;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////// TEST FIXTURES //////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////
+
+struct TermCollectionTest : ::testing::TestWithParam< std::tuple< std::string, std::string > > {
+	using Params = std::tuple< std::string, std::string >;
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////// TEST CASES ////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST_P(TermCollectionTest, process) {
+	const std::string &inputTreeSpec    = std::get< 0 >(GetParam());
+	const std::string &expectedTreeSpec = std::get< 1 >(GetParam());
+
+	std::vector< NamedTensorExprTree > actual         = { test::createTree< NamedTensorExprTree >(inputTreeSpec) };
+	const std::vector< NamedTensorExprTree > expected = { test::createTree< NamedTensorExprTree >(expectedTreeSpec) };
+
+	TermCollection collector;
+	collector.setLogger(
+		std::make_shared< spdlog::logger >("term_collection_test", std::make_shared< spdlog::sinks::null_sink_mt >()));
+	collector.process(actual, test::getIndexSpaceManager());
+
+	ASSERT_EQ(actual.size(), 1);
+	ASSERT_EQ(actual[0], expected[0]);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+///////////////////////////// TEST SUITE INSTANTIATIONS ////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////
+
+INSTANTIATE_TEST_SUITE_P(
+	TermCollection, TermCollectionTest,
+	::testing::Values(
+		TermCollectionTest::Params{ "R[a+,i-] = H[a+,j-] * T[j+,i-] + F[a+,i-]",
+									"R[a+,i-] = H[a+,j-] * T[j+,i-] + F[a+,i-]" },
+		TermCollectionTest::Params{ "R[a+,i-] = 2 * H[a+,j-] * T[j+,i-] + T[j+,i-] * H[a+,j-] + F[a+,i-]",
+									"R[a+,i-] = 3 * H[a+,j-] * T[j+,i-] + F[a+,i-]" },
+		TermCollectionTest::Params{ "R[a+,i-] = F[a+,i-] + H[a+,j-] * T[j+,i-] + -1 * T[j+,i-] * H[a+,j-]",
+									"R[a+,i-] = F[a+,i-]" },
+		TermCollectionTest::Params{ "R[a+,i-] = F[a+,i-] + -1 * F[a+,i-]", "R[a+,i-] = 0" },
+		TermCollectionTest::Params{ "R[a+,i-] = H[a+,j-] * T[j+,i-] + H[a+,k-] * T[k+,i-]",
+									"R[a+,i-] = 2 * H[a+,j-] * T[j+,i-]" },
+		TermCollectionTest::Params{ "R[] = H[i+,j+,a-,b-] * T[a+,b+,i-,j-] + -1 * H[k+,l+,c-,d-] * T[c+,d+,k-,l-]",
+									"R[] = 0" },
+		// Equivalent up to the antisymmetry of H
+		TermCollectionTest::Params{
+			"R[] = H[i+,j+,a-,b-] * T[a+,c+,i-,j-] * X[b+,c-] + H[i+,j+,a-,b-] * T[b+,c+,i-,j-] * X[a+,c-]",
+			"R[] = 0" },
+		TermCollectionTest::Params{ "R[a+,i-] = F[a+,i-] + H[a+,j-] * T[j+,i-] + F[a+,i-] + 4 * F[a+,i-]",
+									"R[a+,i-] = 6 * F[a+,i-] + H[a+,j-] * T[j+,i-]" },
+		TermCollectionTest::Params{
+			"R[a+,i-] = H[a+,j-] * (T[j+,i-] + F[j+,i-]) + 2 * H[a+,j-] * (T[j+,i-] + F[j+,i-])",
+			"R[a+,i-] = 3 * H[a+,j-] * (T[j+,i-] + F[j+,i-])" }));
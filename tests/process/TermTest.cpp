@@ -0,0 +1,123 @@
+// This file is part of the lizard quantum chemistry software.
+// Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file at the root of the lizard source
+// tree or at <https://github.com/KoehnLab/lizard/blob/main/LICENSE>.
+
+#include "PrettyPrint.hpp"
+#include "Term.hpp"
+#include "Utils.hpp"
+
+#include "lizard/symbolic/TensorExpressions.hpp"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <tuple>
+#include <vector>
+
+
+using namespace lizard;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////// TEST FIXTURES //////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////
+
+struct TermCanonicalizationTest : ::testing::TestWithParam< std::tuple< std::string, std::string, bool > > {
+	using Params = std::tuple< std::string, std::string, bool >;
+
+	static auto createCanonicalTerm(const std::string &spec) -> Term {
+		const TensorExprTree tree = test::createTree< TensorExprTree >(spec);
+
+		std::vector< Term > terms = splitIntoTerms(tree.getRoot());
+		EXPECT_EQ(terms.size(), 1);
+
+		canonicalize(terms[0]);
+
+		return terms[0];
+	}
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////// TEST CASES ////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(Term, splitIntoTerms) {
+	const TensorExprTree tree =
+		test::createTree< TensorExprTree >("2 * H[a+,j-] * T[j+,i-] + F[a+,i-] + 3 * H[a+,j-] * (T[j+,i-] + F[j+,i-])");
+
+	std::vector< Term > terms = splitIntoTerms(tree.getRoot());
+
+	ASSERT_EQ(terms.size(), 3);
+
+	ASSERT_EQ(terms[0].prefactor, 2);
+	ASSERT_EQ(terms[0].factors.size(), 2);
+	ASSERT_TRUE(terms[0].compoundFactors.empty());
+
+	ASSERT_EQ(terms[1].prefactor, 1);
+	ASSERT_EQ(terms[1].factors.size(), 1);
+	ASSERT_TRUE(terms[1].compoundFactors.empty());
+
+	ASSERT_EQ(terms[2].prefactor, 3);
+	ASSERT_EQ(terms[2].factors.size(), 1);
+	ASSERT_EQ(terms[2].compoundFactors.size(), 1);
+
+	ASSERT_EQ(buildSum(terms), tree);
+}
+
+TEST_P(TermCanonicalizationTest, canonicalize) {
+	const std::string &firstSpec  = std::get< 0 >(GetParam());
+	const std::string &secondSpec = std::get< 1 >(GetParam());
+	const bool equivalent         = std::get< 2 >(GetParam());
+
+	const Term first  = createCanonicalTerm(firstSpec);
+	const Term second = createCanonicalTerm(secondSpec);
+
+	ASSERT_EQ(haveSameFactors(first, second), equivalent);
+
+	if (equivalent) {
+		ASSERT_EQ(hashFactors(first), hashFactors(second));
+		ASSERT_EQ(first.prefactor, second.prefactor);
+	}
+}
+
+TEST(Term, canonicalize_slot_symmetry) {
+	// The two terms only differ by exchanging the antisymmetric indices a and b of H, which changes the order in which
+	// the dummy indices are encountered
+	const Term first  = TermCanonicalizationTest::createCanonicalTerm("H[i+,j+,a-,b-] * T[a+,c+,i-,j-] * X[b+,c-]");
+	const Term second = TermCanonicalizationTest::createCanonicalTerm("H[i+,j+,a-,b-] * T[b+,c+,i-,j-] * X[a+,c-]");
+
+	ASSERT_TRUE(haveSameFactors(first, second));
+	ASSERT_EQ(hashFactors(first), hashFactors(second));
+	ASSERT_EQ(first.prefactor, -second.prefactor);
+
+	// Same for the symmetric exchange of two pairs of antisymmetric indices
+	const Term third  = TermCanonicalizationTest::createCanonicalTerm("H[i+,j+,a-,b-] * T[a+,c+,k-,j-] * X[b+,c-] * "
+																	  "Y[k+,i-]");
+	const Term fourth = TermCanonicalizationTest::createCanonicalTerm("H[j+,i+,a-,b-] * T[b+,c+,k-,j-] * X[a+,c-] * "
+																	  "Y[k+,i-]");
+
+	ASSERT_TRUE(haveSameFactors(third, fourth));
+	ASSERT_EQ(third.prefactor, fourth.prefactor);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+///////////////////////////// TEST SUITE INSTANTIATIONS ////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////
+
+INSTANTIATE_TEST_SUITE_P(
+	Term, TermCanonicalizationTest,
+	::testing::Values(
+		TermCanonicalizationTest::Params{ "H[a+,j-] * T[j+,i-]", "T[j+,i-] * H[a+,j-]", true },
+		TermCanonicalizationTest::Params{ "H[a+,j-] * T[j+,i-]", "H[a+,k-] * T[k+,i-]", true },
+		TermCanonicalizationTest::Params{ "H[a+,j-] * T[j+,i-]", "H[a+,j-] * T[j+,k-]", false },
+		TermCanonicalizationTest::Params{ "H[i+,j+,a-,b-] * T[a+,b+,i-,j-]", "H[k+,l+,c-,d-] * T[c+,d+,k-,l-]", true },
+		TermCanonicalizationTest::Params{ "H[i+,j+,a-,b-] * T[a+,b+,i-,j-]", "H[i+,j+,b-,a-] * T[b+,a+,i-,j-]", true },
+		TermCanonicalizationTest::Params{ "T[a+,i-] * T[b+,j-] * H[i+,c+,k-,b-] * H[j+,k+,a-,c-]",
+										  "T[b+,j-] * T[a+,i-] * H[j+,c+,k-,a-] * H[i+,k+,b-,c-]", true },
+		TermCanonicalizationTest::Params{ "T[a+,i-] * T[b+,j-] * H[i+,c+,k-,b-] * H[j+,k+,a-,c-]",
+										  "T[c+,k-] * T[d+,l-] * H[k+,e+,m-,d-] * H[l+,m+,c-,e-]", true },
+		TermCanonicalizationTest::Params{ "T[a+,i-] * T[b+,j-] * H[i+,c+,k-,b-] * H[j+,k+,a-,c-]",
+										  "T[a+,i-] * T[b+,j-] * H[i+,a+,k-,b-] * H[j+,k+,c-,c-]", false }));
@@ -83,6 +83,14 @@ namespace lizard::test {
 		throw std::runtime_error(fmt::format("Invalid index count ({}) for standard tensor", indexCount));
 	}
 
+	if (tensorName == "B" && indexCount == 3) {
+		// Density-fitting factors (pq|P) = (qp|P)
+		perm::PrimitivePermutationGroup symmetry;
+		symmetry.addGenerator(perm::ExplicitPermutation(perm::Cycle({ 1, 2 })));
+
+		return symmetry;
+	}
+
 	// All other tensors will be treated as not having index symmetry
 	return {};
 }
@@ -74,6 +74,12 @@ TEST_P(TensorElementTest, construction_and_equality) {
 	ASSERT_THAT(element2.getIndices(), ::testing::ElementsAreArray(canonicalIndices));
 
 	ASSERT_EQ(element1, element2);
+
+	// Elements created from already canonical indices share the block's slots and symmetry
+	const TensorElement element3 = TensorElement::fromCanonical(element2.getBlock(), canonicalIndices);
+	ASSERT_EQ(element3, element1);
+	ASSERT_THAT(element3.getIndices(), ::testing::ElementsAreArray(canonicalIndices));
+	ASSERT_EQ(&element3.getBlock().getIndexSlots(), &element2.getBlock().getIndexSlots());
 }
 
 TEST(TensorElement, hash) {